@@ -1,11 +1,57 @@
 #include "Global.h"
 #include "Node.h"
 #include "Element.h"
+#include "TextWriter.h"
 
 
 #include <boost/algorithm/string.hpp>
 
 
+// ---------------------------------------------------------------------
+//   writeAbaqusSet
+// ---------------------------------------------------------------------
+
+// *ELSET or *NSET named name with the members ids+offset: a GENERATE
+// definition (first, last, 1) if the ids are one run of consecutive
+// ids, otherwise a plain one with 16 entries per data line.
+
+static void              writeAbaqusSet
+
+    ( TextWriter&       file,
+      const char*       keyword,
+      int               name,
+      const IntVector&  ids,
+      int               offset = 0 )
+{
+  const int count = ids.size ();
+
+  bool      isRun = count > 1;
+
+  for ( int i = 1; i < count && isRun; i++ )
+  {
+    isRun = ids[i] == ids[i-1] + 1;
+  }
+
+  file << "*" << keyword << ", " << keyword << "=" << name;
+
+  if ( isRun )
+  {
+    file << ", GENERATE\n";
+    file << ids[0] + offset << ", " << ids[count-1] + offset << ", 1\n";
+
+    return;
+  }
+
+  file << "\n";
+
+  // Abaqus data lines contain maximum 16 entries
+
+  for ( int i = 0; i < count; i++ )
+  {
+    file << ids[i] + offset << ( ( i % 16 == 15 || i == count-1 ) ? "\n" : "," );
+  }
+}
+
 // =====================================================================
 //     writeAbaqusMesh
 // =====================================================================
@@ -35,10 +81,16 @@ void                     writeAbaqusMesh
   elemFile  = filenames[0] + "-bulk-elems.inp"; 
   inteFile  = filenames[0] + "-int-elems.inp"; 
 
-  ofstream file1 ( nodeFile.c_str(), std::ios::out );
-  ofstream file2 ( elemFile.c_str(), std::ios::out );
-  ofstream file3 ( inteFile.c_str(), std::ios::out );
-  ofstream file  ( fileName,         std::ios::out );
+  TextWriter file1, file2, file3, file;
+
+  if ( !file1.open ( nodeFile.c_str() ) ||
+       !file2.open ( elemFile.c_str() ) ||
+       !file3.open ( inteFile.c_str() ) ||
+       !file .open ( fileName         ) )
+  {
+    cout << "Unable to open output mesh file!!!\n\n";
+    exit(1);
+  }
 
   cout << "Writing nodes...\n";
 
@@ -46,45 +98,46 @@ void                     writeAbaqusMesh
   const int elemCount    = globdat.elemSet.size      ();
   const int bndElemCount = globdat.bndElementSet.size();
 
-  NodePointer np;
+  const NodeSet& nodes = globdat.newNodeSet;
 
-  for ( int in = 0; in < nodeCount; in ++ )
+  // formatted on --threads threads (see TextWriter::writeParallel)
+
+  const int      threadCount = globdat.threadCount;
+
+  file1.writeParallel ( nodeCount, threadCount, [&] ( TextWriter& out, int in )
   {
-    np = globdat.newNodeSet[in];
- 
     if ( !globdat.is3D )
     {
-      file1 << np->getIndex() 
-            << ", " << np->getX() << ", " << np->getY() << "\n";
+      out << nodes.getIndex ( in ) 
+          << ", " << nodes.getX ( in ) << ", " << nodes.getY ( in ) << "\n";
     }
     else
     {
-      file1 << np->getIndex() << ", " 
-	        << np->getX() << ", " 
-	        << np->getY() << ", "
-	        << np->getZ() << "\n";
+      out << nodes.getIndex ( in ) << ", " 
+	      << nodes.getX ( in ) << ", " 
+	      << nodes.getY ( in ) << ", "
+	      << nodes.getZ ( in ) << "\n";
     }
-  }
+  } );
 
   cout << "Writing nodes...done!\n\n";
 
   cout << "Writing bulk elements...\n";
 
-  ElemPointer ep;
-  IntVector   connect, newConnect;
-
-  for ( int ie = 0; ie < elemCount; ie ++ )
+  file2.writeParallel ( elemCount, threadCount, [&] ( TextWriter& out, int ie )
   {
-    ep = globdat.elemSet[ie];
+    static thread_local IntVector connect;
 
-    //file2 << ep->getIndex () << ", ";
-    file2 << ie + 1 << ", ";
+    ElemPointer ep = globdat.elemSet[ie];
+
+    //out << ep->getIndex () << ", ";
+    out << ie + 1 << ", ";
 
     ep->getJemConnectivity ( connect ); 
 
-    copy ( connect.begin(), connect.end()-1, ostream_iterator<int> (file2, ", " ) );
-    file2 << connect[connect.size()-1] << "\n";
-  }
+    out.writeList ( connect.begin(), connect.end()-1, ", " );
+    out << connect[connect.size()-1] << "\n";
+  } );
 
   cout << "Writing bulk elements...done!\n\n";
 
@@ -93,28 +146,24 @@ void                     writeAbaqusMesh
   const int   ieCount = globdat.interfaceSet.size ();
   const int   inCount = globdat.nodeSet.     size ();
 
-  IntVector   connec;
   IntVector   dupNodes;
 
   int         index;
   int         inter;
 
-  for ( int ie = 0; ie < ieCount; ie++ )
+  file3.writeParallel ( ieCount, threadCount, [&] ( TextWriter& out, int ie )
   {
-    ep = globdat.interfaceSet[ie];
+    ElemPointer ep     = globdat.interfaceSet[ie];
 
-    //file3 << ep->getIndex() << ", "; 
-    file3 << elemCount + 1 + ie << ", "; 
+    //out << ep->getIndex() << ", "; 
+    out << elemCount + 1 + ie << ", "; 
 
-    ep->getConnectivity ( connec );
+    IntSpan     connec = ep->getConnectivity ();
 
-    copy ( connec.begin(), 
-	   connec.end()-1, 
-	   ostream_iterator<int> ( file3, ", " ) 
-	 );
+    out.writeList ( connec.begin(), connec.end()-1, ", " );
 
-    file3 << connec[connec.size()-1] << "\n";
-  }
+    out << connec[connec.size()-1] << "\n";
+  } );
 
   cout << "Writing interface elements...done!\n\n";
   
@@ -143,18 +192,8 @@ void                     writeAbaqusMesh
   {
     int       domName   = it->first; 
     IntVector elems     = it->second; 
-    const int elemCount = elems.size();
 
-    file << "*ELSET, " << "ELSET=" << domName << "\n";
-    
-    for ( int ie = 0; ie < elemCount-1; ie++ )
-    {
-      file << elems[ie] - startElem << ",";
-      // Abaqus ELSET data line contains maximum 16 entries
-      if ( ie % 16 == 0 ) file <<  "\n";
-    }
-
-    file << elems[elemCount-1] - startElem << "\n";
+    writeAbaqusSet ( file, "ELSET", domName, elems, -startElem );
   }
 
   cout << "Writing bulk element groups...done!\n\n";
@@ -179,14 +218,7 @@ void                     writeAbaqusMesh
       IntVector   nodes;
       copy ( elems.begin(), elems.end(), back_inserter(nodes) );
    
-      file << "*NSET, " << "NSET=" << domName << "\n";
-
-      for ( int ie = 0; ie < nodes.size()-1; ie++ )
-      {
-	file << nodes[ie] << ",";
-      }
-
-      file << nodes[nodes.size()-1] << "\n";
+      writeAbaqusSet ( file, "NSET", domName, nodes );
     }
  // }
 
@@ -74,9 +74,7 @@ void                     readAbaqusMesh
       globdat.is3D = true;
     }
     
-    globdat.nodeSet.push_back ( NodePointer( new Node(x,y,z,id) ) );
-
-    globdat.nodeId2Position[id] = globdat.nodeSet.size()-1;
+    globdat.nodeId2Position[id] = globdat.nodeSet.addNode ( x, y, z, id );
 
   }
 
@@ -128,7 +126,7 @@ void                     readAbaqusMesh
         		back_inserter(connectivity), 
 		        Str2IntFunctor() );
 
-    globdat.elemSet.push_back ( ElemPointer ( new Element ( ie, elemType, connectivity ) )  );
+    globdat.elemSet.addElement ( ie, elemType, connectivity );
 
     globdat.elemId2Position[ie] = globdat.elemSet.size() - 1;
 
@@ -186,12 +184,12 @@ void                     readAbaqusMesh
 
   const int   elemCount = globdat.elemSet.size ();
         int   inodeCount;
-  IntVector   inodes;
+  IntSpan     inodes;
   ElemPointer ep;
   for ( int ie = 0; ie < elemCount; ie++ )
   {
     ep = globdat.elemSet[ie];
-    ep->getConnectivity ( inodes );
+    inodes = ep->getConnectivity ();
     inodeCount = inodes.size ();
     print (inodes.begin(), inodes.end());  
   }
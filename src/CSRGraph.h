@@ -0,0 +1,226 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * CSRGraph stores lists of integers (for instance the elements around
+ * every node) in compressed sparse row format: one array with all the
+ * entries and one array with the offset of every row. It is built in
+ * two passes over the same data, a counting pass and a filling pass,
+ * so that every row keeps the order in which its entries were given.
+ * Rows are read through IntSpan, a view that does not copy anything.
+ * build() does both passes on several threads and gives the same rows.
+ */
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <atomic>
+
+#include "typedefs.h"
+#include "IntSpan.h"
+#include "Parallel.h"
+
+// =====================================================================
+//     class CSRGraph
+// =====================================================================
+
+class CSRGraph
+{
+  public:
+
+    // entries of a row, empty if the row does not exist
+
+    inline IntSpan        operator[]   ( int row ) const;
+
+    int                   rowCount     () const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    size_t                entryCount   () const { return values_.size (); }
+
+    // index of the first entry of row among all entries, to keep
+    // arrays with one item per entry
+
+    size_t                rowOffset    ( int row ) const { return offsets_[row]; }
+
+    void                  clear        ();
+
+    // first pass: give the row of every entry
+
+    void                  beginCount   ( int rowCount = 0 );
+    inline void           addCount     ( int row, int count = 1 );
+
+    // second pass: give the entries, in the same order
+
+    void                  beginFill    ();
+    inline void           addEntry     ( int row, int value );
+    void                  endFill      ();
+
+    // both passes on threadCount threads: item i (0 <= i < itemCount)
+    // is an entry of the rows rowsOf(i) (an IntSpan) with the value
+    // valueOf(i). Rows keep the item order, as with the passes above.
+
+    template <class RowsOf, class ValueOf>
+    void                  build        ( int            itemCount,
+                                         int            threadCount,
+                                         const RowsOf&  rowsOf,
+                                         const ValueOf& valueOf );
+
+  private:
+
+    vector<size_t>        offsets_;   // row i: [offsets_[i], offsets_[i+1])
+    IntVector             values_;
+    vector<size_t>        cursor_;    // next free slot during the fill
+};
+
+// ==========================================================
+//   implementation of inline functions
+// ==========================================================
+
+inline IntSpan CSRGraph::operator[] ( int row ) const
+{
+  if ( row < 0 || row + 1 >= (int) offsets_.size () ) return IntSpan ();
+
+  const int* data = values_.data ();
+
+  return IntSpan ( data + offsets_[row], data + offsets_[row+1] );
+}
+
+inline void CSRGraph::addCount ( int row, int count )
+{
+  // during the count, offsets_[row+1] holds the size of row
+
+  if ( row + 2 > (int) offsets_.size () ) offsets_.resize ( row + 2, 0 );
+
+  offsets_[row+1] += count;
+}
+
+inline void CSRGraph::addEntry ( int row, int value )
+{
+  values_[cursor_[row]++] = value;
+}
+
+// ------------------------------------------------------------
+//    clear, beginCount, beginFill, endFill
+// ------------------------------------------------------------
+
+inline void CSRGraph::clear ()
+{
+  offsets_.clear ();
+  values_ .clear ();
+  cursor_ .clear ();
+}
+
+inline void CSRGraph::beginCount ( int rowCount )
+{
+  clear ();
+
+  offsets_.assign ( rowCount + 1, 0 );
+}
+
+inline void CSRGraph::beginFill ()
+{
+  if ( offsets_.empty () ) offsets_.push_back ( 0 );
+
+  for ( size_t i = 1; i < offsets_.size (); i++ )
+  {
+    offsets_[i] += offsets_[i-1];
+  }
+
+  values_.resize ( offsets_.back () );
+  cursor_.assign ( offsets_.begin (), offsets_.end () - 1 );
+}
+
+inline void CSRGraph::endFill ()
+{
+  vector<size_t> ().swap ( cursor_ );
+}
+
+// ------------------------------------------------------------
+//    build
+// ------------------------------------------------------------
+
+// The rows are counted and filled with atomic counters, so the items
+// of a row come in any order; sorting every row restores the item
+// order before the items are replaced by their values.
+
+template <class RowsOf, class ValueOf>
+void CSRGraph::build
+
+  ( int             itemCount,
+    int             threadCount,
+    const RowsOf&   rowsOf,
+    const ValueOf&  valueOf )
+
+{
+  IntVector  maxRows ( threadCount, -1 );
+  int        rowCount = 0;
+
+  clear ();
+
+  // number of rows: largest row + 1
+
+  parallelFor ( threadCount, threadCount, [&] ( int it )
+  {
+    const int first = (int) ( (long long) itemCount *  it      / threadCount );
+    const int last  = (int) ( (long long) itemCount * (it + 1) / threadCount );
+
+    for ( int i = first; i < last; i++ )
+    {
+      IntSpan rows = rowsOf ( i );
+
+      for ( int j = 0; j < rows.size (); j++ )
+      {
+        if ( rows[j] > maxRows[it] ) maxRows[it] = rows[j];
+      }
+    }
+  } );
+
+  for ( int it = 0; it < threadCount; it++ )
+  {
+    if ( maxRows[it] + 1 > rowCount ) rowCount = maxRows[it] + 1;
+  }
+
+  vector< std::atomic<int> >  counts ( rowCount );
+
+  parallelFor ( itemCount, threadCount, [&] ( int i )
+  {
+    IntSpan rows = rowsOf ( i );
+
+    for ( int j = 0; j < rows.size (); j++ )
+    {
+      counts[rows[j]].fetch_add ( 1, std::memory_order_relaxed );
+    }
+  } );
+
+  // prefix sum; counts become the next free slot of every row
+
+  offsets_.resize ( rowCount + 1 );
+  offsets_[0] = 0;
+
+  for ( int r = 0; r < rowCount; r++ )
+  {
+    offsets_[r+1] = offsets_[r] + counts[r].load ( std::memory_order_relaxed );
+    counts[r].store ( (int) offsets_[r], std::memory_order_relaxed );
+  }
+
+  values_.resize ( offsets_.back () );
+
+  parallelFor ( itemCount, threadCount, [&] ( int i )
+  {
+    IntSpan rows = rowsOf ( i );
+
+    for ( int j = 0; j < rows.size (); j++ )
+    {
+      values_[counts[rows[j]].fetch_add ( 1, std::memory_order_relaxed )] = i;
+    }
+  } );
+
+  parallelFor ( rowCount, threadCount, [&] ( int r )
+  {
+    int* first = values_.data () + offsets_[r];
+    int* last  = values_.data () + offsets_[r+1];
+
+    std::sort ( first, last );
+
+    for ( int* v = first; v != last; v++ ) *v = valueOf ( *v );
+  } );
+}
+
+#endif
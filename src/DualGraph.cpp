@@ -0,0 +1,127 @@
+#include "DualGraph.h"
+#include "FaceTable.h"
+#include "EdgeTable.h"
+#include "Parallel.h"
+
+// ------------------------------------------------------------
+//    helpers giving the faces and edges the same interface
+// ------------------------------------------------------------
+
+static inline int  localCount_ ( const FaceTable& t, int ie )           { return t.getFaceCount ( ie );     }
+static inline int  localCount_ ( const EdgeTable& t, int ie )           { return t.getEdgeCount ( ie );     }
+static inline int  entityId_   ( const FaceTable& t, int ie, int k )    { return t.getFaceId ( ie, k );     }
+static inline int  entityId_   ( const EdgeTable& t, int ie, int k )    { return t.getEdgeId ( ie, k );     }
+static inline int  localIndex_ ( const FaceTable& t, int i, int side )  { return t.getLocalFace ( i, side ); }
+static inline int  localIndex_ ( const EdgeTable& t, int i, int side )  { return t.getLocalEdge ( i, side ); }
+
+// ------------------------------------------------------------
+//    build
+// ------------------------------------------------------------
+
+void DualGraph::build ( const FaceTable& faces, int elemCount, int threadCount )
+{
+  build_ ( faces, elemCount, threadCount );
+}
+
+void DualGraph::build ( const EdgeTable& edges, int elemCount, int threadCount )
+{
+  build_ ( edges, elemCount, threadCount );
+}
+
+// Every element is handled on its own, in two passes: count its
+// neighbors, then store them in the order of its local faces. Only
+// the first two elements of a face (non-manifold mesh) are neighbors.
+
+template <class Table>
+void DualGraph::build_ ( const Table& table, int elemCount, int threadCount )
+{
+  clear ();
+
+  offsets_.assign ( elemCount + 1, 0 );
+
+  // other side of the local face k of element ie, -1 if none
+
+  auto  other = [&table] ( int ie, int k, int& kj ) -> int
+  {
+    const int id = entityId_ ( table, ie, k );
+
+    for ( int side = 0; side < 2; side++ )
+    {
+      if ( table.getElement ( id, side ) == ie && localIndex_ ( table, id, side ) == k )
+      {
+        const int je = table.getElement ( id, 1 - side );
+
+        kj = localIndex_ ( table, id, 1 - side );
+
+        return je == ie ? -1 : je;
+      }
+    }
+
+    return -1;
+  };
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    const int  count = localCount_ ( table, ie );
+    int        kj;
+
+    for ( int k = 0; k < count; k++ )
+    {
+      if ( other ( ie, k, kj ) >= 0 ) offsets_[ie+1]++;
+    }
+  } );
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    offsets_[ie+1] += offsets_[ie];
+  }
+
+  neighbors_    .resize ( offsets_[elemCount] );
+  localFaces_   .resize ( offsets_[elemCount] );
+  neighborFaces_.resize ( offsets_[elemCount] );
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    const int  count = localCount_ ( table, ie );
+    int        pos   = offsets_[ie];
+    int        je, kj;
+
+    for ( int k = 0; k < count; k++ )
+    {
+      je = other ( ie, k, kj );
+
+      if ( je < 0 ) continue;
+
+      neighbors_    [pos] = je;
+      localFaces_   [pos] = k;
+      neighborFaces_[pos] = kj;
+      pos++;
+    }
+  } );
+}
+
+// ------------------------------------------------------------
+//    clear
+// ------------------------------------------------------------
+
+void DualGraph::clear ()
+{
+  offsets_      .clear ();
+  neighbors_    .clear ();
+  localFaces_   .clear ();
+  neighborFaces_.clear ();
+}
+
+// ------------------------------------------------------------
+//    getNeighborAcross
+// ------------------------------------------------------------
+
+int DualGraph::getNeighborAcross ( int ie, int kf ) const
+{
+  for ( int pos = offsets_[ie]; pos < offsets_[ie+1]; pos++ )
+  {
+    if ( localFaces_[pos] == kf ) return neighbors_[pos];
+  }
+
+  return -1;
+}
@@ -0,0 +1,80 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * DualGraph stores, for every element, the elements sharing one of its
+ * faces (3D) or edges (2D), together with the local index of that face
+ * or edge on both sides. It is built from a FaceTable or an EdgeTable
+ * and kept in compressed sparse row format (see CSRGraph). Elements
+ * sharing only a node or (in 3D) an edge are not neighbors.
+ */
+
+#ifndef DUAL_GRAPH_H
+#define DUAL_GRAPH_H
+
+#include "typedefs.h"
+#include "IntSpan.h"
+
+class FaceTable;
+class EdgeTable;
+
+// =====================================================================
+//     class DualGraph
+// =====================================================================
+
+class DualGraph
+{
+  public:
+
+    void                 build         ( const FaceTable& faces, int elemCount, int threadCount = 1 );
+    void                 build         ( const EdgeTable& edges, int elemCount, int threadCount = 1 );
+
+    void                 clear         ();
+
+    int                  elemCount     () const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+    // positions (in elemSet) of the neighbors of the element at position ie
+
+    inline IntSpan       getNeighbors  ( int ie ) const;
+
+    int                  getNeighborCount ( int ie ) const
+    {
+      return offsets_[ie+1] - offsets_[ie];
+    }
+
+    // neighbor k of element ie, the local face (edge) of ie it shares
+    // and the local index of that face (edge) in the neighbor
+
+    int                  getNeighbor   ( int ie, int k ) const { return neighbors_    [offsets_[ie] + k]; }
+    int                  getLocalFace  ( int ie, int k ) const { return localFaces_   [offsets_[ie] + k]; }
+    int                  getNeighborFace ( int ie, int k ) const { return neighborFaces_[offsets_[ie] + k]; }
+
+    // position of the element on the other side of the local face
+    // (edge) kf of element ie, -1 on the boundary
+
+    int                  getNeighborAcross ( int ie, int kf ) const;
+
+  private:
+
+    template <class Table>
+    void                 build_        ( const Table& table, int elemCount, int threadCount );
+
+  private:
+
+    IntVector            offsets_;      // row i: [offsets_[i], offsets_[i+1])
+    IntVector            neighbors_;
+    IntVector            localFaces_;
+    IntVector            neighborFaces_;
+};
+
+// ==========================================================
+//   implementation of inline functions
+// ==========================================================
+
+inline IntSpan DualGraph::getNeighbors ( int ie ) const
+{
+  const int* data = neighbors_.data ();
+
+  return IntSpan ( data + offsets_[ie], data + offsets_[ie+1] );
+}
+
+#endif
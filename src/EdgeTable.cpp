@@ -0,0 +1,184 @@
+#include "EdgeTable.h"
+#include "Element.h"
+#include "SharedFaces.h"
+
+// ------------------------------------------------------------
+//    build
+// ------------------------------------------------------------
+
+void EdgeTable::build
+
+  ( const ElemSet&          elems,
+    const CSRGraph&         support,
+    const IdMap&            elemPositions,
+    const vector<NodePair>& bndPairs,
+    const IntVector&        bndDomains,
+    int                     threadCount )
+
+{
+  const int  elemCount = elems.size ();
+
+  IntVector  keys;
+  int        edgeCount, id, n1, n2, je;
+
+  clear ();
+
+  edgeOffset_.resize ( elemCount + 1 );
+  edgeOffset_[0] = 0;
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    edgeOffset_[ie+1] = edgeOffset_[ie] + elems[ie]->getCornerConnectivity0 ().size ();
+  }
+
+  // sorted nodes of every edge
+
+  keys.resize ( 2 * edgeOffset_[elemCount] );
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    IntSpan    inodes = elems[ie]->getCornerConnectivity0 ();
+    const int  count  = inodes.size ();
+
+    for ( int ke = 0; ke < count; ke++ )
+    {
+      int* key = &keys[2 * ( edgeOffset_[ie] + ke )];
+
+      key[0] = std::min ( inodes[ke], inodes[(ke + 1) % count] );
+      key[1] = std::max ( inodes[ke], inodes[(ke + 1) % count] );
+    }
+  } );
+
+  edgeCount = numberSharedFaces<2> ( edgeIds_, ownerCount_, elems_, localEdges_,
+                                     edgeOffset_, keys, support, elemPositions,
+                                     threadCount );
+
+  nodes_    .resize ( 2 * edgeCount );
+  bndDomain_.assign ( edgeCount, -1 );
+  flags_    .assign ( edgeCount, 0 );
+
+  for ( int e = 0; e < edgeCount; e++ )
+  {
+    const int s = edgeOffset_[elems_[2*e]] + localEdges_[2*e];
+
+    nodes_[2*e]   = keys[2*s];
+    nodes_[2*e+1] = keys[2*s+1];
+  }
+
+  // the first line element on an edge gives its domain; line elements
+  // that are not an element edge get a new edge
+
+  for ( size_t ip = 0; ip < bndPairs.size (); ip++ )
+  {
+    n1 = std::min ( bndPairs[ip].node1, bndPairs[ip].node2 );
+    n2 = std::max ( bndPairs[ip].node1, bndPairs[ip].node2 );
+    id = -1;
+
+    IntSpan around = support[n1];
+
+    for ( int j = 0; j < around.size () && id < 0; j++ )
+    {
+      je = elemPositions.get ( around[j] );
+
+      for ( int s = edgeOffset_[je]; s < edgeOffset_[je+1]; s++ )
+      {
+        if ( keys[2*s] == n1 && keys[2*s+1] == n2 )
+        {
+          id = edgeIds_[s];
+          break;
+        }
+      }
+    }
+
+    if ( id < 0 ) id = addEdge ( n1, n2 );
+
+    if ( !( flags_[id] & BOUNDARY ) )
+    {
+      flags_    [id] |= BOUNDARY;
+      bndDomain_[id]  = bndDomains[ip];
+    }
+  }
+}
+
+// ------------------------------------------------------------
+//    findEdge, addEdge
+// ------------------------------------------------------------
+
+int EdgeTable::findEdge ( int n1, int n2 ) const
+{
+  mapEdges_ ();
+
+  std::unordered_map<long long,int>::const_iterator it = edgeMap_.find ( key_ ( n1, n2 ) );
+
+  return it == edgeMap_.end () ? -1 : it->second;
+}
+
+int EdgeTable::addEdge ( int n1, int n2 )
+{
+  mapEdges_ ();
+
+  std::pair<std::unordered_map<long long,int>::iterator,bool> res =
+
+    edgeMap_.insert ( std::make_pair ( key_ ( n1, n2 ), (int) ownerCount_.size () ) );
+
+  if ( res.second )
+  {
+    ownerCount_.push_back ( 0 );
+    nodes_     .push_back ( std::min ( n1, n2 ) );
+    nodes_     .push_back ( std::max ( n1, n2 ) );
+    elems_     .push_back ( -1 ); elems_     .push_back ( -1 );
+    localEdges_.push_back ( -1 ); localEdges_.push_back ( -1 );
+    bndDomain_ .push_back ( -1 );
+    flags_     .push_back ( 0 );
+
+    mappedCount_++;
+  }
+
+  return res.first->second;
+}
+
+// ------------------------------------------------------------
+//    clear, resetDone
+// ------------------------------------------------------------
+
+void EdgeTable::clear ()
+{
+  edgeMap_   .clear ();
+  edgeOffset_.clear ();
+  edgeIds_   .clear ();
+  nodes_     .clear ();
+  ownerCount_.clear ();
+  elems_     .clear ();
+  localEdges_.clear ();
+  bndDomain_ .clear ();
+  flags_     .clear ();
+
+  mappedCount_ = 0;
+}
+
+void EdgeTable::resetDone ()
+{
+  for ( size_t i = 0; i < flags_.size (); i++ )
+  {
+    flags_[i] &= ~DONE;
+  }
+}
+
+// ------------------------------------------------------------
+//    mapEdges_
+// ------------------------------------------------------------
+
+void EdgeTable::mapEdges_ () const
+{
+  const int  edgeCount = ownerCount_.size ();
+
+  if ( mappedCount_ == edgeCount ) return;
+
+  edgeMap_.reserve ( edgeCount );
+
+  for ( ; mappedCount_ < edgeCount; mappedCount_++ )
+  {
+    edgeMap_.insert ( std::make_pair ( key_ ( nodes_[2*mappedCount_], nodes_[2*mappedCount_+1] ),
+                                       mappedCount_ ) );
+  }
+}
@@ -0,0 +1,131 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * EdgeTable lists the edges of a 2D mesh (corner nodes of the original
+ * mesh) once. The edges shared by two elements get the same edge id;
+ * they are matched among the elements around their smallest node (see
+ * numberSharedFaces). For every edge it also keeps the boundary domain
+ * (the first matching line element of Global::nodePairs) and a done
+ * flag used by the 2D interface builders instead of their lists of
+ * edges already done. A hash table on the undirected node pair, built
+ * when first needed, finds the edges that are not given by an element
+ * and its local edge.
+ */
+
+#ifndef EDGE_TABLE_H
+#define EDGE_TABLE_H
+
+#include <unordered_map>
+
+#include "typedefs.h"
+#include "utilities.h"
+
+class CSRGraph;
+class IdMap;
+
+// =====================================================================
+//     class EdgeTable
+// =====================================================================
+
+class EdgeTable
+{
+  public:
+
+                         EdgeTable       () : mappedCount_(0) {}
+
+    // number the corner edges (closed loop of getCornerConnectivity0)
+    // of all elements of elems and mark those listed in bndPairs as
+    // boundary edges of domain bndDomains[i]; support gives the element
+    // ids around every node (nodal support) and elemPositions their
+    // positions in elems
+
+    void                 build           ( const ElemSet&          elems,
+                                           const CSRGraph&         support,
+                                           const IdMap&            elemPositions,
+                                           const vector<NodePair>& bndPairs,
+                                           const IntVector&        bndDomains,
+                                           int                     threadCount = 1 );
+
+    void                 clear           ();
+
+    int                  edgeCount       () const { return ownerCount_.size (); }
+
+    // number of local edges of the element at position ie
+
+    int                  getEdgeCount    ( int ie ) const
+    {
+      return edgeOffset_[ie+1] - edgeOffset_[ie];
+    }
+
+    // edge id of the local edge ke (nodes ke, ke+1) of the element at
+    // position ie
+
+    int                  getEdgeId       ( int ie, int ke ) const
+    {
+      return edgeIds_[edgeOffset_[ie] + ke];
+    }
+
+    // edge id of (n1,n2), -1 if it is not an edge of the table
+
+    int                  findEdge        ( int n1, int n2 ) const;
+
+    // edge id of (n1,n2), added without owner if it is not there yet
+
+    int                  addEdge         ( int n1, int n2 );
+
+    int                  getOwnerCount   ( int edge ) const { return ownerCount_[edge]; }
+
+    // position of the element on side 0 (the first one met) or 1, and
+    // the local index of the edge in that element, -1 if none
+
+    int                  getElement      ( int edge, int side ) const
+    {
+      return elems_[2*edge + side];
+    }
+
+    int                  getLocalEdge    ( int edge, int side ) const
+    {
+      return localEdges_[2*edge + side];
+    }
+
+    bool                 isOnBoundary    ( int edge ) const { return flags_[edge] & BOUNDARY; }
+
+    int                  getBoundaryDomain ( int edge ) const { return bndDomain_[edge]; }
+
+    bool                 isDone          ( int edge ) const { return flags_[edge] & DONE; }
+
+    void                 setDone         ( int edge ) { flags_[edge] |= DONE; }
+
+    void                 resetDone       ();
+
+  private:
+
+    static long long     key_            ( int n1, int n2 )
+    {
+      if ( n1 > n2 ) std::swap ( n1, n2 );
+
+      return ( (long long) n1 << 32 ) | (unsigned) n2;
+    }
+
+    // add the edges numbered since the last call to the hash table
+
+    void                 mapEdges_       () const;
+
+    static const char    BOUNDARY = 1;
+    static const char    DONE     = 2;
+
+    mutable std::unordered_map<long long,int>  edgeMap_;
+    mutable int          mappedCount_;
+
+    IntVector            edgeOffset_;   // element i: edgeIds_[edgeOffset_[i] + ke]
+    IntVector            edgeIds_;
+
+    IntVector            nodes_;        // two per edge, smallest first
+    IntVector            ownerCount_;
+    IntVector            elems_;        // two per edge, -1 if none
+    IntVector            localEdges_;   // two per edge, -1 if none
+    IntVector            bndDomain_;
+    vector<char>         flags_;
+};
+
+#endif
@@ -2,136 +2,184 @@
 #include <algorithm>
 
 #include "Element.h"
+#include "ElementTraits.h"
 #include "Node.h"
 #include "Global.h"
 
-/*
- * TODO: set isQuadratic_  
- * */
-
-
 typedef vector<double>::const_iterator   iter;
 typedef vector<int>   ::iterator         iIter;
 
 const std::vector<int> Element::gmshQuadraticElemTypes ({8,9,10,11,12,16});
 
 // ------------------------------------------------------------
-//    constructors
+//    ElemSet: reserve, clear
+// ------------------------------------------------------------
+
+void ElemSet::reserve
+
+  ( int  elemCount,
+    int  nodeCount )
+{
+  index_     .reserve ( elemCount );
+  elemType_  .reserve ( elemCount );
+  bulk1_     .reserve ( elemCount );
+  bulk2_     .reserve ( elemCount );
+  flags_     .reserve ( elemCount );
+  connOffset_.reserve ( elemCount + 1 );
+  faceOffset_.reserve ( elemCount );
+
+  connectivity_ .reserve ( nodeCount );
+  connectivity0_.reserve ( nodeCount );
+}
+
+void ElemSet::clear ()
+{
+  index_        .clear ();
+  elemType_     .clear ();
+  bulk1_        .clear ();
+  bulk2_        .clear ();
+  flags_        .clear ();
+  connOffset_   .clear ();
+  connectivity_ .clear ();
+  connectivity0_.clear ();
+  faceOffset_   .clear ();
+  faceData_     .clear ();
+}
+
+// ------------------------------------------------------------
+//    ElemSet: addElement
 // ------------------------------------------------------------
 
-Element::Element ( int index, int elemType,
-                   const IntVector& connec )
+int ElemSet::addElement
 
-  : index_(index), elemType_(elemType),
-    connectivity_(connec), connectivity0_(connec), 
-    done_(false), isQuadratic_(false),
-    isChanged_(false), isNURBS_(false)
+  ( int               index,
+    int               elemType,
+    const IntVector&  connec )
 {
-  nodePerFace_ = 3;
+  const bool quadratic =
 
-  if (       find ( Element::gmshQuadraticElemTypes.begin(), 
-                    Element::gmshQuadraticElemTypes.end (), elemType )
-             != Element::gmshQuadraticElemTypes.end () 
-     ) isQuadratic_ = true;
+    find ( Element::gmshQuadraticElemTypes.begin(),
+           Element::gmshQuadraticElemTypes.end (), elemType )
+    != Element::gmshQuadraticElemTypes.end ();
 
+  return add_ ( index, elemType, connec, quadratic ? QUADRATIC : 0, 0, 0 );
 }
 
-Element::Element ( int index, int elemType,
-                   const IntVector& connec, bool isNURBS )
+int ElemSet::addElement
 
-  : index_(index), elemType_(elemType),
-    connectivity_(connec), connectivity0_(connec), 
-    done_(false), isQuadratic_(false),
-    isChanged_(false), isNURBS_(isNURBS)
+  ( int               index,
+    int               elemType,
+    const IntVector&  connec,
+    bool              isNURBS )
 {
-  nodePerFace_ = 3;
+  return add_ ( index, elemType, connec, isNURBS ? NURBS : 0, 0, 0 );
 }
 
-Element::Element ( int index,
-                   const IntVector& connec )
+int ElemSet::addElement
 
-  : index_(index), 
-    connectivity_(connec), connectivity0_(connec)
+  ( int               index,
+    const IntVector&  connec )
 {
-  //print ( connectivity_.begin(), connectivity_.end() );
-  isQuadratic_ = false;
+  return add_ ( index, 0, connec, 0, 0, 0 );
 }
 
+int ElemSet::addElement
+
+  ( int               index,
+    int               elemType,
+    const IntVector&  connec,
+    int               bulk1,
+    int               bulk2 )
+{
+  return add_ ( index, elemType, connec,
+                connec.size() > 4 ? QUADRATIC : 0, bulk1, bulk2 );
+}
 
-Element::Element ( int index, int elemType,
-                   const IntVector& connec, int bulk1, int bulk2 )
+int ElemSet::add_
 
-  : index_(index), elemType_(elemType),
-    connectivity_(connec), connectivity0_(connec), 
-    done_(false), isQuadratic_(connec.size() > 4 ? true : false),
-    isChanged_(false), bulk1_(bulk1), bulk2_(bulk2)
+  ( int               index,
+    int               elemType,
+    const IntVector&  connec,
+    unsigned char     flags,
+    int               bulk1,
+    int               bulk2 )
 {
-  nodePerFace_ = 3;
+  if ( connOffset_.empty () ) connOffset_.push_back ( 0 );
+
+  index_   .push_back ( index    );
+  elemType_.push_back ( elemType );
+  bulk1_   .push_back ( bulk1    );
+  bulk2_   .push_back ( bulk2    );
+  flags_   .push_back ( flags    );
+
+  connectivity_ .insert ( connectivity_ .end (), connec.begin (), connec.end () );
+  connectivity0_.insert ( connectivity0_.end (), connec.begin (), connec.end () );
+
+  connOffset_.push_back ( connectivity_.size () );
+  faceOffset_.push_back ( NO_FACES );
+
+  return index_.size () - 1;
 }
 
 // ------------------------------------------------------------
-//    buildFaces
+//    ElemSet: reserveFaces
 // ------------------------------------------------------------
-//
-// attention: the faces must be oriented properly
-// so that the normals are outward.
 
-void Element::buildFaces ()
+void ElemSet::reserveFaces ()
 {
-  if       ( elemType_ == 4 )   // 4 node tetrahedron
-  {
-    buildFacesForTet4_ ();
-  }
-  else if  ( elemType_ == 11 )  // 10 node tetrahedron
-  {
-    buildFacesForTet10_ ();
-  }
-  else if  ( elemType_ == 5 )   // 8 node hexahedron
-  {
-    buildFacesForHex8_ ();
-  }
-  else if  ( elemType_ == 17 )  // 20 node hexahedron
+  const int  elemCount = size ();
+
+  for ( int i = 0; i < elemCount; i++ )
   {
-    buildFacesForHex20_ ();
+    getFaceSlot_ ( i );
   }
-  else
+}
+
+// ------------------------------------------------------------
+//    ElemSet: getFaceSlot_
+// ------------------------------------------------------------
+
+int* ElemSet::getFaceSlot_ ( int i )
+{
+  if ( faceOffset_[i] == NO_FACES )
   {
-    cerr << "Unsupported element type\n";
-    exit(1);
+    Element    elem ( this, i );
+
+    const int  faceCount = elem.getFaceCount_ ();
+
+    faceOffset_[i] = faceData_.size ();
+
+    faceData_.resize ( faceData_.size () +
+                       2 * faceCount * elem.getNodePerFace_ () +
+                       2 * faceCount * elem.getFullPerFace_ () +
+                       faceCount, 0 );
   }
+
+  return faceData_.data () + faceOffset_[i];
+}
+
+// ------------------------------------------------------------
+//    buildFaces
+// ------------------------------------------------------------
+//
+// faces of the modified connectivity; after buildFaces0 only needed
+// when the connectivity was changed (see MeshModifier::applyTearing)
+
+void Element::buildFaces ()
+{
+  storeFaces_ ( false );
 }
 
 // ------------------------------------------------------------
 //    buildFaces0
 // ------------------------------------------------------------
 //
-// attention: the faces must be oriented properly
-// so that the normals are outward.
+// the modified faces are the original ones until the element is torn
 
 void Element::buildFaces0 ()
 {
-
-  if       ( elemType_ == 4 )   // 4 node tetrahedron
-  {
-    buildFaces0ForTet4_ ();
-  }
-  else if  ( elemType_ == 11 )  // 10 node tetrahedron
-  {
-    buildFaces0ForTet10_ ();
-  }
-  else if  ( elemType_ == 5 )   // 8 node hexahedron
-  {
-    buildFaces0ForHex8_ ();
-  }
-  else if  ( elemType_ == 17 )  // 20 node hexahedron
-  {
-    buildFaces0ForHex20_ ();
-  }
-  else
-  {
-    cerr << "Unsupported element type\n";
-    exit(1);
-  }
+  storeFaces_ ( true  );
+  storeFaces_ ( false );
 }
 
 
@@ -145,21 +193,19 @@ bool Element::isOnExternalBoundary
    ( int       faceId,
      Global&   globdat ) const
 {
-  int         nodeCount = faces_[0].size ( );
+  int         nodeCount = getNodePerFace_ ( );
   int         id, pos, mat;
   //int         count;
 
-  IntVector   vertices(nodeCount);
-
-  vertices = faces0_[faceId];
+  const int*  vertices  = getFaceData_ ( true, false ) + faceId * nodeCount;
 
   // loop over nodes of face jf
 
   for ( int in = 0; in < nodeCount; in++ )
   {
       id  = vertices[in];
-      pos = globdat.nodeId2Position[id];
-      mat = globdat.nodeSet[pos]->getDuplicity ();
+      pos = globdat.nodeId2Position.get ( id );
+      mat = globdat.nodeSet.getDuplicity ( pos );
 
       // if this node is interfacial
 
@@ -179,22 +225,20 @@ bool Element::isUniqueFace
    ( int       faceId,
      Global&   globdat ) const
 {
-  int         nodeCount = faces_[0].size ( );
+  int         nodeCount = getNodePerFace_ ( );
   int         id, pos, mat;
   int         count(0);
   //int         count;
 
-  IntVector   vertices(nodeCount);
-
-  vertices = faces0_[faceId];
+  const int*  vertices  = getFaceData_ ( true, false ) + faceId * nodeCount;
 
   // loop over nodes of face jf
 
   for ( int in = 0; in < nodeCount; in++ )
   {
       id  = vertices[in];
-      pos = globdat.nodeId2Position[id];
-      mat = globdat.nodeSet[pos]->getDuplicity ();
+      pos = globdat.nodeId2Position.get ( id );
+      mat = globdat.nodeSet.getDuplicity ( pos );
 
       // if this node is interfacial
 
@@ -215,12 +259,12 @@ bool Element::isOnInterface
      int&              oppVertex,
      int&              fIndex,
      const NodeSet&    nodeSet,
-           Int2IntMap& position,
+           IdMap&      position,
      const Global&     globdat ) const      
 {
-  int         faceCount = faces_.   size ( );
+  int         faceCount = getFaceCount_   ( );
   //cout << faceCount <<  "\n";
-  int         nodeCount = faces_[0].size ( );
+  int         nodeCount = getNodePerFace_ ( );
   int         id, pos, mat;
   int         count;
 
@@ -230,13 +274,13 @@ bool Element::isOnInterface
     return false;
   }
 
-  IntVector   vertices(nodeCount);
+  const int*  vertices;
 
   // loop over faces of 3D element
 
   for ( int jf = 0; jf < faceCount; jf++ )
   {
-    vertices = faces_[jf];
+    vertices = getFaceData_ ( false, false ) + jf * nodeCount;
 
     count    = 0;
 
@@ -247,7 +291,7 @@ bool Element::isOnInterface
       id  = vertices[in];
       pos = position[id];
 
-      mat = nodeSet[pos]->getDuplicity ();
+      mat = nodeSet.getDuplicity ( pos );
 
       // if this node is interfacial
 
@@ -259,9 +303,8 @@ bool Element::isOnInterface
 
     if ( count == nodeCount ) 
     {
-      face.resize ( count );
-      face      = vertices;
-      oppVertex = oppositeVertices_[jf];
+      face.assign ( vertices, vertices + count );
+      oppVertex = getOppVertex ( jf );
 
       fIndex    = jf;
 
@@ -280,22 +323,24 @@ bool Element::isOnInterface
 bool Element::isInterfaceElement 
 
          ( const NodeSet& nodeSet,
-	   Int2IntMap& position,
+	   IdMap&      position,
        const Global& globdat ) const
 {
-  int nodeCount  = connectivity0_.size ();
-      nodeCount *= isQuadratic_ ? 0.5 : 1;
+  IntSpan connec = getConnectivity0 ();
+
+  int nodeCount  = connec.size ();
+      nodeCount *= set_->getFlag_ ( pos_, ElemSet::QUADRATIC ) ? 0.5 : 1;
 
-  if ( elemType_ == 17 ) nodeCount = 8;
+  if ( getElemType () == 17 ) nodeCount = 8;
 	 
-  int nodeFace   = nodePerFace_;    
+  int nodeFace   = getNodePerFace_ ();    
       //nodeFace  *= isQuadratic_ ? 0.5 : 1;
 
   int index, count(0);
 
   for ( int in = 0; in < nodeCount; in++ )
   {
-    index = connectivity0_[in];
+    index = connec[in];
     if ( find ( globdat.interfaceNodes.begin(),
                 globdat.interfaceNodes.end(), index ) 
              != globdat.interfaceNodes.end () ) count++;
@@ -313,11 +358,11 @@ bool Element::isInterfacialFace
       ( int faceId,
        const Global& globdat ) const
 {
-  int nodeFace   = nodePerFace_;    
+  int nodeFace   = getNodePerFace_ ();    
   int index, count(0);
 
-  IntVector face = faces0_[faceId];
-  int nodeCount = face.size ();
+  const int* face = getFaceData_ ( true, false ) + faceId * nodeFace;
+  int nodeCount = nodeFace;
 
   for ( int in = 0; in < nodeCount; in++ )
   {
@@ -336,9 +381,9 @@ bool Element::isInterfacialFace
 
 void Element::getSortedFaces ( vector<IntVector>& faces ) const
 {
-  int facesCount =  faces_.size () ;
-  faces.resize ( facesCount );
-  faces = faces_;
+  copyFaces_ ( faces, false, false );
+
+  int facesCount =  faces.size () ;
 
   // sort faces
 
@@ -354,9 +399,9 @@ void Element::getSortedFaces ( vector<IntVector>& faces ) const
 
 void Element::getSortedFaces0 ( vector<IntVector>& faces ) const
 {
-  int facesCount =  faces0_.size ();
-  faces.resize ( facesCount );
-  faces = faces0_;
+  copyFaces_ ( faces, true, false );
+
+  int facesCount =  faces.size ();
 
   // sort faces
 
@@ -374,8 +419,7 @@ void Element::getFaces
       
          ( vector<IntVector>& faces ) const
 {
-  faces.resize ( faces_.size () );
-  faces = faces_;
+  copyFaces_ ( faces, false, false );
 }
 
 // -------------------------------------------------------
@@ -386,55 +430,85 @@ void Element::getFFaces
       
          ( vector<IntVector>& faces ) const
 {
-  faces.resize ( ffaces_.size () );
-  faces = ffaces_;
+  copyFaces_ ( faces, false, true );
 }
 
-
 // -------------------------------------------------------
-//   getCornerConnectivity0
+//   copyFaces_
 // -------------------------------------------------------
-// node numbering for quadratic elements: 
-// follow Gmsh rule: corner nodes midside nodes
 
-void  Element::getCornerConnectivity0
+// no faces until buildFaces (buildFaces0) has been called
 
-    ( IntVector& connec ) const
+void Element::copyFaces_ 
+
+         ( vector<IntVector>& faces,
+           bool               original,
+           bool               full ) const
 {
-  if ( !isQuadratic_ )
+  const ElemSet::Flag built = original ? ElemSet::FACES0 : ElemSet::FACES;
+
+  if ( !set_->getFlag_ ( pos_, built ) )
   {
-    getConnectivity0 ( connec );  
+    faces.clear ();
+    return;
   }
-  else
-  {
-    int count = connectivity0_.size () / 2;
-    connec.resize ( count );
 
-    for ( int i = 0; i < count; i++ )
-    {
-      connec[i] = connectivity0_[i];
-    }
+  const int  faceCount = getFaceCount_ ();
+  const int  nodeCount = full ? getFullPerFace_ () : getNodePerFace_ ();
+  const int* data      = getFaceData_ ( original, full );
+
+  faces.resize ( faceCount );
+
+  for ( int jf = 0; jf < faceCount; jf++ )
+  {
+    faces[jf].assign ( data + jf * nodeCount, data + ( jf + 1 ) * nodeCount );
   }
 }
 
-void  Element::getCornerConnectivity
+// faces of connec; the opposite vertices always come from the
+// modified connectivity
+
+template <int F, int C, int N>
+static void  fillFaces
+
+  ( const LocalFaces<F,C,N>&  local,
+    IntSpan                   connec,
+    IntSpan                   modified,
+    int*                      corners,
+    int*                      all,
+    int*                      opp )
 
-    ( IntVector& connec ) const
 {
-  if ( !isQuadratic_ )
+  for ( int jf = 0; jf < F; jf++ )
   {
-    getConnectivity ( connec );  
+    for ( int i = 0; i < C; i++ ) *corners++ = connec[local.corners[jf][i]];
+    for ( int i = 0; i < N; i++ ) *all++     = connec[local.full   [jf][i]];
+
+    opp[jf] = modified[local.opposite[jf]];
   }
-  else
+}
+
+// -------------------------------------------------------
+//   storeFaces_
+// -------------------------------------------------------
+
+void Element::storeFaces_ ( bool original )
+{
+  set_->getFaceSlot_ ( pos_ );
+
+  IntSpan    connec    = original ? getConnectivity0 () : getConnectivity ();
+  IntSpan    modified  = getConnectivity ();
+
+  int*       corners   = const_cast<int*> ( getFaceData_ ( original, false ) );
+  int*       all       = const_cast<int*> ( getFaceData_ ( original, true  ) );
+  int*       opp       = const_cast<int*> ( getOppVertices_ () );
+
+  dispatch3D ( getElemType (), [&] ( auto traits )
   {
-    int count = connectivity_.size () / 2;
-    connec.resize ( count );
+    fillFaces ( decltype(traits)::faces, connec, modified, corners, all, opp );
+  } );
 
-    for ( int i = 0; i < count; i++ )
-    {
-      connec[i] = connectivity_[i];
-    }
-  }
+  set_->setFlag_ ( pos_, original ? ElemSet::FACES0 : ElemSet::FACES, true );
 }
 
 // -------------------------------------------------------
@@ -449,22 +523,21 @@ void Element::getBoundsOfFace
 	   int                  fIndex,
 	   Global&              globdat) const
 {
-  IntVector      vertices ( nodePerFace_ );
+  const int      nodePerFace = getNodePerFace_ ();
+  const int*     vertices    = getFaceData_ ( false, false ) + fIndex * nodePerFace;
   vector<double> xCoord, yCoord, zCoord;
 
   double         x,y,z;
   int            id, pos;
 
-  vertices = faces_[fIndex];
-
-  for ( int in = 0; in < nodePerFace_; in++ )
+  for ( int in = 0; in < nodePerFace; in++ )
   {
     id  = vertices[in];
     pos = globdat.nodeId2Position[id];
 
-    x = globdat.nodeSet[pos]->getX();
-    y = globdat.nodeSet[pos]->getY();
-    z = globdat.nodeSet[pos]->getZ();
+    x = globdat.nodeSet.getX ( pos );
+    y = globdat.nodeSet.getY ( pos );
+    z = globdat.nodeSet.getZ ( pos );
 
     xCoord.push_back ( x );
     yCoord.push_back ( y );
@@ -496,29 +569,46 @@ void Element::getBoundsOfFace
 //   getJemConnectivity
 // -------------------------------------------------------
 
+// node i of connec is node order[i] of connectivity
+
+template <int N>
+static void  reorderNodes
+
+  ( IntVector&       connec,
+    IntSpan          connectivity,
+    const int      (&order)[N] )
+
+{
+  for ( int i = 0; i < N; i++ ) connec[i] = connectivity[order[i]];
+}
+
 void Element::getJemConnectivity
 
          ( IntVector& connec )            const
 {
-  connec.resize ( connectivity_.size() );
+  IntSpan   connectivity = getConnectivity ();
+  const int elemType     = getElemType ();
 
-  if      ( !isQuadratic_ || isNURBS_ )
+  connec.resize ( connectivity.size() );
+
+  if      ( !set_->getFlag_ ( pos_, ElemSet::QUADRATIC ) ||
+             set_->getFlag_ ( pos_, ElemSet::NURBS ) )
   {
-    getJemConnectLinear_ ( connec );
+    connec.assign ( connectivity.begin(), connectivity.end() );
   }
   else 
   {
-    if      ( elemType_ == 11 )
+    if      ( elemType == 11 )
     {
-      getJemConnectTet10_ ( connec );
+      reorderNodes ( connec, connectivity, ElementTraits<11>::jemOrder );
     }
-    else if ( elemType_ == 17 )
+    else if ( elemType == 17 )
     {
-      getJemConnectHex20_ ( connec );
+      reorderNodes ( connec, connectivity, ElementTraits<17>::jemOrder );
     }
-    else if ( elemType_ == 8 )
+    else if ( elemType == 8 )
     {
-      getJemConnectLinear_ ( connec );
+      connec.assign ( connectivity.begin(), connectivity.end() );
     }
     else
     {
@@ -537,8 +627,7 @@ struct PrintElement : public unary_function<ElemPointer,void>
 
   void   operator () ( const ElemPointer ep ) const
   {
-    IntVector connec;
-    ep->getConnectivity ( connec );
+    IntSpan connec = ep->getConnectivity ();
 
     copy ( connec.begin(), connec.end(), 
 	   ostream_iterator<int> (of, " ") );
@@ -561,18 +650,18 @@ int Element::getIndexElementContainsEdge
         int                    node1,
         int                    node2 ) const
 {
-  IntVector   neighbors, jnodes;
+  IntSpan     neighbors;
+  IntSpan     jnodes;
   int         neiCount;
   int         jelem;
   int         res(-1000);
-  IntVector::const_iterator it1, it2;
+  IntSpan::const_iterator it1, it2;
   ElemPointer jp;
 
-  // loop over neighbors of current element and find the one contains edge (node1,node2)
+  // loop over the edge neighbors of current element and find the one contains edge (node1,node2)
   // using the modified connectivity not the original one!!!
 
-  //cout << index_ << " " << endl;
-  neighbors = globdat.elemNeighbors[globdat.elemId2Position[index_]];
+  neighbors = globdat.elemNeighbors.getNeighbors ( pos_ );
   neiCount  = neighbors.size();
 
   //print(neighbors.begin(),neighbors.end());
@@ -580,12 +669,10 @@ int Element::getIndexElementContainsEdge
 
   for(int je = 0; je < neiCount; je++)
   {
-    jelem = globdat.elemId2Position[neighbors[je]];
+    jelem = neighbors[je];
     jp    = globdat.elemSet[jelem];
 
-    if ( jp->getIndex() == index_ ) continue;
-
-    jp->getCornerConnectivity (jnodes);
+    jnodes = jp->getCornerConnectivity ();
   
     //print(jnodes.begin(),jnodes.end());
 
@@ -612,15 +699,16 @@ int Element::getIndexElementContainsFace
       ( Global&                globdat,
         const IntVector&       face ) const
 {
-  IntVector         neighbors, jnodes, sface;
+  IntSpan           neighbors;
   int               neiCount;
   int               jelem;
   int               res(-1000);
   ElemPointer       jp;
   vector<IntVector> jfaces;
 
-  //cout << index_ << " " << endl;
-  neighbors = globdat.elemNeighbors[globdat.elemId2Position[index_]];
+  // only the face neighbors of current element can share a face
+
+  neighbors = globdat.elemNeighbors.getNeighbors ( pos_ );
   neiCount  = neighbors.size();
 
   //print(neighbors.begin(),neighbors.end());
@@ -630,11 +718,9 @@ int Element::getIndexElementContainsFace
 
   for(int je = 0; je < neiCount; je++)
   {
-    jelem = globdat.elemId2Position[neighbors[je]];
+    jelem = neighbors[je];
     jp    = globdat.elemSet[jelem];
 
-    if ( jp->getIndex() == index_ ) continue;
-
     jp->getSortedFaces0 (jfaces);
 
     if ( find (jfaces.begin(), jfaces.end(), face) != jfaces.end() )
@@ -655,490 +741,6 @@ double Element::computeElementSize ( Global&  globdat ) const
    return computeElementSizeTriangle_ ( globdat );
 }
 
-// ----------------------------------------------------------
-//   buildFacesForTet4
-// ----------------------------------------------------------
-
-void Element::buildFacesForTet4_ ()
-{
-  faces_ .resize ( 4 );
-  ffaces_.resize ( 4 );
-  oppositeVertices_.resize ( 4 );
-
-  faces_[0].resize ( 3 );
-  faces_[1].resize ( 3 );
-  faces_[2].resize ( 3 );
-  faces_[3].resize ( 3 );
-
-  faces_[0][0] = connectivity_[0];
-  faces_[0][1] = connectivity_[1];
-  faces_[0][2] = connectivity_[3];
-  oppositeVertices_[0] = connectivity_[2];
-
-  faces_[1][0] = connectivity_[1];
-  faces_[1][1] = connectivity_[2];
-  faces_[1][2] = connectivity_[3];
-  oppositeVertices_[1] = connectivity_[0];
-
-  faces_[2][0] = connectivity_[0];
-  faces_[2][1] = connectivity_[2];
-  faces_[2][2] = connectivity_[3];
-  oppositeVertices_[2] = connectivity_[1];
-
-  faces_[3][0] = connectivity_[0];
-  faces_[3][1] = connectivity_[1];
-  faces_[3][2] = connectivity_[2];
-  oppositeVertices_[3] = connectivity_[3];
-  
-  ffaces_ = faces_;
-
-  nodePerFace_ = 3;
-}
-
-
-// ----------------------------------------------------------
-//   buildFaces0ForTet4
-// ----------------------------------------------------------
-
-void Element::buildFaces0ForTet4_ ()
-{
-  //cout << "...building faces for 4 node tetrahedra";
-  faces0_ .resize ( 4 );
-  ffaces0_.resize ( 4 );
-  oppositeVertices_.resize ( 4 );
-
-  faces0_[0].resize ( 3 );
-  faces0_[1].resize ( 3 );
-  faces0_[2].resize ( 3 );
-  faces0_[3].resize ( 3 );
-
-  faces0_[0][0] = connectivity0_[0];
-  faces0_[0][1] = connectivity0_[1];
-  faces0_[0][2] = connectivity0_[3];
-  oppositeVertices_[0] = connectivity0_[2];
-
-  faces0_[1][0] = connectivity0_[1];
-  faces0_[1][1] = connectivity0_[2];
-  faces0_[1][2] = connectivity0_[3];
-  oppositeVertices_[1] = connectivity0_[0];
-
-  faces0_[2][0] = connectivity0_[0];
-  faces0_[2][1] = connectivity0_[2];
-  faces0_[2][2] = connectivity0_[3];
-  oppositeVertices_[2] = connectivity0_[1];
-
-  faces0_[3][0] = connectivity0_[0];
-  faces0_[3][1] = connectivity0_[1];
-  faces0_[3][2] = connectivity0_[2];
-  oppositeVertices_[3] = connectivity0_[3];
-
-  ffaces0_ = faces0_;
-
-  nodePerFace_ = 3;
-}
-
-// ----------------------------------------------------------
-//   buildFacesForTet10
-// ----------------------------------------------------------
-
-void Element::buildFacesForTet10_ ()
-{
-  faces_. resize ( 4 );
-  ffaces_.resize ( 4 );
-  oppositeVertices_.resize ( 4 );
-
-  faces_[0].resize ( 3 ); faces_[1].resize ( 3 );
-  faces_[2].resize ( 3 ); faces_[3].resize ( 3 );
-
-  faces_[0][0] = connectivity_[0];
-  faces_[0][1] = connectivity_[1];
-  faces_[0][2] = connectivity_[3];
-  oppositeVertices_[0] = connectivity_[2];
-
-  ffaces_[0].resize ( 6 );
-  ffaces_[0][0] = connectivity_[0]; ffaces_[0][3] = connectivity_[4];
-  ffaces_[0][1] = connectivity_[1]; ffaces_[0][4] = connectivity_[9];
-  ffaces_[0][2] = connectivity_[3]; ffaces_[0][5] = connectivity_[7];
-
-  faces_[1][0] = connectivity_[1];
-  faces_[1][1] = connectivity_[2];
-  faces_[1][2] = connectivity_[3];
-  oppositeVertices_[1] = connectivity_[0];
-
-  ffaces_[1].resize ( 6 );
-  ffaces_[1][0] = connectivity_[1]; ffaces_[1][3] = connectivity_[5];
-  ffaces_[1][1] = connectivity_[2]; ffaces_[1][4] = connectivity_[8];
-  ffaces_[1][2] = connectivity_[3]; ffaces_[1][5] = connectivity_[9];
-
-  faces_[2][0] = connectivity_[0];
-  faces_[2][1] = connectivity_[2];
-  faces_[2][2] = connectivity_[3];
-  oppositeVertices_[2] = connectivity_[1];
-
-  ffaces_[2].resize ( 6 );
-  ffaces_[2][0] = connectivity_[0]; ffaces_[2][3] = connectivity_[6];
-  ffaces_[2][1] = connectivity_[2]; ffaces_[2][4] = connectivity_[8];
-  ffaces_[2][2] = connectivity_[3]; ffaces_[2][5] = connectivity_[7];
-
-  faces_[3][0] = connectivity_[0];
-  faces_[3][1] = connectivity_[1];
-  faces_[3][2] = connectivity_[2];
-  oppositeVertices_[3] = connectivity_[3];
-
-  ffaces_[3].resize ( 6 );
-  ffaces_[3][0] = connectivity_[0]; ffaces_[3][3] = connectivity_[4];
-  ffaces_[3][1] = connectivity_[1]; ffaces_[3][4] = connectivity_[5];
-  ffaces_[3][2] = connectivity_[2]; ffaces_[3][5] = connectivity_[6];
-
-  nodePerFace_ = 3;
-}
-
-
-// ----------------------------------------------------------
-//   buildFaces0ForTet10
-// ----------------------------------------------------------
-
-void Element::buildFaces0ForTet10_ ()
-{
-  faces0_. resize ( 4 );
-  ffaces0_.resize ( 4 );
-  oppositeVertices_.resize ( 4 );
-
-  faces0_[0].resize ( 3 ); faces0_[1].resize ( 3 );
-  faces0_[2].resize ( 3 ); faces0_[3].resize ( 3 );
-
-  faces0_[0][0] = connectivity0_[0];
-  faces0_[0][1] = connectivity0_[1];
-  faces0_[0][2] = connectivity0_[3];
-  oppositeVertices_[0] = connectivity0_[2];
-
-  ffaces0_[0].resize ( 6 );
-  ffaces0_[0][0] = connectivity0_[0]; ffaces0_[0][3] = connectivity0_[4];
-  ffaces0_[0][1] = connectivity0_[1]; ffaces0_[0][4] = connectivity0_[9];
-  ffaces0_[0][2] = connectivity0_[3]; ffaces0_[0][5] = connectivity0_[7];
-
-  faces0_[1][0] = connectivity0_[1];
-  faces0_[1][1] = connectivity0_[2];
-  faces0_[1][2] = connectivity0_[3];
-  oppositeVertices_[1] = connectivity0_[0];
-
-  ffaces0_[1].resize ( 6 );
-  ffaces0_[1][0] = connectivity0_[1]; ffaces0_[1][3] = connectivity0_[5];
-  ffaces0_[1][1] = connectivity0_[2]; ffaces0_[1][4] = connectivity0_[8];
-  ffaces0_[1][2] = connectivity0_[3]; ffaces0_[1][5] = connectivity0_[9];
-
-  faces0_[2][0] = connectivity0_[0];
-  faces0_[2][1] = connectivity0_[2];
-  faces0_[2][2] = connectivity0_[3];
-  oppositeVertices_[2] = connectivity0_[1];
-
-  ffaces0_[2].resize ( 6 );
-  ffaces0_[2][0] = connectivity0_[0]; ffaces0_[2][3] = connectivity0_[6];
-  ffaces0_[2][1] = connectivity0_[2]; ffaces0_[2][4] = connectivity0_[8];
-  ffaces0_[2][2] = connectivity0_[3]; ffaces0_[2][5] = connectivity0_[7];
-
-  faces0_[3][0] = connectivity0_[0];
-  faces0_[3][1] = connectivity0_[1];
-  faces0_[3][2] = connectivity0_[2];
-  oppositeVertices_[3] = connectivity0_[3];
-
-  ffaces0_[3].resize ( 6 );
-  ffaces0_[3][0] = connectivity0_[0]; ffaces0_[3][3] = connectivity0_[4];
-  ffaces0_[3][1] = connectivity0_[1]; ffaces0_[3][4] = connectivity0_[5];
-  ffaces0_[3][2] = connectivity0_[2]; ffaces0_[3][5] = connectivity0_[6];
-
-  nodePerFace_ = 3;
-}
-
-// ----------------------------------------------------------
-//   buildFacesForHex8
-// ----------------------------------------------------------
-
-void Element::buildFacesForHex8_ ()
-{
-  isQuadratic_ = false;
-
-  faces_.           resize ( 6 );
-  ffaces_.          resize ( 6 );
-  oppositeVertices_.resize ( 6 );
-
-  faces_[0].resize ( 4 ); faces_[1].resize ( 4 ); faces_[2].resize ( 4 );
-  faces_[3].resize ( 4 ); faces_[4].resize ( 4 ); faces_[5].resize ( 4 );
-
-  faces_[0][0] = connectivity_[0];
-  faces_[0][1] = connectivity_[3];
-  faces_[0][2] = connectivity_[2];
-  faces_[0][3] = connectivity_[1];
-  oppositeVertices_[0] = connectivity_[4];
-
-  faces_[1][0] = connectivity_[4];
-  faces_[1][1] = connectivity_[7];
-  faces_[1][2] = connectivity_[6];
-  faces_[1][3] = connectivity_[5];
-  oppositeVertices_[1] = connectivity_[0];
-
-  faces_[2][0] = connectivity_[4];
-  faces_[2][1] = connectivity_[0];
-  faces_[2][2] = connectivity_[1];
-  faces_[2][3] = connectivity_[5];
-  oppositeVertices_[2] = connectivity_[7];
-
-  faces_[3][0] = connectivity_[7];
-  faces_[3][1] = connectivity_[6];
-  faces_[3][2] = connectivity_[2];
-  faces_[3][3] = connectivity_[3];
-  oppositeVertices_[3] = connectivity_[4];
-
-  faces_[4][0] = connectivity_[1];
-  faces_[4][1] = connectivity_[5];
-  faces_[4][2] = connectivity_[6];
-  faces_[4][3] = connectivity_[2];
-  oppositeVertices_[4] = connectivity_[0];
-
-  faces_[5][0] = connectivity_[3];
-  faces_[5][1] = connectivity_[0];
-  faces_[5][2] = connectivity_[4];
-  faces_[5][3] = connectivity_[7];
-  oppositeVertices_[5] = connectivity_[2];
-
-  ffaces_ = faces_;
-
-  nodePerFace_ = 4;
-}
-
-// ----------------------------------------------------------
-//   buildFaces0ForHex8
-// ----------------------------------------------------------
-
-void Element::buildFaces0ForHex8_ ()
-{
-  isQuadratic_ = false;
-
-  faces0_.          resize ( 6 );
-  ffaces0_.         resize ( 6 );
-  oppositeVertices_.resize ( 6 );
-
-  faces0_[0].resize ( 4 ); faces0_[1].resize ( 4 ); faces0_[2].resize ( 4 );
-  faces0_[3].resize ( 4 ); faces0_[4].resize ( 4 ); faces0_[5].resize ( 4 );
-
-  faces0_[0][0] = connectivity0_[0];
-  faces0_[0][1] = connectivity0_[3];
-  faces0_[0][2] = connectivity0_[2];
-  faces0_[0][3] = connectivity0_[1];
-  oppositeVertices_[0] = connectivity_[4];
-
-  faces0_[1][0] = connectivity0_[4];
-  faces0_[1][1] = connectivity0_[7];
-  faces0_[1][2] = connectivity0_[6];
-  faces0_[1][3] = connectivity0_[5];
-  oppositeVertices_[1] = connectivity_[0];
-
-  faces0_[2][0] = connectivity0_[4];
-  faces0_[2][1] = connectivity0_[0];
-  faces0_[2][2] = connectivity0_[1];
-  faces0_[2][3] = connectivity0_[5];
-  oppositeVertices_[2] = connectivity_[7];
-
-  faces0_[3][0] = connectivity0_[7];
-  faces0_[3][1] = connectivity0_[6];
-  faces0_[3][2] = connectivity0_[2];
-  faces0_[3][3] = connectivity0_[3];
-  oppositeVertices_[3] = connectivity_[4];
-
-  faces0_[4][0] = connectivity0_[1];
-  faces0_[4][1] = connectivity0_[5];
-  faces0_[4][2] = connectivity0_[6];
-  faces0_[4][3] = connectivity0_[2];
-  oppositeVertices_[4] = connectivity_[0];
-
-  faces0_[5][0] = connectivity0_[3];
-  faces0_[5][1] = connectivity0_[0];
-  faces0_[5][2] = connectivity0_[4];
-  faces0_[5][3] = connectivity0_[7];
-  oppositeVertices_[5] = connectivity_[2];
-
-  ffaces0_ = faces0_;
-
-  nodePerFace_ = 4;
-}
-
-// ----------------------------------------------------------
-//   buildFacesForHex20
-// ----------------------------------------------------------
-
-void Element::buildFacesForHex20_ ()
-{
-  faces_.           resize ( 6 );
-  ffaces_.          resize ( 6 );
-  oppositeVertices_.resize ( 6 );
-
-  faces_[0].resize ( 4 ); faces_[1].resize ( 4 ); faces_[2].resize ( 4 );
-  faces_[3].resize ( 4 ); faces_[4].resize ( 4 ); faces_[5].resize ( 4 );
-
-  faces_[0][0] = connectivity_[0];
-  faces_[0][1] = connectivity_[3];
-  faces_[0][2] = connectivity_[2];
-  faces_[0][3] = connectivity_[1];
-  oppositeVertices_[0] = connectivity_[4];
-
-  ffaces_[0].resize ( 8 );
-  ffaces_[0][0] = connectivity_[0]; ffaces_[0][4] = connectivity_[8];
-  ffaces_[0][1] = connectivity_[1]; ffaces_[0][5] = connectivity_[11];
-  ffaces_[0][2] = connectivity_[2]; ffaces_[0][6] = connectivity_[13];
-  ffaces_[0][3] = connectivity_[3]; ffaces_[0][7] = connectivity_[9];
-
-  faces_[1][0] = connectivity_[4];
-  faces_[1][1] = connectivity_[7];
-  faces_[1][2] = connectivity_[6];
-  faces_[1][3] = connectivity_[5];
-  oppositeVertices_[1] = connectivity_[0];
-
-  ffaces_[1].resize ( 8 );
-  ffaces_[1][0] = connectivity_[4]; ffaces_[1][4] = connectivity_[16];
-  ffaces_[1][1] = connectivity_[5]; ffaces_[1][5] = connectivity_[18];
-  ffaces_[1][2] = connectivity_[6]; ffaces_[1][6] = connectivity_[19];
-  ffaces_[1][3] = connectivity_[7]; ffaces_[1][7] = connectivity_[17];
-
-  faces_[2][0] = connectivity_[4];
-  faces_[2][1] = connectivity_[0];
-  faces_[2][2] = connectivity_[1];
-  faces_[2][3] = connectivity_[5];
-  oppositeVertices_[2] = connectivity_[7];
-
-  ffaces_[2].resize ( 8 );
-  ffaces_[2][0] = connectivity_[4]; ffaces_[2][4] = connectivity_[16];
-  ffaces_[2][1] = connectivity_[5]; ffaces_[2][5] = connectivity_[12];
-  ffaces_[2][2] = connectivity_[1]; ffaces_[2][6] = connectivity_[8];
-  ffaces_[2][3] = connectivity_[0]; ffaces_[2][7] = connectivity_[10];
-
-  faces_[3][0] = connectivity_[7];
-  faces_[3][1] = connectivity_[6];
-  faces_[3][2] = connectivity_[2];
-  faces_[3][3] = connectivity_[3];
-  oppositeVertices_[3] = connectivity_[4];
-
-  ffaces_[3].resize ( 8 );
-  ffaces_[3][0] = connectivity_[7];  ffaces_[3][4] = connectivity_[19];
-  ffaces_[3][1] = connectivity_[6];  ffaces_[3][5] = connectivity_[14];
-  ffaces_[3][2] = connectivity_[2];  ffaces_[3][6] = connectivity_[13];
-  ffaces_[3][3] = connectivity_[3];  ffaces_[3][7] = connectivity_[15];
-
-  faces_[4][0] = connectivity_[1];
-  faces_[4][1] = connectivity_[5];
-  faces_[4][2] = connectivity_[6];
-  faces_[4][3] = connectivity_[2];
-  oppositeVertices_[4] = connectivity_[0];
-
-  ffaces_[4].resize ( 8 );
-  ffaces_[4][0] = connectivity_[1]; ffaces_[4][4] = connectivity_[11];
-  ffaces_[4][1] = connectivity_[2]; ffaces_[4][5] = connectivity_[14];
-  ffaces_[4][2] = connectivity_[6]; ffaces_[4][6] = connectivity_[18];
-  ffaces_[4][3] = connectivity_[5]; ffaces_[4][7] = connectivity_[12];
-
-  faces_[5][0] = connectivity_[3];
-  faces_[5][1] = connectivity_[0];
-  faces_[5][2] = connectivity_[4];
-  faces_[5][3] = connectivity_[7];
-  oppositeVertices_[5] = connectivity_[2];
-
-  ffaces_[5].resize ( 8 );
-  ffaces_[5][0] = connectivity_[3]; ffaces_[5][4] = connectivity_[15];
-  ffaces_[5][1] = connectivity_[7]; ffaces_[5][5] = connectivity_[17];
-  ffaces_[5][2] = connectivity_[4]; ffaces_[5][6] = connectivity_[10];
-  ffaces_[5][3] = connectivity_[0]; ffaces_[5][7] = connectivity_[9];
-
-  nodePerFace_ = 4;
-}
-
-
-// ----------------------------------------------------------
-//   buildFaces0ForHex20
-// ----------------------------------------------------------
-
-void Element::buildFaces0ForHex20_ ()
-{
-  faces0_.           resize ( 6 );
-  ffaces0_.          resize ( 6 );
-  oppositeVertices_.resize ( 6 );
-
-  faces0_[0].resize ( 4 ); faces0_[1].resize ( 4 ); faces0_[2].resize ( 4 );
-  faces0_[3].resize ( 4 ); faces0_[4].resize ( 4 ); faces0_[5].resize ( 4 );
-
-  faces0_[0][0] = connectivity0_[0];
-  faces0_[0][1] = connectivity0_[3];
-  faces0_[0][2] = connectivity0_[2];
-  faces0_[0][3] = connectivity0_[1];
-  oppositeVertices_[0] = connectivity_[4];
-
-  ffaces0_[0].resize ( 8 );
-  ffaces0_[0][0] = connectivity0_[0]; ffaces0_[0][4] = connectivity0_[8];
-  ffaces0_[0][1] = connectivity0_[1]; ffaces0_[0][5] = connectivity0_[11];
-  ffaces0_[0][2] = connectivity0_[2]; ffaces0_[0][6] = connectivity0_[13];
-  ffaces0_[0][3] = connectivity0_[3]; ffaces0_[0][7] = connectivity0_[9];
-
-  faces0_[1][0] = connectivity0_[4];
-  faces0_[1][1] = connectivity0_[7];
-  faces0_[1][2] = connectivity0_[6];
-  faces0_[1][3] = connectivity0_[5];
-  oppositeVertices_[1] = connectivity_[0];
-
-  ffaces0_[1].resize ( 8 );
-  ffaces0_[1][0] = connectivity0_[4]; ffaces0_[1][4] = connectivity0_[16];
-  ffaces0_[1][1] = connectivity0_[5]; ffaces0_[1][5] = connectivity0_[18];
-  ffaces0_[1][2] = connectivity0_[6]; ffaces0_[1][6] = connectivity0_[19];
-  ffaces0_[1][3] = connectivity0_[7]; ffaces0_[1][7] = connectivity0_[17];
-
-  faces0_[2][0] = connectivity0_[4];
-  faces0_[2][1] = connectivity0_[0];
-  faces0_[2][2] = connectivity0_[1];
-  faces0_[2][3] = connectivity0_[5];
-  oppositeVertices_[2] = connectivity0_[7];
-
-  ffaces0_[2].resize ( 8 );
-  ffaces0_[2][0] = connectivity0_[4]; ffaces0_[2][4] = connectivity0_[16];
-  ffaces0_[2][1] = connectivity0_[5]; ffaces0_[2][5] = connectivity0_[12];
-  ffaces0_[2][2] = connectivity0_[1]; ffaces0_[2][6] = connectivity0_[8];
-  ffaces0_[2][3] = connectivity0_[0]; ffaces0_[2][7] = connectivity0_[10];
-
-  faces0_[3][0] = connectivity0_[7];
-  faces0_[3][1] = connectivity0_[6];
-  faces0_[3][2] = connectivity0_[2];
-  faces0_[3][3] = connectivity0_[3];
-  oppositeVertices_[3] = connectivity_[4];
-
-  ffaces0_[3].resize ( 8 );
-  ffaces0_[3][0] = connectivity0_[7];  ffaces0_[3][4] = connectivity0_[19];
-  ffaces0_[3][1] = connectivity0_[6];  ffaces0_[3][5] = connectivity0_[14];
-  ffaces0_[3][2] = connectivity0_[2];  ffaces0_[3][6] = connectivity0_[13];
-  ffaces0_[3][3] = connectivity0_[3];  ffaces0_[3][7] = connectivity0_[15];
-
-  faces0_[4][0] = connectivity0_[1];
-  faces0_[4][1] = connectivity0_[5];
-  faces0_[4][2] = connectivity0_[6];
-  faces0_[4][3] = connectivity0_[2];
-  oppositeVertices_[4] = connectivity_[0];
-
-  ffaces0_[4].resize ( 8 );
-  ffaces0_[4][0] = connectivity0_[1]; ffaces0_[4][4] = connectivity0_[11];
-  ffaces0_[4][1] = connectivity0_[2]; ffaces0_[4][5] = connectivity0_[14];
-  ffaces0_[4][2] = connectivity0_[6]; ffaces0_[4][6] = connectivity0_[18];
-  ffaces0_[4][3] = connectivity0_[5]; ffaces0_[4][7] = connectivity0_[12];
-
-  faces0_[5][0] = connectivity0_[3];
-  faces0_[5][1] = connectivity0_[0];
-  faces0_[5][2] = connectivity0_[4];
-  faces0_[5][3] = connectivity0_[7];
-  oppositeVertices_[5] = connectivity_[2];
-
-  ffaces0_[5].resize ( 8 );
-  ffaces0_[5][0] = connectivity0_[3]; ffaces0_[5][4] = connectivity0_[15];
-  ffaces0_[5][1] = connectivity0_[7]; ffaces0_[5][5] = connectivity0_[17];
-  ffaces0_[5][2] = connectivity0_[4]; ffaces0_[5][6] = connectivity0_[10];
-  ffaces0_[5][3] = connectivity0_[0]; ffaces0_[5][7] = connectivity0_[9];
-
-  nodePerFace_ = 4;
-}
-
 // ----------------------------------------------------
 //    getJemConnect2DQuadratic_
 // ----------------------------------------------------
@@ -1149,86 +751,46 @@ void Element::getJemConnect2DQuadratic_
 
      ( IntVector& connect )            const
 {
+  IntSpan connectivity = getConnectivity ();
 
   int  NodeCount = connect.size ();
   int  halfNodeCount = connect.size () / 2;
 
   for ( int i = 0; i < halfNodeCount; i++ )
   {
-    connect[2*i]   = connectivity_[i];
-    connect[2*i+1] = connectivity_[halfNodeCount+i];
+    connect[2*i]   = connectivity[i];
+    connect[2*i+1] = connectivity[halfNodeCount+i];
   }
 
   // Q9 element
   double remainder = halfNodeCount - connect.size () / 2.0;
-  if( remainder !=0.0 ) connect[NodeCount-1] = connectivity_[NodeCount-1];
+  if( remainder !=0.0 ) connect[NodeCount-1] = connectivity[NodeCount-1];
 
-  //print(connectivity_.begin(),connectivity_.end());
+  //print(connectivity.begin(),connectivity.end());
 }
 
 
-// ----------------------------------------------------
-//    getJemConnectTet10_
-// ----------------------------------------------------
-
-
-void Element::getJemConnectTet10_
-
-     ( IntVector& connect )            const
-{
-  connect[0] = connectivity_[0]; connect[3] = connectivity_[9];
-  connect[1] = connectivity_[7]; connect[4] = connectivity_[1];
-  connect[2] = connectivity_[3]; connect[5] = connectivity_[4];
-
-  connect[6] = connectivity_[6];
-  connect[7] = connectivity_[8];
-  connect[8] = connectivity_[5];
-
-  connect[9] = connectivity_[2];
-}
-
-
-// ----------------------------------------------------
-//    getJemConnectHex20_
-// ----------------------------------------------------
-
-void Element::getJemConnectHex20_
-
-     ( IntVector& connect )            const
-{
-  connect[0]  = connectivity_[0];  connect[4] = connectivity_[5];
-  connect[1]  = connectivity_[10]; connect[5] = connectivity_[12];
-  connect[2]  = connectivity_[4];  connect[6] = connectivity_[1];
-  connect[3]  = connectivity_[16]; connect[7] = connectivity_[8];
-
-  connect[8]  = connectivity_[9];  connect[10] = connectivity_[18];
-  connect[9]  = connectivity_[17]; connect[11] = connectivity_[11];
-
-  connect[12] = connectivity_[3];  connect[16] = connectivity_[6];
-  connect[13] = connectivity_[15]; connect[17] = connectivity_[14];
-  connect[14] = connectivity_[7];  connect[18] = connectivity_[2];
-  connect[15] = connectivity_[19]; connect[19] = connectivity_[13];
-}
-
 // ----------------------------------------------------
 //    computeElementSizeTriangle_
 // ----------------------------------------------------
 
 double Element::computeElementSizeTriangle_ ( Global&  globdat ) const
 {
-  int id1 = connectivity0_[0]; 
-  int id2 = connectivity0_[1]; 
-  int id3 = connectivity0_[2]; 
+  IntSpan connectivity0 = getConnectivity0 ();
+
+  int id1 = connectivity0[0]; 
+  int id2 = connectivity0[1]; 
+  int id3 = connectivity0[2]; 
   
-  NodePointer node1, node2, node3;
+  const NodeSet& nodes = globdat.nodeSet;
 
-  node1 = globdat.nodeSet[globdat.nodeId2Position[id1]];
-  node2 = globdat.nodeSet[globdat.nodeId2Position[id2]];
-  node3 = globdat.nodeSet[globdat.nodeId2Position[id3]];
+  int node1 = globdat.nodeId2Position[id1];
+  int node2 = globdat.nodeId2Position[id2];
+  int node3 = globdat.nodeId2Position[id3];
 
-  double x1 = node1->getX ( ); double y1 = node1->getY ( ); double z1 = node1->getZ ();
-  double x2 = node2->getX ( ); double y2 = node2->getY ( ); double z2 = node2->getZ ();
-  double x3 = node3->getX ( ); double y3 = node3->getY ( ); double z3 = node3->getZ ();
+  double x1 = nodes.getX ( node1 ); double y1 = nodes.getY ( node1 ); double z1 = nodes.getZ ( node1 );
+  double x2 = nodes.getX ( node2 ); double y2 = nodes.getY ( node2 ); double z2 = nodes.getZ ( node2 );
+  double x3 = nodes.getX ( node3 ); double y3 = nodes.getY ( node3 ); double z3 = nodes.getZ ( node3 );
   
   double a = sqrt ( pow ( x2 - x1, 2 ) + pow ( y2 - y1, 2 ) + pow ( z2 - z1, 2 ) );
   double b = sqrt ( pow ( x3 - x2, 2 ) + pow ( y3 - y2, 2 ) + pow ( z3 - z2, 2 ) );
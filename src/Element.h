@@ -1,7 +1,7 @@
 /**
  * This file is a part of the interface element generator program.
  *
- * V.P.Nguyen, 
+ * V.P.Nguyen,
  * TU Delft 2009
  * Cardiff University, 2013
  *
@@ -11,8 +11,11 @@
 #define ELEMENT_H
 
 #include "typedefs.h"
+#include "IntSpan.h"
 
 struct Global;
+class  IdMap;
+class  ElemSet;
 
 // =====================================================================
 //     class ELEMENT
@@ -21,6 +24,10 @@ struct Global;
 // For quadratic elements:
 // the connectivity follows Gmsh's format !!!
 
+// An Element is a view of one element of an ElemSet, all data is
+// stored in the set. Elements are added with ElemSet::addElement and
+// accessed through ElemPointer (elemSet[ie]->getIndex()).
+
 class Element
 {
   public:
@@ -29,47 +36,30 @@ class Element
 
                          Element
 
-	( int index, int elemType, 
-	  const IntVector& connec );
-
-                         Element
-
-	( int index, int elemType, 
-	  const IntVector& connec, bool isNURBS );
-
-			 Element
-
-	( int index, 
-	  const IntVector& connec );
+	() : set_(0), pos_(-1) {}
 
                          Element
 
-	( int index, int elemType, 
-	  const IntVector& connec, int bulk1, int bulk2 );
+	( ElemSet* set, int pos ) : set_(set), pos_(pos) {}
 
     // get the new connectivity (full)
 
-    inline void		 getConnectivity
-
-        ( IntVector& connec ) const;
+    inline IntSpan	 getConnectivity  () const;
 
     // get the original connectivity (full)
-    
-    inline void		 getConnectivity0
 
-        ( IntVector& connec ) const;
+    inline IntSpan	 getConnectivity0 () const;
 
     // get indices of corner nodes of unmodified mesh
     // for linear elements == getConnectivity0
-    // for quadratic elements: 
-
-    void		 getCornerConnectivity0
+    // for quadratic elements: the first half of getConnectivity0
 
-        ( IntVector& connec ) const;
+    inline IntSpan	 getCornerConnectivity0 () const;
 
-    void		 getCornerConnectivity
+    inline IntSpan	 getCornerConnectivity  () const;
 
-        ( IntVector& connec ) const;
+    // the node count of an element does not change: newConnec must
+    // have the size of the current connectivity
 
     inline void          setConnectivity
 
@@ -83,15 +73,22 @@ class Element
     inline int           getBulk2    () const;
 
     inline void          setElemType ( int type );
-    inline void          setDone     ( bool done ); 
+    inline void          setDone     ( bool done );
 
     inline int           getOppVertex (int faceID) const;
 
-    inline void          changeConnectivity 
-      
+    inline void          changeConnectivity
+
         ( int oldId, int newId );
 
-    // 3D elements: build face datastructures
+    // give the local node i of the (modified) connectivity the id newId
+
+    inline void          changeNode
+
+        ( int i, int newId );
+
+    // 3D elements: build face datastructures (buildFaces0: original
+    // faces, buildFaces: faces of the modified connectivity)
 
     void                 buildFaces0 ( );
     void                 buildFaces  ( );
@@ -101,26 +98,36 @@ class Element
     // Face with vertices only, not full face
 
     void                 getSortedFaces0
-      
+
          ( vector<IntVector>& faces ) const;
 
     // The same as getSortedFaces0 but for modified mesh
-    
+
     void                 getSortedFaces
-      
+
          ( vector<IntVector>& faces ) const;
-    
+
+    // number of faces, 0 before buildFaces0 (and for 2D elements)
+
+    inline int           getFaceCount () const;
+
+    // corner nodes of the face faceId of the original mesh (unsorted)
+
+    inline IntSpan       getFace0
+
+         ( int faceId ) const;
+
     // Get unsorted faces (vertices only)
 
-    void                 getFaces 
-      
+    void                 getFaces
+
          ( vector<IntVector>& faces ) const;
-    
-    void                 getFFaces 
-      
+
+    void                 getFFaces
+
          ( vector<IntVector>& faces ) const;
-    
-    inline void          getFullFace 
+
+    inline void          getFullFace
 
          ( IntVector& fface,
 	   int        index ) const;
@@ -128,33 +135,43 @@ class Element
     // return all nodes of the face indexed index
     // used for quadratic 3D elements
 
-    inline void          getFullFace0 
+    inline void          getFullFace0
 
          ( IntVector& fface,
 	   int        index ) const;
 
+    // same, without copy (modified and original mesh)
+
+    inline IntSpan       getFullFace
+
+         ( int        index ) const;
+
+    inline IntSpan       getFullFace0
+
+         ( int        index ) const;
+
    // check if a 3D element has a face on the interface or not
-   // if so, return the indices of nodes of that face 
-    
-   bool                  isOnInterface 
-      
-         ( IntVector&        face,    
+   // if so, return the indices of nodes of that face
+
+   bool                  isOnInterface
+
+         ( IntVector&        face,
 	   int&              oppVertex,
 	   int&              fIndex,
 	   const NodeSet&    nodeSet,
-	         Int2IntMap& position,
+	         IdMap&      position,
        const Global&     globdat ) const;
 
-   // check if a 3D element has a face on the interface or not 
+   // check if a 3D element has a face on the interface or not
 
-   bool                  isInterfaceElement 
+   bool                  isInterfaceElement
 
          ( const NodeSet&    nodeSet,
-	         Int2IntMap&     position,
+	         IdMap&          position,
            const Global&     globdat ) const;
 
    // check if the face, faceId, is on an interface
-   
+
    bool                  isInterfacialFace
 
          ( int               faceId,
@@ -174,15 +191,15 @@ class Element
 
    bool                  isOnExternalBoundary
 
-         ( int                   faceId, 
+         ( int                   faceId,
            Global&               globdat ) const;
-   
+
    // return true for face that cannot be separated (on the rigid domain for
    // example)
 
    bool                  isUniqueFace
 
-         ( int                   faceId, 
+         ( int                   faceId,
            Global&               globdat ) const;
 
 
@@ -205,66 +222,211 @@ class Element
 
       ( Global&                globdat,
         const IntVector&       face ) const;
-   
-   double                computeElementSize 
-      
+
+   double                computeElementSize
+
       ( Global&                globdat ) const;
 
   private:
 
-   void                  buildFacesForTet4_   ( );
-   void                  buildFaces0ForTet4_  ( );
-   void                  buildFacesForTet10_  ( );
-   void                  buildFaces0ForTet10_ ( );
-   void                  buildFacesForHex8_   ( );
-   void                  buildFaces0ForHex8_  ( );
-   void                  buildFacesForHex20_  ( );
-   void                  buildFaces0ForHex20_ ( );
+   friend class          ElemSet;
 
+   // fill the face slot from the original or the modified
+   // connectivity (opposite vertices: always the modified one)
 
-   inline void           getJemConnectLinear_
+   void                  storeFaces_
 
-         ( IntVector& connec )            const; 
+         ( bool                     original );
 
-   void                  getJemConnect2DQuadratic_
+   // copy the faces out of the face slot
+
+   void                  copyFaces_
 
-         ( IntVector& connec )            const; 
+         ( vector<IntVector>&       faces,
+           bool                     original,
+           bool                     full )  const;
 
-   void                  getJemConnectTet10_
+   // corner (full=false) or all (full=true) nodes of the faces
 
-         ( IntVector& connec )            const; 
+   inline const int*     getFaceData_
 
+         ( bool                     original,
+           bool                     full )  const;
 
-   void                  getJemConnectHex20_
+   inline const int*     getOppVertices_ ()  const;
 
-         ( IntVector& connec )            const; 
+   inline int            getFaceCount_   ()  const;
+   inline int            getNodePerFace_ ()  const;
+   inline int            getFullPerFace_ ()  const;
+
+   void                  getJemConnect2DQuadratic_
+
+         ( IntVector& connec )            const;
 
    double                computeElementSizeTriangle_( Global& globdat ) const;
 
   private:
 
-    int                  index_;
-    int                  elemType_;   // used with Paraview format
+    ElemSet*             set_;
+    int                  pos_;        // position in set_
+};
+
+// =====================================================================
+//     class ElemPointer
+// =====================================================================
+
+// handle to an element of an ElemSet, used like a pointer to Element
+
+class ElemPointer
+{
+  public:
 
-    IntVector            connectivity_;     // modified connectivity array
-    IntVector            connectivity0_;    // original connectivity array
+                         ElemPointer () {}
 
-    bool                 done_;
-    bool                 isQuadratic_;
-    bool                 isChanged_;
-    bool                 isNURBS_;
-    int                  bulk1_;
-    int                  bulk2_;
+                         ElemPointer ( ElemSet* set, int pos ) : elem_(set,pos) {}
 
-    // 3D data
+    Element*             operator->  () const { return &elem_; }
+    Element&             operator*   () const { return elem_;  }
 
-    vector<IntVector>    faces_;             // store the corner vertex indices of faces
-    vector<IntVector>    faces0_;            // store the corner vertex indices of faces
-    vector<IntVector>    ffaces_;            // store the vertex indices of faces (modified mesh)
-    vector<IntVector>    ffaces0_;           // store the vertex indices of faces (original mesh)
-    IntVector            oppositeVertices_; // store the opposite vertices of  all faces
+  private:
 
-    int                  nodePerFace_;
+    mutable Element      elem_;
+};
+
+// =====================================================================
+//     class ElemSet
+// =====================================================================
+
+/*
+ * The elements are stored as a structure of arrays. The modified and
+ * the original connectivities of all elements are kept in two pools,
+ * each element owning a slot with as many entries as its type has
+ * nodes. The faces of 3D elements (built by Element::buildFaces0 and
+ * Element::buildFaces) go into a third pool, one fixed size slot per
+ * element type. ElemPointer and Element only refer to the set and a
+ * position, so they stay valid when elements are added.
+ */
+
+class ElemSet
+{
+  public:
+
+    int                  size        () const { return index_.size (); }
+    bool                 empty       () const { return index_.empty (); }
+
+    void                 reserve
+
+      ( int                elemCount,
+        int                nodeCount = 0 );
+
+    void                 clear       ();
+
+    // allocate the face slots not allocated yet, so that the faces of
+    // several elements can then be built at the same time
+
+    void                 reserveFaces ();
+
+    // as with a vector of pointers, the elements of a const set can be
+    // modified through the returned handle
+
+    ElemPointer          operator[]  ( int i ) const
+    {
+      return ElemPointer ( const_cast<ElemSet*> ( this ), i );
+    }
+
+    // append an element, return its position.
+    // quadratic if elemType is one of Element::gmshQuadraticElemTypes
+
+    int                  addElement
+
+      ( int                index,
+        int                elemType,
+        const IntVector&   connec );
+
+    // linear, possibly NURBS element
+
+    int                  addElement
+
+      ( int                index,
+        int                elemType,
+        const IntVector&   connec,
+        bool               isNURBS );
+
+    // interface element without type
+
+    int                  addElement
+
+      ( int                index,
+        const IntVector&   connec );
+
+    // interface element between the bulk elements bulk1 and bulk2
+
+    int                  addElement
+
+      ( int                index,
+        int                elemType,
+        const IntVector&   connec,
+        int                bulk1,
+        int                bulk2 );
+
+  private:
+
+    friend class         Element;
+
+    enum                 Flag
+    {
+      DONE      = 1,
+      QUADRATIC = 2,
+      CHANGED   = 4,
+      NURBS     = 8,
+      FACES0    = 16,   // buildFaces0 called
+      FACES     = 32    // buildFaces  called
+    };
+
+    static constexpr size_t NO_FACES = (size_t) -1;
+
+    int                  add_
+
+      ( int                index,
+        int                elemType,
+        const IntVector&   connec,
+        unsigned char      flags,
+        int                bulk1,
+        int                bulk2 );
+
+    // face slot of element i, allocated on first use
+
+    int*                 getFaceSlot_ ( int i );
+
+    bool                 getFlag_     ( int i, Flag flag ) const
+    {
+      return flags_[i] & flag;
+    }
+
+    void                 setFlag_     ( int i, Flag flag, bool on )
+    {
+      if ( on ) flags_[i] |=  flag;
+      else      flags_[i] &= ~flag;
+    }
+
+  private:
+
+    IntVector               index_;
+    IntVector               elemType_;   // used with Paraview format
+    IntVector               bulk1_;
+    IntVector               bulk2_;
+    vector<unsigned char>   flags_;
+
+    // element i: [connOffset_[i], connOffset_[i+1]) in both pools
+
+    vector<size_t>          connOffset_;
+    IntVector               connectivity_;     // modified connectivities
+    IntVector               connectivity0_;    // original connectivities
+
+    // element i: face slot starting at faceOffset_[i], see getFaceData_
+
+    vector<size_t>          faceOffset_;
+    IntVector               faceData_;
 };
 
 // ==========================================================
@@ -279,87 +441,132 @@ struct PrintElement;
 
 inline int Element::getIndex () const
 {
-  return index_;
+  return set_->index_[pos_];
 }
 
 inline int Element::getElemType () const
 {
-  return elemType_;
+  return set_->elemType_[pos_];
 }
 
 inline int Element::getBulk1 () const
 {
-  return bulk1_;
+  return set_->bulk1_[pos_];
 }
 
 inline int Element::getBulk2 () const
 {
-  return bulk2_;
+  return set_->bulk2_[pos_];
 }
 
 inline void  Element::setElemType ( int type )
 {
-  elemType_ = type;
+  set_->elemType_[pos_] = type;
 }
 
-inline  void Element::setDone ( bool done ) 
+inline  void Element::setDone ( bool done )
 {
-  done_ = done;
+  set_->setFlag_ ( pos_, ElemSet::DONE, done );
 }
 
-inline bool Element::getDone () const 
-{ 
-  return done_;
+inline bool Element::getDone () const
+{
+  return set_->getFlag_ ( pos_, ElemSet::DONE );
 }
 
-inline bool Element::getChanged () const 
-{ 
-  return isChanged_;
+inline bool Element::getChanged () const
+{
+  return set_->getFlag_ ( pos_, ElemSet::CHANGED );
 }
 
-inline void Element::getConnectivity
-
-   ( IntVector& connec ) const
+inline IntSpan Element::getConnectivity () const
 {
-  connec.resize ( connectivity_.size() );
-  connec = connectivity_;	
+  const int* data = set_->connectivity_.data ();
+
+  return IntSpan ( data + set_->connOffset_[pos_],
+                   data + set_->connOffset_[pos_+1] );
 }
 
-inline void Element::getConnectivity0
+inline IntSpan Element::getConnectivity0 () const
+{
+  const int* data = set_->connectivity0_.data ();
+
+  return IntSpan ( data + set_->connOffset_[pos_],
+                   data + set_->connOffset_[pos_+1] );
+}
 
-   ( IntVector& connec ) const
+inline IntSpan Element::getCornerConnectivity0 () const
 {
-  connec.resize ( connectivity0_.size() );
-  connec = connectivity0_;	
+  IntSpan connec = getConnectivity0 ();
+
+  if ( !set_->getFlag_ ( pos_, ElemSet::QUADRATIC ) ) return connec;
+
+  return IntSpan ( connec.begin (), connec.begin () + connec.size () / 2 );
 }
 
+inline IntSpan Element::getCornerConnectivity () const
+{
+  IntSpan connec = getConnectivity ();
+
+  if ( !set_->getFlag_ ( pos_, ElemSet::QUADRATIC ) ) return connec;
+
+  return IntSpan ( connec.begin (), connec.begin () + connec.size () / 2 );
+}
 
 inline void Element::setConnectivity
 
         ( const IntVector& newConnec )
 {
-  connectivity_ = newConnec;
+  copy ( newConnec.begin (), newConnec.end (),
+         set_->connectivity_.begin () + set_->connOffset_[pos_] );
 }
 
 inline void Element::changeConnectivity ( int oldId, int newId )
 {
-  replace ( connectivity_.begin(),
-	    connectivity_.end  (),
-	    oldId, newId );
+  IntVector::iterator first = set_->connectivity_.begin () + set_->connOffset_[pos_];
+  IntVector::iterator last  = set_->connectivity_.begin () + set_->connOffset_[pos_+1];
+
+  replace ( first, last, oldId, newId );
 
-  if ( !isChanged_ && newId != oldId )
+  if ( newId != oldId )
   {
-    isChanged_ = true;
+    set_->setFlag_ ( pos_, ElemSet::CHANGED, true );
   }
 }
 
+inline void Element::changeNode ( int i, int newId )
+{
+  int& id = set_->connectivity_[set_->connOffset_[pos_] + i];
+
+  if ( newId != id )
+  {
+    id = newId;
+    set_->setFlag_ ( pos_, ElemSet::CHANGED, true );
+  }
+}
+
+inline int Element::getFaceCount () const
+{
+  return set_->getFlag_ ( pos_, ElemSet::FACES0 ) ? getFaceCount_ () : 0;
+}
+
+inline IntSpan Element::getFace0 ( int faceId ) const
+{
+  const int  count = getNodePerFace_ ();
+  const int* first = getFaceData_ ( true, false ) + faceId * count;
+
+  return IntSpan ( first, first + count );
+}
+
 inline void Element::getFullFace
 
    ( IntVector& fface,
      int        index ) const
 {
-  fface.resize ( ffaces_[0].size() );
-  fface = ffaces_[index];	
+  const int  count = getFullPerFace_ ();
+  const int* first = getFaceData_ ( false, true ) + index * count;
+
+  fface.assign ( first, first + count );
 }
 
 inline void Element::getFullFace0
@@ -367,26 +574,83 @@ inline void Element::getFullFace0
    ( IntVector& fface,
      int        index ) const
 {
-  fface.resize ( ffaces0_[0].size() );
-  fface = ffaces0_[index];	
+  const int  count = getFullPerFace_ ();
+  const int* first = getFaceData_ ( true, true ) + index * count;
+
+  fface.assign ( first, first + count );
 }
 
-inline void Element::getJemConnectLinear_
+inline IntSpan Element::getFullFace ( int index ) const
+{
+  const int  count = getFullPerFace_ ();
+  const int* first = getFaceData_ ( false, true ) + index * count;
 
-   ( IntVector& connec ) const
+  return IntSpan ( first, first + count );
+}
+
+inline IntSpan Element::getFullFace0 ( int index ) const
 {
-  connec.resize ( connectivity_.size() );
-  connec = connectivity_;	
+  const int  count = getFullPerFace_ ();
+  const int* first = getFaceData_ ( true, true ) + index * count;
+
+  return IntSpan ( first, first + count );
 }
 
 inline void Element::setNURBS ()
 {
-  isNURBS_ = true;
+  set_->setFlag_ ( pos_, ElemSet::NURBS, true );
 }
 
 inline int Element::getOppVertex (int faceID) const
 {
-  return oppositeVertices_[faceID];
+  return getOppVertices_ ()[faceID];
+}
+
+// face slot layout: corner nodes of the original faces, corner nodes
+// of the modified faces, all nodes of the original faces, all nodes
+// of the modified faces, opposite vertices
+
+inline const int* Element::getFaceData_
+
+   ( bool original,
+     bool full ) const
+{
+  const int* slot    = set_->faceData_.data () + set_->faceOffset_[pos_];
+  const int  corners = getFaceCount_ () * getNodePerFace_ ();
+  const int  all     = getFaceCount_ () * getFullPerFace_ ();
+
+  if ( !full ) return slot + ( original ? 0 : corners );
+
+  return slot + 2 * corners + ( original ? 0 : all );
+}
+
+inline const int* Element::getOppVertices_ () const
+{
+  return getFaceData_ ( false, true ) + getFaceCount_ () * getFullPerFace_ ();
+}
+
+inline int Element::getFaceCount_ () const
+{
+  const int type = getElemType ();
+
+  return ( type == 5 || type == 17 ) ? 6 : 4;
+}
+
+inline int Element::getNodePerFace_ () const
+{
+  const int type = getElemType ();
+
+  return ( type == 5 || type == 17 ) ? 4 : 3;
+}
+
+inline int Element::getFullPerFace_ () const
+{
+  const int type = getElemType ();
+
+  if ( type == 11 ) return 6;
+  if ( type == 17 ) return 8;
+
+  return getNodePerFace_ ();
 }
 
 #endif
@@ -0,0 +1,266 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * ElementTraits gives, at compile time, what the code needs to know
+ * about every supported Gmsh element type: node and corner counts, the
+ * local faces of the 3D elements (corner nodes, all nodes, opposite
+ * vertex), the local edges of the 2D elements, the node order of the
+ * Jem and VTK formats and the node count of the matching interface
+ * element.
+ *
+ * A mesh has one element type (see GmshMeshBuilder), so the loops over
+ * all elements or faces are templated on the traits and dispatched once
+ * per mesh with dispatch2D/dispatch3D instead of testing the element
+ * type (or globdat.isQuadratic) for every element.
+ */
+
+#ifndef ELEMENT_TRAITS_H
+#define ELEMENT_TRAITS_H
+
+#include <cstdlib>
+#include <iostream>
+
+// =====================================================================
+//     local faces and edges
+// =====================================================================
+
+// corner nodes, all nodes and opposite vertex of every face as local
+// node numbers. attention: the faces are oriented so that the normals
+// are outward.
+
+template <int FaceCount, int CornerCount, int FullCount>
+struct LocalFaces
+{
+  int  corners  [FaceCount][CornerCount];
+  int  full     [FaceCount][FullCount];
+  int  opposite [FaceCount];
+};
+
+// edge k of a 2D element: corners k and k+1 (closed loop) and, for
+// quadratic elements, the midside node cornerCount+k (Gmsh order)
+
+template <int CornerCount>
+struct LocalEdges
+{
+  int  nodes    [CornerCount][2];
+};
+
+// =====================================================================
+//     struct ElementTraits
+// =====================================================================
+
+template <int GmshType>
+struct ElementTraits;
+
+// ---------------------------------------------------------------------
+//   2D elements
+// ---------------------------------------------------------------------
+
+template <int NodeCount, int CornerCount, bool Quadratic>
+struct ElementTraits2D
+{
+  static constexpr int    dim                = 2;
+  static constexpr int    nodeCount          = NodeCount;
+  static constexpr int    cornerCount        = CornerCount;
+  static constexpr bool   isQuadratic        = Quadratic;
+
+  // nodes per edge and per (continuum) interface element
+
+  static constexpr int    nodesPerEdge       = Quadratic ? 3 : 2;
+  static constexpr int    interfaceNodeCount = 2 * nodesPerEdge;
+
+  static constexpr LocalEdges<CornerCount> edges = []
+  {
+    LocalEdges<CornerCount> e {};
+
+    for ( int k = 0; k < CornerCount; k++ )
+    {
+      e.nodes[k][0] = k;
+      e.nodes[k][1] = ( k + 1 ) % CornerCount;
+    }
+
+    return e;
+  } ();
+};
+
+template <> struct ElementTraits<2>  : ElementTraits2D<3,3,false> {};  // 3 node triangle
+template <> struct ElementTraits<3>  : ElementTraits2D<4,4,false> {};  // 4 node quadrangle
+template <> struct ElementTraits<9>  : ElementTraits2D<6,3,true>  {};  // 6 node triangle
+template <> struct ElementTraits<16> : ElementTraits2D<8,4,true>  {};  // 8 node quadrangle
+template <> struct ElementTraits<10> : ElementTraits2D<9,4,true>  {};  // 9 node quadrangle
+
+// ---------------------------------------------------------------------
+//   3D elements
+// ---------------------------------------------------------------------
+
+template <int NodeCount, int CornerCount, int FaceCount,
+          int NodesPerFace, int FullPerFace>
+struct ElementTraits3D
+{
+  static constexpr int    dim                = 3;
+  static constexpr int    nodeCount          = NodeCount;
+  static constexpr int    cornerCount        = CornerCount;
+  static constexpr bool   isQuadratic        = FullPerFace > NodesPerFace;
+
+  static constexpr int    faceCount          = FaceCount;
+  static constexpr int    nodesPerFace       = NodesPerFace;
+  static constexpr int    fullPerFace        = FullPerFace;
+  static constexpr int    interfaceNodeCount = 2 * FullPerFace;
+
+  typedef LocalFaces<FaceCount,NodesPerFace,FullPerFace>  Faces;
+};
+
+// 4 node tetrahedron
+
+template <> struct ElementTraits<4> : ElementTraits3D<4,4,4,3,3>
+{
+  static constexpr Faces  faces =
+  {
+    { { 0, 1, 3 }, { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 2 } },
+    { { 0, 1, 3 }, { 1, 2, 3 }, { 0, 2, 3 }, { 0, 1, 2 } },
+    {   2,           0,           1,           3         }
+  };
+};
+
+// 10 node tetrahedron
+
+template <> struct ElementTraits<11> : ElementTraits3D<10,4,4,3,6>
+{
+  static constexpr Faces  faces =
+  {
+    { { 0, 1, 3 },          { 1, 2, 3 },          { 0, 2, 3 },          { 0, 1, 2 } },
+    { { 0, 1, 3, 4, 9, 7 }, { 1, 2, 3, 5, 8, 9 }, { 0, 2, 3, 6, 8, 7 }, { 0, 1, 2, 4, 5, 6 } },
+    {   2,                    0,                    1,                    3                 }
+  };
+
+  // node i of the Jem element is node jemOrder[i] of the Gmsh element
+
+  static constexpr int    jemOrder[10] = { 0, 7, 3, 9, 1, 4, 6, 8, 5, 2 };
+
+  // node i of the VTK cell is node vtkOrder[i] of the Gmsh element
+
+  static constexpr int    vtkOrder[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 9, 8 };
+};
+
+// 8 node hexahedron
+
+template <> struct ElementTraits<5> : ElementTraits3D<8,8,6,4,4>
+{
+  static constexpr Faces  faces =
+  {
+    { { 0, 3, 2, 1 }, { 4, 7, 6, 5 }, { 4, 0, 1, 5 },
+      { 7, 6, 2, 3 }, { 1, 5, 6, 2 }, { 3, 0, 4, 7 } },
+    { { 0, 3, 2, 1 }, { 4, 7, 6, 5 }, { 4, 0, 1, 5 },
+      { 7, 6, 2, 3 }, { 1, 5, 6, 2 }, { 3, 0, 4, 7 } },
+    {   4,              0,              7,
+        4,              0,              2            }
+  };
+};
+
+// 20 node hexahedron
+
+template <> struct ElementTraits<17> : ElementTraits3D<20,8,6,4,8>
+{
+  static constexpr Faces  faces =
+  {
+    { { 0, 3, 2, 1 }, { 4, 7, 6, 5 }, { 4, 0, 1, 5 },
+      { 7, 6, 2, 3 }, { 1, 5, 6, 2 }, { 3, 0, 4, 7 } },
+    { { 0, 1, 2, 3,  8, 11, 13,  9 }, { 4, 5, 6, 7, 16, 18, 19, 17 },
+      { 4, 5, 1, 0, 16, 12,  8, 10 }, { 7, 6, 2, 3, 19, 14, 13, 15 },
+      { 1, 2, 6, 5, 11, 14, 18, 12 }, { 3, 7, 4, 0, 15, 17, 10,  9 } },
+    {   4,              0,              7,
+        4,              0,              2            }
+  };
+
+  static constexpr int    jemOrder[20] = {  0, 10,  4, 16,  5, 12,  1,  8,  9, 17,
+                                           18, 11,  3, 15,  7, 19,  6, 14,  2, 13 };
+
+  static constexpr int    vtkOrder[20] = {  0,  1,  2,  3,  4,  5,  6,  7,  8, 11,
+                                           13,  9, 16, 18, 19, 17, 10, 12, 14, 15 };
+};
+
+// =====================================================================
+//     getVtkOrder
+// =====================================================================
+
+// node order of the VTK (and XDMF) cell of a Gmsh element type, 0 if
+// it is the Gmsh order
+
+inline const int* getVtkOrder ( int elemType )
+{
+  switch ( elemType )
+  {
+    case 11: return ElementTraits<11>::vtkOrder;
+    case 17: return ElementTraits<17>::vtkOrder;
+  }
+
+  return 0;
+}
+
+// =====================================================================
+//     getCornerCount
+// =====================================================================
+
+// number of corner nodes (the first nodes in Gmsh order) of a Gmsh
+// element type, 0 if the type is not supported
+
+inline int getCornerCount ( int elemType )
+{
+  switch ( elemType )
+  {
+    case  2: return ElementTraits<2>  ::cornerCount;
+    case  3: return ElementTraits<3>  ::cornerCount;
+    case  9: return ElementTraits<9>  ::cornerCount;
+    case 16: return ElementTraits<16> ::cornerCount;
+    case 10: return ElementTraits<10> ::cornerCount;
+    case  4: return ElementTraits<4>  ::cornerCount;
+    case 11: return ElementTraits<11> ::cornerCount;
+    case  5: return ElementTraits<5>  ::cornerCount;
+    case 17: return ElementTraits<17> ::cornerCount;
+  }
+
+  return 0;
+}
+
+// =====================================================================
+//     dispatch
+// =====================================================================
+
+// kernel ( ElementTraits<elemType>() ) for a 2D or a 3D element type
+
+template <class Kernel>
+void dispatch2D ( int elemType, const Kernel& kernel )
+{
+  switch ( elemType )
+  {
+    case  2: kernel ( ElementTraits<2>  () ); break;
+    case  3: kernel ( ElementTraits<3>  () ); break;
+    case  9: kernel ( ElementTraits<9>  () ); break;
+    case 16: kernel ( ElementTraits<16> () ); break;
+    case 10: kernel ( ElementTraits<10> () ); break;
+
+    default:
+
+      std::cerr << "Unsupported element type\n";
+      exit(1);
+  }
+}
+
+template <class Kernel>
+void dispatch3D ( int elemType, const Kernel& kernel )
+{
+  switch ( elemType )
+  {
+    case  4: kernel ( ElementTraits<4>  () ); break;
+    case 11: kernel ( ElementTraits<11> () ); break;
+    case  5: kernel ( ElementTraits<5>  () ); break;
+    case 17: kernel ( ElementTraits<17> () ); break;
+
+    default:
+
+      std::cerr << "Unsupported element type\n";
+      exit(1);
+  }
+}
+
+#endif
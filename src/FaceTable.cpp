@@ -0,0 +1,79 @@
+#include <climits>
+
+#include "FaceTable.h"
+#include "Element.h"
+#include "SharedFaces.h"
+
+// ------------------------------------------------------------
+//    build
+// ------------------------------------------------------------
+
+void FaceTable::build
+
+  ( const ElemSet&   elems,
+    const CSRGraph&  support,
+    const IdMap&     elemPositions,
+    int              threadCount )
+
+{
+  const int  elemCount = elems.size ();
+
+  IntVector  keys;
+
+  clear ();
+
+  faceOffset_.resize  ( elemCount + 1 );
+  faceOffset_[0] = 0;
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    faceOffset_[ie+1] = faceOffset_[ie] + elems[ie]->getFaceCount ();
+  }
+
+  // sorted corner nodes of every face, INT_MIN for the 4th node
+  // of a triangle
+
+  keys.resize ( 4 * faceOffset_[elemCount] );
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    ElemPointer  ep        = elems[ie];
+    const int    faceCount = ep->getFaceCount ();
+
+    for ( int kf = 0; kf < faceCount; kf++ )
+    {
+      IntSpan  face = ep->getFace0 ( kf );
+      int*     key  = &keys[4 * ( faceOffset_[ie] + kf )];
+
+      key[3] = INT_MIN;
+
+      copy ( face.begin (), face.end (), key );
+      sort ( key, key + face.size () );
+    }
+  } );
+
+  numberSharedFaces<4> ( faceIds_, ownerCount_, elems_, localFaces_,
+                         faceOffset_, keys, support, elemPositions,
+                         threadCount );
+
+  done_.assign ( faceCount (), 0 );
+}
+
+// ------------------------------------------------------------
+//    clear, resetDone
+// ------------------------------------------------------------
+
+void FaceTable::clear ()
+{
+  faceOffset_.clear ();
+  faceIds_   .clear ();
+  ownerCount_.clear ();
+  elems_     .clear ();
+  localFaces_.clear ();
+  done_      .clear ();
+}
+
+void FaceTable::resetDone ()
+{
+  done_.assign ( done_.size (), 0 );
+}
@@ -0,0 +1,97 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * FaceTable lists the faces of a 3D mesh (corner nodes of the original
+ * mesh, see Element::buildFaces0) once. The faces shared by two
+ * elements get the same face id; they are matched on their sorted
+ * corner nodes among the elements around their smallest node (see
+ * numberSharedFaces). Faces are numbered in the order in which they are
+ * first met when looping over the elements and their local faces, so
+ * looping over the faces visits them in the same order as that element
+ * loop, whatever the number of threads used to build the table.
+ */
+
+#ifndef FACE_TABLE_H
+#define FACE_TABLE_H
+
+#include "typedefs.h"
+
+class CSRGraph;
+class IdMap;
+
+// =====================================================================
+//     class FaceTable
+// =====================================================================
+
+class FaceTable
+{
+  public:
+
+    // number the faces of all elements of elems that have faces;
+    // support gives the element ids around every node (nodal support)
+    // and elemPositions their positions in elems
+
+    void                 build         ( const ElemSet&   elems,
+                                         const CSRGraph&  support,
+                                         const IdMap&     elemPositions,
+                                         int              threadCount = 1 );
+
+    void                 clear         ();
+
+    int                  faceCount     () const { return ownerCount_.size (); }
+
+    // number of local faces of the element at position ie
+
+    int                  getFaceCount  ( int ie ) const
+    {
+      return faceOffset_[ie+1] - faceOffset_[ie];
+    }
+
+    // face id of the local face kf of the element at position ie
+
+    int                  getFaceId     ( int ie, int kf ) const
+    {
+      return faceIds_[faceOffset_[ie] + kf];
+    }
+
+    // number of elements having the face, more than two for a
+    // non-manifold mesh (only the first two are kept)
+
+    int                  getOwnerCount ( int face ) const { return ownerCount_[face]; }
+
+    bool                 isInterior    ( int face ) const { return ownerCount_[face] > 1; }
+
+    // position of the element on side 0 (the first one met) or 1, and
+    // the local index of the face in that element
+
+    int                  getElement    ( int face, int side ) const
+    {
+      return elems_[2*face + side];
+    }
+
+    int                  getLocalFace  ( int face, int side ) const
+    {
+      return localFaces_[2*face + side];
+    }
+
+    // faces already given an interface element (material interface
+    // and polycrystal builders)
+
+    bool                 isDone        ( int face ) const { return done_[face]; }
+
+    void                 setDone       ( int face ) { done_[face] = 1; }
+
+    void                 resetDone     ();
+
+  private:
+
+    IntVector            faceOffset_;   // element i: faceIds_[faceOffset_[i] + kf]
+    IntVector            faceIds_;
+
+    IntVector            ownerCount_;
+    IntVector            elems_;        // two per face, -1 if none
+    IntVector            localFaces_;   // two per face, -1 if none
+    vector<char>         done_;
+};
+
+#endif
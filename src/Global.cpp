@@ -18,6 +18,11 @@ Global::Global()
   isHydraulic      = false;
   isMatlab         = false;
   outAbaqus        = false;
+  isParaviewZlib   = false;
+  isInterfaceBinary = false;
+  useMeshCache     = false;
+  threadCount      = 1;
+  interfaceStream  = 0;
   rigidDomain.push_back ( -10 ); 
   rigidDomain.push_back ( -20 ); 
   internalEdges.push_back ( 0 );
@@ -26,23 +31,29 @@ Global::Global()
 
 void Global::getBounds () 
 {
-  XCoordComp xcomp;  
-  YCoordComp ycomp;  
-  ZCoordComp zcomp;  
-
-  auto result = std::minmax_element ( nodeSet.begin (), nodeSet.end (), xcomp );  
-
-  xMin = (*result.first) ->getX();
-  xMax = (*result.second)->getX();
-
-  result = std::minmax_element ( nodeSet.begin (), nodeSet.end (), ycomp );  
-
-  yMin = (*result.first) ->getY();
-  yMax = (*result.second)->getY();
-
-  result = std::minmax_element ( nodeSet.begin (), nodeSet.end (), zcomp );  
-
-  zMin = (*result.first) ->getZ();
-  zMax = (*result.second)->getZ();
+  const int     nodeCount = nodeSet.size ();
+
+  const double* x         = nodeSet.getXData ();
+  const double* y         = nodeSet.getYData ();
+  const double* z         = nodeSet.getZData ();
+
+  if ( nodeCount == 0 )
+  {
+    xMin = xMax = yMin = yMax = zMin = zMax = 0.;
+    return;
+  }
+
+  // one sweep over the coordinate arrays
+
+  xMin = xMax = x[0];
+  yMin = yMax = y[0];
+  zMin = zMax = z[0];
+
+  for ( int in = 1; in < nodeCount; in++ )
+  {
+    xMin = std::min ( xMin, x[in] ); xMax = std::max ( xMax, x[in] );
+    yMin = std::min ( yMin, y[in] ); yMax = std::max ( yMax, y[in] );
+    zMin = std::min ( zMin, z[in] ); zMax = std::max ( zMax, z[in] );
+  }
 }
 
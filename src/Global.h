@@ -3,8 +3,16 @@
 
 #include "typedefs.h"
 #include "utilities.h"
+#include "CSRGraph.h"
+#include "IdMap.h"
+#include "Node.h"
+#include "Element.h"
+#include "FaceTable.h"
+#include "EdgeTable.h"
+#include "DualGraph.h"
 
 struct NodePair;
+class  InterfaceStream;
 
 
 
@@ -25,23 +33,26 @@ struct Global
    NodeSet                  newNodeSet;      // set of original nodes+new added nodes
    ElemSet                  elemSet;         // set of volumetric elements (modified)
    ElemSet                  interfaceSet;    // set of interface elements 
+   InterfaceStream*         interfaceStream; // --stream: interface elements go there instead
    ElemSet                  flowElemSet;     // set of flow elements (when isHydraulic=true) 
    ElemSet                  bndElementSet;   // set of boundary elements (for external force vector) 
 
-   Int2IntVectMap           nodeSupport;     // nodal support 
+   CSRGraph                 nodeSupport;     // nodal support: node id => elements
    Int2IntVectMap           duplicatedNodes;
    Int2IntVectMap           duplicatedNodes0; // back up for above
    IntVector                flowNodes;       // flowNodes[nodeId]=flow node index
    Int2IntVectMap           dom2Elems;       // given a domain ID -> list of elements 
    Int2IntVectMap           mat2InterfaceElems;
    Int2IntVectMap           dom2BndElems;
-   Int2IntMap               elem2Domain;
+   IdMap                    elem2Domain;     // given elem's id => domain (material)
    Int2StringMap            physicalNames;
-   Int2IntMap               nodeId2Position; // given node's id => position in nodeSet
-   Int2IntMap               elemId2Position; // given elem's id => position in elemSet
+   IdMap                    nodeId2Position; // given node's id => position in nodeSet
+   IdMap                    elemId2Position; // given elem's id => position in elemSet
    IntSet                   boundaryNodes;   // id of nodes on the external boundary
    Int2IntSetMap            bndNodesMap;
-   vector<IntVector>        elemNeighbors;
+   DualGraph                elemNeighbors;   // elements sharing a face (3D) or an edge (2D)
+   FaceTable                faceTable;       // 3D: faces of the original mesh
+   EdgeTable                edgeTable;       // 2D: edges of the original mesh
    vector<NodePair>         nodePairs;     // 2D line elements on the boundary
    IntVector                bndElemsDomain; 
    IntVector                isolatedNodes; // store physical points from Gmsh
@@ -62,6 +73,7 @@ struct Global
    IntVector                internalEdges; // id of internal edges (saved as physical lines in gmsh)
    int                      nodeElemCount; // no of nodes per solid element
    int                      nodeICount;    // no of nodes per interface element 
+   int                      threadCount;   // no of threads (--threads), 1: serial
 				 
 
    vector<Segment>          segment; // initial notches
@@ -85,6 +97,11 @@ struct Global
    bool                     isNeper;
 
    bool                     outAbaqus; // write to Abaqus input files
+   bool                     isParaviewZlib; // compress the ParaView file (needs zlib)
+   bool                     isInterfaceBinary; // binary interface file (InterfaceFile.h)
+   bool                     useMeshCache; // read/write the binary sidecar of the mesh file
+
+   string                   error; // why the run stopped (a builder returned false)
 
    double                   xMin;
    double                   xMax;
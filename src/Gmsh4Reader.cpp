@@ -0,0 +1,424 @@
+#include "Global.h"
+#include "GmshMeshBuilder.h"
+#include "MeshReader.h"
+#include "MappedFile.h"
+#include "TextScanner.h"
+
+/*
+ * 18 October 2026: reader of Gmsh MSH 4.1 files, ASCII and binary, so
+ * that meshes written by current Gmsh versions need not be converted
+ * to the legacy 2.2 format first. Typical (ASCII) file:
+ *
+ *      $MeshFormat
+ *      4.1 0 8
+ *      $EndMeshFormat
+ *      $PhysicalNames
+ *      2
+ *      1 4 "fixedPnts"
+ *      2 1 "elastic"
+ *      $EndPhysicalNames
+ *      $Entities
+ *      numPoints numCurves numSurfaces numVolumes
+ *      pointTag X Y Z numPhysicalTags physicalTag ...
+ *      curveTag minX minY minZ maxX maxY maxZ numPhysicalTags physicalTag ...
+ *               numBoundingPoints pointTag ...
+ *      ... (surfaces, volumes like curves)
+ *      $EndEntities
+ *      $Nodes
+ *      numEntityBlocks numNodes minNodeTag maxNodeTag
+ *      entityDim entityTag parametric numNodesInBlock
+ *      nodeTag
+ *      ...
+ *      x y z (u v w if parametric)
+ *      ...
+ *      $EndNodes
+ *      $Elements
+ *      numEntityBlocks numElements minElementTag maxElementTag
+ *      entityDim entityTag elementType numElementsInBlock
+ *      elementTag nodeTag ...
+ *      ...
+ *      $EndElements
+ *
+ * A binary file has the same layout without separators: int is 4 bytes,
+ * the counts and tags written as size_t take data-size (8) bytes. Node
+ * tags, coordinates and element blocks are copied in one go.
+ *
+ * The physical groups of an element are those of its entity and the
+ * entity tag plays the role of the geometrical entity of the 2.2
+ * format. As Gmsh does when saving in 2.2 format, an element whose
+ * entity belongs to several physical groups is given once per group
+ * to GmshMeshBuilder, so it is treated exactly as in a 2.2 file.
+ */
+
+// ------------------------------------------------------------
+//    invalidGmsh4File
+// ------------------------------------------------------------
+
+static void              invalidGmsh4File
+
+    ( const char* section )
+{
+  cout << "Invalid Gmsh mesh file: error in section $" << section << "!!!\n\n";
+  exit(1);
+}
+
+// =====================================================================
+//     class Gmsh4Stream
+// =====================================================================
+
+// reads the numbers of a section whether the file is ASCII or binary
+
+class Gmsh4Stream
+{
+  public:
+
+                     Gmsh4Stream
+
+      ( TextScanner&  scan,
+        bool          isBinary )
+
+      : scan_(scan), isBinary_(isBinary), section_("MeshFormat") {}
+
+    void             setSection  ( const char* name ) { section_ = name; }
+
+    int              getInt      ();
+    size_t           getSize     ();
+    double           getDouble   ();
+
+    void             getSizes    ( size_t* dest, size_t count );
+    void             getDoubles  ( double* dest, size_t count );
+
+  private:
+
+    void             fail_       () const { invalidGmsh4File ( section_ ); }
+
+  private:
+
+    TextScanner&     scan_;
+    bool             isBinary_;
+    const char*      section_;
+};
+
+int Gmsh4Stream::getInt ()
+{
+  int value = 0;
+
+  if ( !( isBinary_ ? scan_.readBytes ( &value, sizeof(int) )
+                    : scan_.readInt   (  value ) ) ) fail_ ();
+
+  return value;
+}
+
+size_t Gmsh4Stream::getSize ()
+{
+  size_t value = 0;
+
+  if ( !( isBinary_ ? scan_.readBytes ( &value, sizeof(size_t) )
+                    : scan_.readSize  (  value ) ) ) fail_ ();
+
+  return value;
+}
+
+double Gmsh4Stream::getDouble ()
+{
+  double value = 0.;
+
+  if ( !( isBinary_ ? scan_.readBytes  ( &value, sizeof(double) )
+                    : scan_.readDouble (  value ) ) ) fail_ ();
+
+  return value;
+}
+
+void Gmsh4Stream::getSizes ( size_t* dest, size_t count )
+{
+  if ( isBinary_ )
+  {
+    if ( !scan_.readBytes ( dest, count * sizeof(size_t) ) ) fail_ ();
+    return;
+  }
+
+  for ( size_t i = 0; i < count; i++ )
+  {
+    if ( !scan_.readSize ( dest[i] ) ) fail_ ();
+  }
+}
+
+void Gmsh4Stream::getDoubles ( double* dest, size_t count )
+{
+  if ( isBinary_ )
+  {
+    if ( !scan_.readBytes ( dest, count * sizeof(double) ) ) fail_ ();
+    return;
+  }
+
+  for ( size_t i = 0; i < count; i++ )
+  {
+    if ( !scan_.readDouble ( dest[i] ) ) fail_ ();
+  }
+}
+
+// =====================================================================
+//     readGmsh4Mesh
+// =====================================================================
+
+void                     readGmsh4Mesh
+
+    ( Global&        globdat,
+      const char*    fileName,
+      GmshMeshCache* cache )
+{
+  MappedFile      file;
+
+  if ( !file.open ( fileName ) )
+  {
+    cout << "Unable to open mesh file!!!\n\n";
+    exit(1);
+  }
+
+  TextScanner     scan ( file.begin(), file.end() );
+  GmshMeshBuilder builder ( globdat, cache );
+
+  int             fileType = 0, dataSize;
+  int             idx, dim;
+
+  double          version;
+
+  Int2IntVectMap  entityPhysical[4]; // (dim, entity tag) => physical tags
+
+  vector<size_t>  tags;
+  vector<double>  coords;
+  IntVector       connectivity;
+
+  string          section;
+  string          name;
+
+  bool            gotElements = false;
+
+  cout << "Reading Gmsh (MSH 4) mesh file ...\n";
+
+  if ( !scan.nextSection ( section ) || section != "MeshFormat" )
+  {
+    invalidGmsh4File ( "MeshFormat" );
+  }
+
+  if ( !scan.readDouble ( version  ) ||
+       !scan.readInt    ( fileType ) ||
+       !scan.readInt    ( dataSize ) ) invalidGmsh4File ( "MeshFormat" );
+
+  scan.skipLine ();
+
+  if ( version < 4.1 )
+  {
+    cout << "Only version 4.1 of the MSH 4 format is supported!!!\n\n";
+    exit(1);
+  }
+
+  if ( fileType == 1 )
+  {
+    int one = 0;
+
+    if ( dataSize != sizeof(size_t) )
+    {
+      cout << "Binary Gmsh file with data-size " << dataSize
+           << " is not supported!!!\n\n";
+      exit(1);
+    }
+
+    if ( !scan.readBytes ( &one, sizeof(int) ) ) invalidGmsh4File ( "MeshFormat" );
+
+    if ( one != 1 )
+    {
+      cout << "Binary Gmsh file written on a machine with other endianness!!!\n\n";
+      exit(1);
+    }
+
+    scan.skipLine ();
+  }
+
+  Gmsh4Stream     in ( scan, fileType == 1 );
+
+  while ( scan.nextSection ( section ) )
+  {
+    in.setSection ( section.c_str() );
+
+    if      ( section == "PhysicalNames" )
+    {
+      // always ASCII
+
+      cout << "Reading physical names...\n";
+
+      int namesCount;
+
+      if ( !scan.readInt ( namesCount ) ) invalidGmsh4File ( "PhysicalNames" );
+
+      scan.skipLine ();
+
+      for ( int i = 0; i < namesCount; i++ )
+      {
+        if ( !scan.readInt ( dim ) ||
+             !scan.readInt ( idx ) ) invalidGmsh4File ( "PhysicalNames" );
+
+        scan.readLine ( name );
+
+        builder.addPhysicalName ( idx, name );
+      }
+
+      cout << "Reading physical names...done!\n";
+    }
+    else if ( section == "Entities" )
+    {
+      size_t  entityCount[4];
+      double  box[6];
+
+      for ( int d = 0; d < 4; d++ ) entityCount[d] = in.getSize ();
+
+      for ( int d = 0; d < 4; d++ )
+      {
+        for ( size_t ie = 0; ie < entityCount[d]; ie++ )
+        {
+          const int tag = in.getInt ();
+
+          // a point has its coordinates, the others a bounding box
+
+          in.getDoubles ( box, d == 0 ? 3 : 6 );
+
+          const size_t physCount = in.getSize ();
+
+          IntVector&   physTags  = entityPhysical[d][tag];
+
+          for ( size_t ip = 0; ip < physCount; ip++ )
+          {
+            physTags.push_back ( in.getInt () );
+          }
+
+          if ( d > 0 )
+          {
+            const size_t bndCount = in.getSize ();
+
+            for ( size_t ib = 0; ib < bndCount; ib++ ) in.getInt ();
+          }
+        }
+      }
+    }
+    else if ( section == "Nodes" )
+    {
+      cout << "Reading nodes...\n";
+
+      const size_t blockCount = in.getSize ();
+      const size_t nodeCount  = in.getSize ();
+
+      in.getSize (); // min and max node tags
+      in.getSize ();
+
+      builder.reserveNodes ( nodeCount );
+
+      for ( size_t ib = 0; ib < blockCount; ib++ )
+      {
+        const int    entityDim  = in.getInt  ();
+                                  in.getInt  (); // entity tag
+        const int    parametric = in.getInt  ();
+        const size_t count      = in.getSize ();
+
+        // x y z followed by the parametric coordinates (if any)
+
+        const int    width      = parametric ? 3 + entityDim : 3;
+
+        tags  .resize ( count );
+        coords.resize ( count * width );
+
+        in.getSizes   ( tags.data (),   count );
+        in.getDoubles ( coords.data (), count * width );
+
+        const double* xyz = coords.data ();
+
+        for ( size_t i = 0; i < count; i++, xyz += width )
+        {
+          builder.addNode ( (int) tags[i], xyz[0], xyz[1], xyz[2] );
+        }
+      }
+
+      builder.endNodes ();
+    }
+    else if ( section == "Elements" )
+    {
+      cout << "Reading elements...\n";
+
+      const size_t blockCount = in.getSize ();
+      const size_t elemCount  = in.getSize ();
+
+      in.getSize (); // min and max element tags
+      in.getSize ();
+
+      builder.reserveElements ( elemCount );
+
+      int  ie = 0;
+
+      for ( size_t ib = 0; ib < blockCount; ib++ )
+      {
+        const int    entityDim = in.getInt  ();
+        const int    entityTag = in.getInt  ();
+        const int    elemType  = in.getInt  ();
+        const size_t count     = in.getSize ();
+
+        const int    nodeCount = GmshMeshBuilder::getNodeCount ( elemType );
+
+        if ( nodeCount == 0 )
+        {
+          cout << "Unsupported Gmsh element type " << elemType << "!!!\n\n";
+          exit(1);
+        }
+
+        if ( entityDim < 0 || entityDim > 3 ) invalidGmsh4File ( "Elements" );
+
+        // entity without physical group: matId = 0 (then the entity
+        // tag is used by the builder)
+
+        Int2IntVectMap::const_iterator it = entityPhysical[entityDim].find ( entityTag );
+
+        const IntVector  noPhysical ( 1, 0 );
+        const IntVector& matIds =
+
+          ( it == entityPhysical[entityDim].end () || it->second.empty () ) ?
+
+          noPhysical : it->second;
+
+        // element tag followed by its nodes
+
+        const int    width     = nodeCount + 1;
+
+        tags.resize ( count * width );
+
+        in.getSizes ( tags.data (), count * width );
+
+        connectivity.resize ( nodeCount );
+
+        for ( size_t i = 0; i < count; i++ )
+        {
+          const size_t* line = &tags[i * width + 1];
+
+          for ( int j = 0; j < nodeCount; j++ ) connectivity[j] = (int) line[j];
+
+          for ( size_t im = 0; im < matIds.size (); im++ )
+          {
+            builder.addElement ( ie++, elemType, matIds[im], entityTag,
+                                 connectivity.data (), nodeCount );
+          }
+        }
+      }
+
+      if ( !builder.endElements () ) exit(1);
+
+      gotElements = true;
+    }
+    else
+    {
+      // other sections (binary or not) are skipped as a whole
+
+      string endTag ( "$End" + section );
+
+      scan.setPosition ( scan.findLine ( endTag.c_str() ) );
+    }
+  }
+
+  if ( !gotElements ) invalidGmsh4File ( "Elements" );
+}
@@ -0,0 +1,438 @@
+#include "GmshMeshBuilder.h"
+#include "GmshMeshCache.h"
+#include "Global.h"
+#include "Node.h"
+#include "Element.h"
+
+/*
+ * The classification of the element lines follows the original Gmsh
+ * reader:
+ *
+ *  - 2-node and 3-node lines (type 1, 8) are boundary edges, they give
+ *    boundary nodes, node pairs and (converter) boundary elements.
+ *  - 1-node points (type 15) give boundary nodes only.
+ *  - in a 3D mesh, triangles and quadrangles (type 2, 9, 3, 16) are
+ *    boundary faces.
+ *  - everything else is a solid element.
+ *
+ * Neper meshes have matId = 0, the geometrical entity id is used instead.
+ */
+
+// ------------------------------------------------------------
+//    constructor
+// ------------------------------------------------------------
+
+GmshMeshBuilder::GmshMeshBuilder
+
+  ( Global&         globdat,
+    GmshMeshCache*  cache )
+
+  : globdat_(globdat), cache_(cache), bieCount_(0), lastConnCount_(0)
+{
+}
+
+// ------------------------------------------------------------
+//    addPhysicalName
+// ------------------------------------------------------------
+
+void GmshMeshBuilder::addPhysicalName
+
+  ( int            tag,
+    const string&  name )
+{
+  if ( cache_ ) cache_->addPhysicalName ( tag, name );
+
+  globdat_.physicalNames[tag] = name;
+}
+
+// ------------------------------------------------------------
+//    reserveNodes, reserveElements
+// ------------------------------------------------------------
+
+void GmshMeshBuilder::reserveNodes ( int count )
+{
+  const int total = globdat_.nodeSet.size () + count;
+
+  // Gmsh numbers the nodes 1...count (usually)
+
+  globdat_.nodeSet.reserve         ( total );
+  globdat_.nodeId2Position.reserve ( total );
+}
+
+void GmshMeshBuilder::reserveElements ( int count )
+{
+  const int total = globdat_.elemSet.size () + count;
+
+  // element ids are the positions of the element lines
+
+  globdat_.elemSet.reserve         ( total );
+  globdat_.elemId2Position.reserve ( total - 1 );
+  globdat_.elem2Domain.reserve     ( total - 1 );
+}
+
+// ------------------------------------------------------------
+//    addNode
+// ------------------------------------------------------------
+
+void GmshMeshBuilder::addNode
+
+  ( int     id,
+    double  x,
+    double  y,
+    double  z )
+{
+  if ( cache_ ) cache_->addNode ( id, x, y, z );
+
+  globdat_.nodeId2Position[id] = globdat_.nodeSet.addNode ( x, y, z, id );
+}
+
+// ------------------------------------------------------------
+//    endNodes
+// ------------------------------------------------------------
+
+void GmshMeshBuilder::endNodes ()
+{
+  const int     nodeCount = globdat_.nodeSet.size ();
+  const double* z         = globdat_.nodeSet.getZData ();
+
+  // checking two or three dimensional mesh
+
+  for ( int in = 0; in < nodeCount; in++ )
+  {
+    if ( z[in] != 0. )
+    {
+      globdat_.is3D = true;
+      break;
+    }
+  }
+
+  cout << "Reading nodes...done!\n\n";
+
+  globdat_.getBounds ();
+
+  cout << globdat_.xMin << " " << globdat_.xMax << endl;
+  cout << globdat_.yMin << " " << globdat_.yMax << endl;
+  cout << globdat_.zMin << " " << globdat_.zMax << endl;
+}
+
+// ------------------------------------------------------------
+//    addElement
+// ------------------------------------------------------------
+
+void GmshMeshBuilder::addElement
+
+  ( int         ie,
+    int         elemType,
+    int         matId,
+    int         geoId,
+    const int*  nodes,
+    int         nodeCount )
+{
+  Global&  globdat = globdat_;
+
+  if ( cache_ ) cache_->addElement ( elemType, matId, geoId, nodes, nodeCount );
+
+  // Neper mesh : matId = 0, then use geoId instead
+
+  if ( matId == 0 ) matId = geoId;
+
+  // line elements => boundary nodes
+  // elemType == 1: two-node   line element
+  // elemType == 8: three-node line element
+
+  if ( elemType == 1 )
+  {
+    int no1 = nodes[0];
+    int no2 = nodes[1];
+
+    // If the mesh was created with Neper, then there is a problem her
+    // The edges of the grains are written as well.
+    // And they are definitely not boundary edges.
+    // Need to remove them.
+
+    if ( globdat.isNeper )
+    {
+      double x1 = globdat.nodeSet.getX ( globdat.nodeId2Position[no1] );
+      double y1 = globdat.nodeSet.getY ( globdat.nodeId2Position[no1] );
+
+      double x2 = globdat.nodeSet.getX ( globdat.nodeId2Position[no2] );
+      double y2 = globdat.nodeSet.getY ( globdat.nodeId2Position[no2] );
+
+      bool xx1 = ( abs(x1-globdat.xMin) > 1e-12 ) && ( abs(x1-globdat.xMax) > 1e-12 );
+      bool yy1 = ( abs(y1-globdat.yMin) > 1e-12 ) && ( abs(y1-globdat.yMax) > 1e-12 );
+
+      bool xx2 = ( abs(x2-globdat.xMin) > 1e-12 ) && ( abs(x2-globdat.xMax) > 1e-12 );
+      bool yy2 = ( abs(y2-globdat.yMin) > 1e-12 ) && ( abs(y2-globdat.yMax) > 1e-12 );
+
+      if ( ( xx1 && yy1 ) || ( xx2 & yy2 ) )
+      {
+        return;
+      }
+    }
+
+    globdat.boundaryNodes.insert ( no1 );
+    globdat.boundaryNodes.insert ( no2 );
+
+    globdat.bndNodesMap[matId].insert ( no1 );
+    globdat.bndNodesMap[matId].insert ( no2 );
+
+    // only when this line element does not belong to
+    // the internal edges, then add nodepairs.
+    // because if you added nodepairs here no interface elements would be
+    // generated!!!
+
+    if ( globdat.internalEdges[0] != matId )
+    {
+      globdat.nodePairs     .push_back ( NodePair (no1, no2) );
+      globdat.bndElemsDomain.push_back ( matId );
+      //cout << matId << "\n";
+    }
+
+    if ( globdat.isConverter )
+    {
+      bndElemConn_.resize ( 2 );
+      bndElemConn_[0] = no1;
+      bndElemConn_[1] = no2;
+
+      globdat.bndElementSet.addElement ( bieCount_, elemType, bndElemConn_ );
+      globdat.dom2BndElems[matId].push_back ( bieCount_++ );
+    }
+
+    return;
+  }
+
+  // 3-node line elements
+
+  if ( elemType == 8 )
+  {
+    int no1 = nodes[0];
+    int no2 = nodes[1];
+    int no3 = nodes[2]; //midside node
+
+    globdat.boundaryNodes.insert ( no1 );
+    globdat.boundaryNodes.insert ( no2 );
+    globdat.boundaryNodes.insert ( no3 );
+
+    globdat.bndNodesMap[matId].insert ( no1 );
+    globdat.bndNodesMap[matId].insert ( no2 );
+    globdat.bndNodesMap[matId].insert ( no3 );
+
+    if ( globdat.internalEdges[0] != matId )
+    {
+      globdat.nodePairs     .push_back ( NodePair (no1, no2) );
+      globdat.bndElemsDomain.push_back ( matId );
+      //cout << matId << "\n";
+    }
+
+    if ( globdat.isConverter )
+    {
+      bndElemConn_.resize ( 3 );
+      bndElemConn_[0] = no1;
+      bndElemConn_[1] = no3;
+      bndElemConn_[2] = no2;
+
+      globdat.bndElementSet.addElement ( bieCount_, elemType, bndElemConn_ );
+      globdat.dom2BndElems[matId].push_back ( bieCount_++ );
+    }
+
+    return;
+  }
+
+  // node element
+
+  if ( elemType == 15 )
+  {
+    int no1 = nodes[0];
+
+    globdat.boundaryNodes.     insert ( no1 );
+    globdat.bndNodesMap[matId].insert ( no1 );
+
+    return;
+  }
+
+  connectivity_.assign ( nodes, nodes + nodeCount );
+
+  lastConnCount_ = nodeCount;
+
+  // for a 3D mesh, triangles or quadrangles are surface elements
+  // ie. they are boundary elements not bulk elements.
+
+  if ( globdat.is3D )
+  {
+    if ( elemType == 2 || elemType == 9 || // linear or quadratic triangle
+         elemType == 3 || elemType == 16 ) // linear or quadratic quadrangle
+    {
+      globdat.bndNodesMap[matId].insert ( connectivity_.begin(),
+                                          connectivity_.end() );
+      if ( globdat.isConverter ){
+        globdat.bndElementSet.addElement ( bieCount_, elemType, connectivity_ );
+        globdat.dom2BndElems[matId].push_back ( bieCount_++ );
+      }
+      return;
+    }
+  }
+
+  // material => elements
+  // element  => material (domain)
+
+  globdat.dom2Elems[matId].push_back ( ie );
+  globdat.elem2Domain[ie] = matId;
+
+  // the rest are solid elements
+  // either 2D solid elements or 3D solid elements
+
+  globdat.elemSet.addElement ( ie, elemType, connectivity_ );
+
+  globdat.elemId2Position[ie] = globdat.elemSet.size() - 1;
+}
+
+// ------------------------------------------------------------
+//    endElements
+// ------------------------------------------------------------
+
+bool GmshMeshBuilder::endElements ()
+{
+  Global&  globdat = globdat_;
+
+  cout << "Reading elements...done!\n";
+
+  // check validity of input
+
+  if ( globdat.isDomain )
+  {
+    Int2IntVectMap::const_iterator it;
+    Int2IntVectMap::const_iterator eit = globdat.dom2Elems.end   ();
+
+    it = globdat.dom2Elems.find ( globdat.rigidDomain[0] );
+
+    if ( it == eit )
+    {
+      cerr << "invalid number of rigid domain!!!\n";
+      globdat.error = "invalid number of rigid domain";
+      return false;
+    }
+  }
+
+  if ( globdat.isNotch )
+  {
+    cout << "Existing notch segment is: " << globdat.segment[0] << endl;
+  }
+
+  if ( globdat.isIgSegment )
+  {
+    cout << "Do not treat nodes on this segment: "<< globdat.ignoredSegment << endl;
+  }
+
+  cout << endl;
+
+  globdat.nodeElemCount = lastConnCount_;
+
+  string elemTypeStr = "linear";
+
+  if ( globdat.elemSet.size() == 0 )
+  {
+    cout << "There is no solid elements defined!!!\n";
+    cout << "Please double check your input mesh.\n";
+    globdat.error = "no solid elements defined";
+    return false;
+  }
+
+  int elemType = globdat.elemSet[0]->getElemType ();
+
+  if ( !globdat.is3D )
+  {
+    if ( elemType == 2 || elemType == 3 )
+    {
+      globdat.nodeICount  = globdat.isContinuum ? 4 : 2;
+      globdat.isQuadratic = false;
+      elemTypeStr         = "linear";
+    }
+    else
+    {
+      globdat.nodeICount  = 6;
+      globdat.isQuadratic = true;
+      elemTypeStr         = "quadratic";
+    }
+  }
+  else
+  {
+    // hex8 or tet4 elements
+    if ( elemType == 4 || elemType == 5 )
+    {
+      globdat.nodeICount  = elemType == 4 ? 6 : 8;
+      globdat.isQuadratic = false;
+      elemTypeStr = "linear";
+    }
+    // hex20 or tet10 elements
+    else
+    {
+      globdat.nodeICount  = elemType == 11 ? 12 : 16;
+      globdat.isQuadratic = true;
+      elemTypeStr = "quadratic";
+    }
+
+    // build faces for 3D elements
+
+    cout << "Building initial faces of 3D elements...\n\n";
+
+    for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
+    {
+      globdat.elemSet[ie]->buildFaces0 ();
+    }
+    cout << "Building initial faces of 3D elements...done\n\n";
+  }
+
+  // check boundary elements of a 3D mesh to see whether zero area elements
+  // exist
+
+  if ( globdat.is3D )
+  {
+    const int bndElemCount = globdat.bndElementSet.size();
+
+    IntVector connect, copy;
+
+    for ( int ie = 0; ie < bndElemCount; ie++ )
+    {
+      globdat.bndElementSet[ie]->getJemConnectivity ( connect );
+
+      copy = connect;
+
+      std::sort ( copy.begin (), copy.end () );
+      auto last = std::unique ( copy.begin(), copy.end() );
+      copy.erase ( last, copy.end() );
+
+      if ( copy.size() != connect.size () ){
+        print ( connect.begin(), connect.end() );
+        globdat.error = "boundary element with repeated nodes";
+        return false;
+      }
+    }
+  }
+
+  cout << "Check validity of input...done!\n\n";
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    getNodeCount
+// ------------------------------------------------------------
+
+int GmshMeshBuilder::getNodeCount ( int elemType )
+{
+  // Gmsh element types 1 to 31 (see the Gmsh reference manual)
+
+  static const int nodeCounts[] =
+  {
+     0,  2,  3,  4,  4,  8,  6,  5,  3,  6,
+     9, 10, 27, 18, 14,  1,  8, 20, 15, 13,
+     9, 10, 12, 15, 15, 21,  4,  5,  6, 20,
+    35, 56
+  };
+
+  const int typeCount = sizeof(nodeCounts) / sizeof(nodeCounts[0]);
+
+  if ( elemType > 0 && elemType < typeCount ) return nodeCounts[elemType];
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * GmshMeshBuilder fills the global data from the entities of a Gmsh
+ * mesh file. The readers only decode the file (text, binary, MSH2 or
+ * MSH4) and hand nodes and element lines to this class, so that all
+ * formats classify elements (bulk, boundary, points) the same way.
+ */
+
+#ifndef GMSH_MESH_BUILDER_H
+#define GMSH_MESH_BUILDER_H
+
+#include "typedefs.h"
+
+struct Global;
+class  GmshMeshCache;
+
+// =====================================================================
+//     class GmshMeshBuilder
+// =====================================================================
+
+class GmshMeshBuilder
+{
+  public:
+
+    // if cache is given, all entities are also recorded in it
+
+    explicit             GmshMeshBuilder
+
+      ( Global&          globdat,
+        GmshMeshCache*   cache = 0 );
+
+    void                 addPhysicalName
+
+      ( int              tag,
+        const string&    name );
+
+    void                 reserveNodes    ( int count );
+    void                 reserveElements ( int count );
+
+    void                 addNode
+
+      ( int              id,
+        double           x,
+        double           y,
+        double           z );
+
+    // detect 2D/3D and compute the bounding box (needed by
+    // the Neper filter applied to the boundary elements)
+
+    void                 endNodes        ();
+
+    // an element line of the Gmsh file: ie is the position of
+    // the line in the $Elements section (used as element index)
+
+    void                 addElement
+
+      ( int              ie,
+        int              elemType,
+        int              matId,
+        int              geoId,
+        const int*       nodes,
+        int              nodeCount );
+
+    // check the input, set the interface element type and
+    // build the initial faces of 3D elements. false (and
+    // globdat.error) if the mesh cannot be used
+
+    bool                 endElements     ();
+
+    // number of nodes of a Gmsh element type, 0 if unknown
+    // (binary files do not store it)
+
+    static int           getNodeCount    ( int elemType );
+
+  private:
+
+    Global&              globdat_;
+    GmshMeshCache*       cache_;
+
+    int                  bieCount_;      // # boundary elements
+    int                  lastConnCount_; // # nodes of last solid/surface element
+
+    IntVector            connectivity_;
+    IntVector            bndElemConn_;
+};
+
+#endif
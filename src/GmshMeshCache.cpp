@@ -0,0 +1,406 @@
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+#include "GmshMeshCache.h"
+#include "GmshMeshBuilder.h"
+#include "TextScanner.h"
+
+/*
+ * Layout of the sidecar (native byte order, it is only meant to be
+ * read on the machine that wrote it):
+ *
+ *   magic "CIGENMC2"
+ *   key   : file size, modification time, hash (3 x 8 bytes)
+ *   counts: names, nodes, element lines, connectivity (4 x 8 bytes)
+ *   names : tag (int), length (int), characters
+ *   nodes : ids (int), then x y z (double) per node
+ *   elems : elemType matId geoId #nodes (int) per line, then the nodes
+ *
+ * The names and the node ids are padded to a multiple of 8 bytes, so
+ * that the arrays can be used in place in the mapped file.
+ */
+
+static const char  CACHE_MAGIC[8] = { 'C','I','G','E','N','M','C','2' };
+
+// ------------------------------------------------------------
+//    padding
+// ------------------------------------------------------------
+
+// bytes after offset up to the next multiple of 8
+
+static size_t                padding ( size_t offset )
+{
+  return ( 8 - offset % 8 ) % 8;
+}
+
+// ------------------------------------------------------------
+//    hashBytes
+// ------------------------------------------------------------
+
+// FNV-1a, eight bytes at a time
+
+static unsigned long long    hashBytes
+
+    ( const char* data,
+      size_t      size )
+{
+  const unsigned long long prime = 1099511628211ULL;
+
+  unsigned long long       hash  = 14695981039346656037ULL;
+  unsigned long long       word;
+
+  size_t                   i     = 0;
+
+  for ( ; i + 8 <= size; i += 8 )
+  {
+    memcpy ( &word, data + i, 8 );
+
+    hash = ( hash ^ word ) * prime;
+  }
+
+  for ( ; i < size; i++ )
+  {
+    hash = ( hash ^ (unsigned char) data[i] ) * prime;
+  }
+
+  return hash;
+}
+
+// ------------------------------------------------------------
+//    constructor
+// ------------------------------------------------------------
+
+GmshMeshCache::GmshMeshCache ( const char* meshFile )
+
+  : meshFile_(meshFile), cacheFile_(string(meshFile) + ".cache")
+{
+  clear_ ();
+}
+
+// ------------------------------------------------------------
+//    computeKey_
+// ------------------------------------------------------------
+
+bool GmshMeshCache::computeKey_
+
+  ( Key&  key,
+    bool  withHash ) const
+
+{
+  struct stat st;
+
+  if ( stat ( meshFile_.c_str(), &st ) != 0 ) return false;
+
+  key.fileSize   = st.st_size;
+
+#if defined(__APPLE__)
+  key.modifyTime = st.st_mtimespec.tv_sec * 1000000000ULL + st.st_mtimespec.tv_nsec;
+#else
+  key.modifyTime = st.st_mtim.tv_sec      * 1000000000ULL + st.st_mtim.tv_nsec;
+#endif
+
+  key.hash       = 0;
+
+  if ( !withHash ) return true;
+
+  MappedFile file;
+
+  if ( !file.open ( meshFile_.c_str() ) ) return false;
+
+  key.hash = hashBytes ( file.begin(), file.size() );
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    load
+// ------------------------------------------------------------
+
+bool GmshMeshCache::load ()
+{
+  if ( load_ () ) return true;
+
+  // a partly read sidecar must not end up in the recorded one
+
+  clear_ ();
+
+  return false;
+}
+
+// ------------------------------------------------------------
+//    load_
+// ------------------------------------------------------------
+
+bool GmshMeshCache::load_ ()
+{
+  Key                 key, cached;
+  char                magic[8];
+  unsigned long long  counts[4];
+
+  clear_ ();
+
+  if ( !file_.open ( cacheFile_.c_str() ) ) return false;
+
+  TextScanner         in ( file_.begin(), file_.end() );
+
+  if ( !in.readBytes ( magic,   sizeof(magic)  ) ||
+       !in.readBytes ( &cached, sizeof(cached) ) ||
+       !in.readBytes ( counts,  sizeof(counts) ) ) return false;
+
+  if ( memcmp ( magic, CACHE_MAGIC, sizeof(magic) ) != 0 ) return false;
+
+  // cheap checks first, the hash reads the whole mesh file and is
+  // only needed when the modification time differs
+
+  struct stat st;
+
+  if ( stat ( meshFile_.c_str(), &st ) != 0 ||
+       (unsigned long long) st.st_size != cached.fileSize ) return false;
+
+  if ( !computeKey_ ( key, false ) ) return false;
+
+  if ( key.modifyTime != cached.modifyTime )
+  {
+    if ( !computeKey_ ( key, true ) || key.hash != cached.hash ) return false;
+  }
+
+  // the counts must fit in the file before anything is allocated
+
+  const unsigned long long left = file_.end() - in.position();
+
+  if ( counts[0] > left || counts[1] > left || counts[2] > left || counts[3] > left ||
+       counts[1] * ( sizeof(int) + 3 * sizeof(double) ) +
+       counts[2] * 4 * sizeof(int) + counts[3] * sizeof(int) > left ) return false;
+
+  for ( size_t i = 0; i < counts[0]; i++ )
+  {
+    int tag;
+    int length;
+
+    if ( !in.readBytes ( &tag,    sizeof(int) ) ||
+         !in.readBytes ( &length, sizeof(int) ) ||
+         length < 0 || length > file_.end() - in.position() ) return false;
+
+    nameTags_.push_back ( tag );
+    names_   .push_back ( string ( in.position(), length ) );
+
+    in.setPosition ( in.position() + length );
+  }
+
+  // the arrays, in place
+
+  const char*  data = in.position ();
+  const char*  end  = file_.end   ();
+
+  data += padding ( data - file_.begin() );
+
+  nodeIdData_   = reinterpret_cast<const int*>    ( data );
+  data         += counts[1] * sizeof(int);
+  data         += padding ( data - file_.begin() );
+
+  coordData_    = reinterpret_cast<const double*> ( data );
+  data         += counts[1] * 3 * sizeof(double);
+
+  lineData_     = reinterpret_cast<const int*>    ( data );
+  data         += counts[2] * 4 * sizeof(int);
+
+  elemNodeData_ = reinterpret_cast<const int*>    ( data );
+  data         += counts[3] * sizeof(int);
+
+  if ( data < in.position () || data > end ) return false;
+
+  // the node counts of the element lines must add up to the
+  // connectivity, replay walks through it with them
+
+  unsigned long long  connCount = 0;
+
+  for ( size_t il = 0; il < counts[2]; il++ )
+  {
+    const int nodeCount = lineData_[4*il+3];
+
+    if ( nodeCount < 0 ) return false;
+
+    connCount += nodeCount;
+  }
+
+  if ( connCount != counts[3] ) return false;
+
+  nodeCount_ = counts[1];
+  lineCount_ = counts[2];
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    clear_
+// ------------------------------------------------------------
+
+void GmshMeshCache::clear_ ()
+{
+  nameTags_ .clear ();
+  names_    .clear ();
+  nodeIds_  .clear ();
+  coords_   .clear ();
+  elemLines_.clear ();
+  elemNodes_.clear ();
+
+  file_.close ();
+
+  nodeCount_    = 0;
+  lineCount_    = 0;
+  nodeIdData_   = 0;
+  coordData_    = 0;
+  lineData_     = 0;
+  elemNodeData_ = 0;
+}
+
+// ------------------------------------------------------------
+//    save
+// ------------------------------------------------------------
+
+bool GmshMeshCache::save () const
+{
+  Key                 key;
+  unsigned long long  counts[4];
+
+  if ( !computeKey_ ( key, true ) ) return false;
+
+  counts[0] = names_    .size ();
+  counts[1] = nodeIds_  .size ();
+  counts[2] = elemLines_.size () / 4;
+  counts[3] = elemNodes_.size ();
+
+  // write to a temporary file first so that a crash does not leave
+  // a truncated sidecar behind
+
+  const string  tmpFile = cacheFile_ + ".tmp";
+
+  ofstream      out ( tmpFile.c_str(), std::ios::out | std::ios::binary );
+
+  if ( !out ) return false;
+
+  out.write ( CACHE_MAGIC,                   sizeof(CACHE_MAGIC) );
+  out.write ( (const char*) &key,            sizeof(key)         );
+  out.write ( (const char*) counts,          sizeof(counts)      );
+
+  const char    zeros[8] = { 0 };
+  size_t        offset   = sizeof(CACHE_MAGIC) + sizeof(key) + sizeof(counts);
+
+  for ( size_t i = 0; i < names_.size (); i++ )
+  {
+    const int length = names_[i].size ();
+
+    out.write ( (const char*) &nameTags_[i], sizeof(int) );
+    out.write ( (const char*) &length,       sizeof(int) );
+    out.write ( names_[i].data (),           length      );
+
+    offset += 2 * sizeof(int) + length;
+  }
+
+  out.write ( zeros, padding ( offset ) );
+
+  offset += padding ( offset ) + nodeIds_.size() * sizeof(int);
+
+  out.write ( (const char*) nodeIds_.data(),   nodeIds_.size()   * sizeof(int)    );
+  out.write ( zeros, padding ( offset ) );
+  out.write ( (const char*) coords_.data(),    coords_.size()    * sizeof(double) );
+  out.write ( (const char*) elemLines_.data(), elemLines_.size() * sizeof(int)    );
+  out.write ( (const char*) elemNodes_.data(), elemNodes_.size() * sizeof(int)    );
+
+  out.close ();
+
+  if ( !out || std::rename ( tmpFile.c_str(), cacheFile_.c_str() ) != 0 )
+  {
+    std::remove ( tmpFile.c_str() );
+    return false;
+  }
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    replay
+// ------------------------------------------------------------
+
+void GmshMeshCache::replay ( Global& globdat ) const
+{
+  GmshMeshBuilder  builder ( globdat );
+
+  for ( size_t i = 0; i < names_.size (); i++ )
+  {
+    builder.addPhysicalName ( nameTags_[i], names_[i] );
+  }
+
+  cout << "Reading nodes...\n";
+
+  builder.reserveNodes ( nodeCount_ );
+
+  for ( size_t in = 0; in < nodeCount_; in++ )
+  {
+    const double* xyz = coordData_ + 3 * in;
+
+    builder.addNode ( nodeIdData_[in], xyz[0], xyz[1], xyz[2] );
+  }
+
+  builder.endNodes ();
+
+  cout << "Reading elements...\n";
+
+  builder.reserveElements ( lineCount_ );
+
+  const int* nodes = elemNodeData_;
+
+  for ( size_t il = 0; il < lineCount_; il++ )
+  {
+    const int* line = lineData_ + 4 * il;
+
+    builder.addElement ( il, line[0], line[1], line[2], nodes, line[3] );
+
+    nodes += line[3];
+  }
+
+  if ( !builder.endElements () ) exit(1);
+}
+
+// ------------------------------------------------------------
+//    addPhysicalName, addNode, addElement
+// ------------------------------------------------------------
+
+void GmshMeshCache::addPhysicalName
+
+  ( int            tag,
+    const string&  name )
+{
+  nameTags_.push_back ( tag  );
+  names_   .push_back ( name );
+}
+
+void GmshMeshCache::addNode
+
+  ( int     id,
+    double  x,
+    double  y,
+    double  z )
+{
+  nodeIds_.push_back ( id );
+  coords_ .push_back ( x  );
+  coords_ .push_back ( y  );
+  coords_ .push_back ( z  );
+}
+
+void GmshMeshCache::addElement
+
+  ( int         elemType,
+    int         matId,
+    int         geoId,
+    const int*  nodes,
+    int         nodeCount )
+{
+  elemLines_.push_back ( elemType  );
+  elemLines_.push_back ( matId     );
+  elemLines_.push_back ( geoId     );
+  elemLines_.push_back ( nodeCount );
+
+  elemNodes_.insert ( elemNodes_.end(), nodes, nodes + nodeCount );
+}
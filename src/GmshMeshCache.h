@@ -0,0 +1,118 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * GmshMeshCache keeps what the Gmsh readers decoded from a mesh file
+ * (physical names, nodes and element lines) in a binary sidecar file
+ * next to the mesh (mesh.msh.cache). The sidecar is valid as long as
+ * the size, the modification time and a hash of the contents of the
+ * mesh file are unchanged; the hash is only computed when the time
+ * differs (a copied or touched file). Loading maps the sidecar and
+ * gives its arrays in place to GmshMeshBuilder, so the global data is
+ * the same as when the mesh file is read, whatever the options.
+ */
+
+#ifndef GMSH_MESH_CACHE_H
+#define GMSH_MESH_CACHE_H
+
+#include "typedefs.h"
+#include "MappedFile.h"
+
+struct Global;
+class  GmshMeshBuilder;
+
+// =====================================================================
+//     class GmshMeshCache
+// =====================================================================
+
+class GmshMeshCache
+{
+  public:
+
+    explicit             GmshMeshCache
+
+      ( const char*      meshFile );
+
+    // true if the sidecar exists, is valid and matches the mesh file;
+    // otherwise nothing is kept (the cache can record the mesh)
+
+    bool                 load            ();
+
+    // write the recorded entities to the sidecar
+
+    bool                 save            () const;
+
+    // give the loaded entities to a mesh builder
+
+    void                 replay          ( Global& globdat ) const;
+
+    // recording (called by GmshMeshBuilder while a file is read)
+
+    void                 addPhysicalName
+
+      ( int              tag,
+        const string&    name );
+
+    void                 addNode
+
+      ( int              id,
+        double           x,
+        double           y,
+        double           z );
+
+    void                 addElement
+
+      ( int              elemType,
+        int              matId,
+        int              geoId,
+        const int*       nodes,
+        int              nodeCount );
+
+    const string&        getFileName     () const { return cacheFile_; }
+
+  private:
+
+    struct               Key
+    {
+      unsigned long long fileSize;
+      unsigned long long modifyTime;  // ns
+      unsigned long long hash;
+    };
+
+    // the hash (which reads the whole mesh file) only if withHash
+
+    bool                 computeKey_     ( Key& key, bool withHash ) const;
+    bool                 load_           ();
+    void                 clear_          ();
+
+  private:
+
+                         GmshMeshCache   ( const GmshMeshCache& );
+    GmshMeshCache&       operator =      ( const GmshMeshCache& );
+
+  private:
+
+    string               meshFile_;
+    string               cacheFile_;
+
+    IntVector            nameTags_;
+    StrVector            names_;
+
+    IntVector            nodeIds_;
+    vector<double>       coords_;      // x y z per node
+
+    IntVector            elemLines_;   // elemType matId geoId #nodes
+    IntVector            elemNodes_;
+
+    // loaded sidecar: the arrays point into the mapped file
+
+    MappedFile           file_;
+
+    size_t               nodeCount_;
+    size_t               lineCount_;
+    const int*           nodeIdData_;
+    const double*        coordData_;
+    const int*           lineData_;
+    const int*           elemNodeData_;
+};
+
+#endif
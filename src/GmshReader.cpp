@@ -1,10 +1,9 @@
 #include "Global.h"
-#include "Node.h"
-#include "Element.h"
-
-
-#include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
+#include "GmshMeshBuilder.h"
+#include "MeshReader.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "TextScanner.h"
 
 /*
  * 8 October 2014: when isConverted == true, write
@@ -70,7 +69,8 @@
  * Unfortunately, the information at column 4 (0 is the fitrst column) was not
  * used in the code. It is the geometrical entity ID.
  *
- * Support only 2.2 0 8 Gmsh ASCII format
+ * Support 2.2 0 8 Gmsh ASCII and 2.2 1 8 binary formats (MSH 4.1: see
+ * Gmsh4Reader.cpp)
  */
 
 /*
@@ -82,432 +82,597 @@
     Not back compatible with old msh files where physical groups are labeled by integers!!!            
  */
 
-void                     readGmshMesh 
+/*
+ * 18 October 2026: the mesh file is memory mapped and scanned in place.
+ * Numbers are converted with std::from_chars straight into the node and
+ * element containers (no getline/split/lexical_cast per line), and the
+ * containers are reserved from the counts in the section headers.
+ * Sections are located by name, so $PhysicalNames is optional and
+ * unknown sections are skipped. Lines with more than two tags are read
+ * correctly (first tag: physical group, second: geometrical entity).
+ * The classification of element lines lives in GmshMeshBuilder.
+ * Binary 2.2 files are read block by block: one copy for all nodes and
+ * one per block of elements of the same type, the connectivity is
+ * passed to GmshMeshBuilder straight from the copied block.
+ * With --threads N the $Nodes and $Elements sections are cut into N
+ * line-aligned chunks which are parsed concurrently into per chunk
+ * buffers; the buffers are then handed to GmshMeshBuilder in file
+ * order, so the mesh is exactly the one read by a single thread.
+ */
+
+// ------------------------------------------------------------
+//    invalidGmshFile
+// ------------------------------------------------------------
 
-    ( Global&     globdat,
-      const char* fileName )
+static void              invalidGmshFile
+
+    ( const char* section )
 {
-  ifstream file ( fileName, std::ios::in );
+  cout << "Invalid Gmsh mesh file: error in section $" << section << "!!!\n\n";
+  exit(1);
+}
 
-  if ( !file ) 
-  {
-    cout << "Unable to open mesh file!!!\n\n";
-    exit(1);
-  }
+// ------------------------------------------------------------
+//    readElementLine
+// ------------------------------------------------------------
 
-  int             id, idx;
-  int             length;
-  int             matId;
-  int             geoId;    // geometrical entity id (Neper uses this)
-  int             elemType, paraElemType;
-  int             bieCount(0);
+// one line of $Elements: the element number is not used, the nodes
+// are appended to connectivity. Return false for an invalid line.
 
-  double          x,y,z;
-  double          x1,y1,z1;
-  double          x2,y2,z2;
+static inline bool       readElementLine
 
-  StrVector       splitLine;
-  IntVector       connectivity;
-  IntVector       bndElemConn;
+    ( TextScanner& scan,
+      int&         elemType,
+      int&         matId,
+      int&         geoId,
+      IntVector&   connectivity )
+{
+  int  id, tagCount, tag;
 
-  string          line;
-  string          name;
+  if ( !scan.readInt ( id       ) ||
+       !scan.readInt ( elemType ) ||
+       !scan.readInt ( tagCount ) ) return false;
 
-  cout << "Reading Gmsh mesh file ...\n";
-  cout << "Reading physical names...\n";
+  matId = geoId = 0;
+
+  for ( int it = 0; it < tagCount; it++ )
+  {
+    if ( !scan.readInt ( tag ) ) return false;
 
-  getline ( file, line );
-  getline ( file, line );
-  getline ( file, line );
-  getline ( file, line );
+    if      ( it == 0 ) matId = tag;
+    else if ( it == 1 ) geoId = tag;
+  }
 
-  getline ( file, line );
+  // the rest of the line is the connectivity
 
-  const int namesCount = boost::lexical_cast<int> ( line );
+  const size_t first = connectivity.size ();
 
-  for ( int in = 0; in < namesCount; in++ )
+  while ( !scan.atEndOfLine () )
   {
-    file >> id >> idx >> name;
-    //getline ( file, line );
-    //cout << line << "\n";
-    globdat.physicalNames[idx] = name;
-    //cout << name << "\n";
+    if ( !scan.readInt ( id ) ) return false;
+
+    connectivity.push_back ( id );
   }
 
-  cout << "Reading physical names...done!\n";
+  scan.skipLine ();
 
+  return connectivity.size () > first;
+}
 
-  cout << "Reading nodes...\n";
+// ------------------------------------------------------------
+//    splitLines
+// ------------------------------------------------------------
 
-  getline ( file, line );
-  getline ( file, line );
-  getline ( file, line );
-  getline ( file, line );
-  
+// cut [first,last) in chunkCount pieces of about the same size,
+// every piece (but the first) starts at the beginning of a line
 
-  const int nodeCount = boost::lexical_cast<int> ( line );
+static void              splitLines
 
-  for ( int in = 0; in < nodeCount; in++ )
-  {
-    file >> id >> x >> y >> z;
+    ( vector<const char*>& bounds,
+      const char*          first,
+      const char*          last,
+      int                  chunkCount )
+{
+  bounds.resize ( chunkCount + 1 );
 
-    globdat.nodeSet.push_back ( NodePointer( new Node(x,y,z,id) ) );
+  bounds[0]          = first;
+  bounds[chunkCount] = last;
 
-    globdat.nodeId2Position[id] = globdat.nodeSet.size()-1;
-  }
+  for ( int ic = 1; ic < chunkCount; ic++ )
+  {
+    const char* pos = first + ( last - first ) * ic / chunkCount;
 
-  // checking two or three dimensional mesh
+    if ( pos < bounds[ic-1] ) pos = bounds[ic-1];
 
-  for ( int in = 0; in < nodeCount; in++ )
-  {
-    if ( globdat.nodeSet[in]->getZ() != 0. )
+    if ( pos > first && pos[-1] != '\n' )
     {
-      globdat.is3D = true;
-      break;
+      const char* nl = static_cast<const char*>
+
+        ( memchr ( pos, '\n', last - pos ) );
+
+      pos = nl ? nl + 1 : last;
     }
+
+    bounds[ic] = pos;
   }
+}
 
-  cout << "Reading nodes...done!\n\n";
-          
-  globdat.getBounds ();
+// ------------------------------------------------------------
+//    readNodesParallel
+// ------------------------------------------------------------
 
-  cout << globdat.xMin << " " << globdat.xMax << endl;
-  cout << globdat.yMin << " " << globdat.yMax << endl;
-  cout << globdat.zMin << " " << globdat.zMax << endl;
+struct NodeChunk
+{
+  IntVector        ids;
+  vector<double>   coords;
+  bool             isValid;
+};
 
-  cout << "Reading elements...\n";
+static void              readNodesParallel
 
-  getline ( file, line );
-  getline ( file, line );
-  getline ( file, line );
+    ( TextScanner&      scan,
+      GmshMeshBuilder&  builder,
+      int               nodeCount,
+      int               threadCount )
+{
+  const char*          first = scan.position ();
+  const char*          last  = scan.findLine ( "$EndNodes" );
 
-  getline ( file, line ); // -> reading the line containing the number of elements
+  vector<const char*>  bounds;
+  vector<NodeChunk>    chunks ( threadCount );
 
-  const int elemCount = boost::lexical_cast<int> ( line );
+  splitLines ( bounds, first, last, threadCount );
 
-  for ( int ie = 0; ie < elemCount; ie++ )
+  parallelFor ( threadCount, threadCount, [&] ( int ic )
   {
-    getline ( file, line );
+    TextScanner  s     ( bounds[ic], bounds[ic+1] );
+    NodeChunk&   chunk = chunks[ic];
 
-    boost::split ( splitLine, line, boost::is_any_of("\t ") );
+    int          id;
+    double       x, y, z;
 
-    length       = splitLine.size ();
+    chunk.isValid = true;
 
-    elemType     = boost::lexical_cast<int> ( splitLine[1] );
-    matId        = boost::lexical_cast<int> ( splitLine[3] );	
-    geoId        = boost::lexical_cast<int> ( splitLine[4] );	
+    while ( true )
+    {
+      s.skipSpaces ();
 
-    // Neper mesh : matId = 0, then use geoId instead
+      if ( s.atEnd () ) break;
 
-    //cout << matId << " " << geoId << endl;
-    if ( matId == 0 ) matId = geoId;
+      if ( !s.readInt    ( id ) ||
+           !s.readDouble ( x  ) ||
+           !s.readDouble ( y  ) ||
+           !s.readDouble ( z  ) )
+      {
+        chunk.isValid = false;
+        break;
+      }
 
-    // line elements => boundary nodes
-    // elemType == 1: two-node   line element
-    // elemType == 8: three-node line element
+      s.skipLine ();
 
-    if ( elemType == 1 ) 
-    {
-      int no1 = boost::lexical_cast<int> ( splitLine[5] );
-      int no2 = boost::lexical_cast<int> ( splitLine[6] );
+      chunk.ids.push_back ( id );
+      chunk.coords.push_back ( x );
+      chunk.coords.push_back ( y );
+      chunk.coords.push_back ( z );
+    }
+  } );
 
-      // If the mesh was created with Neper, then there is a problem her
-      // The edges of the grains are written as well.
-      // And they are definitely not boundary edges. 
-      // Need to remove them.
+  int  count = 0;
 
-      if ( globdat.isNeper )
-      {
-        x1 = globdat.nodeSet[globdat.nodeId2Position[no1]]->getX ( );     
-        y1 = globdat.nodeSet[globdat.nodeId2Position[no1]]->getY ( );     
+  for ( int ic = 0; ic < threadCount; ic++ )
+  {
+    if ( !chunks[ic].isValid ) invalidGmshFile ( "Nodes" );
 
-        x2 = globdat.nodeSet[globdat.nodeId2Position[no2]]->getX ( );     
-        y2 = globdat.nodeSet[globdat.nodeId2Position[no2]]->getY ( );     
-        
-        bool xx1 = ( abs(x1-globdat.xMin) > 1e-12 ) && ( abs(x1-globdat.xMax) > 1e-12 ); 
-        bool yy1 = ( abs(y1-globdat.yMin) > 1e-12 ) && ( abs(y1-globdat.yMax) > 1e-12 ); 
+    count += chunks[ic].ids.size ();
+  }
 
-        bool xx2 = ( abs(x2-globdat.xMin) > 1e-12 ) && ( abs(x2-globdat.xMax) > 1e-12 ); 
-        bool yy2 = ( abs(y2-globdat.yMin) > 1e-12 ) && ( abs(y2-globdat.yMax) > 1e-12 ); 
+  if ( count != nodeCount ) invalidGmshFile ( "Nodes" );
 
-        if ( ( xx1 && yy1 ) || ( xx2 & yy2 ) )
-        {
-          //cout << x1 << " " << y1 << " " << x2 << " " << y2 << endl;
-          //cout << "One wrong boundary edge detected.\n\n";  
-          continue;
-        }
-      }
+  // merge in file order
 
-      globdat.boundaryNodes.insert ( no1 );
-      globdat.boundaryNodes.insert ( no2 );
+  for ( int ic = 0; ic < threadCount; ic++ )
+  {
+    const NodeChunk&  chunk = chunks[ic];
+    const double*     xyz   = chunk.coords.data ();
 
-      globdat.bndNodesMap[matId].insert ( no1 );
-      globdat.bndNodesMap[matId].insert ( no2 );
+    for ( size_t in = 0; in < chunk.ids.size (); in++, xyz += 3 )
+    {
+      builder.addNode ( chunk.ids[in], xyz[0], xyz[1], xyz[2] );
+    }
 
-      // only when this line element does not belong to
-      // the internal edges, then add nodepairs.
-      // because if you added nodepairs here no interface elements would be
-      // generated!!!
-      
+    chunks[ic] = NodeChunk ();
+  }
 
-      if ( globdat.internalEdges[0] != matId )
-      {
-        globdat.nodePairs     .push_back ( NodePair (no1, no2) );
-        globdat.bndElemsDomain.push_back ( matId );
-        cout << matId << "\n";
-      }
+  scan.setPosition ( last );
+}
 
+// ------------------------------------------------------------
+//    readElementsParallel
+// ------------------------------------------------------------
 
-      if ( globdat.isConverter )
-      {
-          bndElemConn.resize ( 2 );
-          bndElemConn[0] = no1;
-          bndElemConn[1] = no2;
-    
-          globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount, elemType, bndElemConn ) ) );
-          globdat.dom2BndElems[matId].push_back ( bieCount++ );
-      }
+struct ElemChunk
+{
+  IntVector        lines;    // elemType, matId, geoId, #nodes per line
+  IntVector        nodes;    // connectivity of all lines
+  bool             isValid;
+};
 
-      continue;
-    }
+static void              readElementsParallel
+
+    ( TextScanner&      scan,
+      GmshMeshBuilder&  builder,
+      int               elemCount,
+      int               threadCount )
+{
+  const char*          first = scan.position ();
+  const char*          last  = scan.findLine ( "$EndElements" );
+
+  vector<const char*>  bounds;
+  vector<ElemChunk>    chunks ( threadCount );
+
+  splitLines ( bounds, first, last, threadCount );
+
+  parallelFor ( threadCount, threadCount, [&] ( int ic )
+  {
+    TextScanner  s     ( bounds[ic], bounds[ic+1] );
+    ElemChunk&   chunk = chunks[ic];
+
+    int          elemType, matId, geoId;
 
-    // 3-node line elements
+    chunk.isValid = true;
 
-    if ( elemType == 8 )
+    while ( true )
     {
-      int no1 = boost::lexical_cast<int> ( splitLine[5] );
-      int no2 = boost::lexical_cast<int> ( splitLine[6] );
-      int no3 = boost::lexical_cast<int> ( splitLine[7] ); //midside node
-
-      globdat.boundaryNodes.insert ( no1 );
-      globdat.boundaryNodes.insert ( no2 );
-      globdat.boundaryNodes.insert ( no3 );
-
-      globdat.bndNodesMap[matId].insert ( no1 );
-      globdat.bndNodesMap[matId].insert ( no2 );
-      globdat.bndNodesMap[matId].insert ( no3 );
-      
-      if ( globdat.internalEdges[0] != matId )
-      {
-        globdat.nodePairs     .push_back ( NodePair (no1, no2) );
-        globdat.bndElemsDomain.push_back ( matId );
-        cout << matId << "\n";
-      }
+      s.skipSpaces ();
+
+      if ( s.atEnd () ) break;
+
+      const size_t nodeCount = chunk.nodes.size ();
 
-      if ( globdat.isConverter )
+      if ( !readElementLine ( s, elemType, matId, geoId, chunk.nodes ) )
       {
-          bndElemConn.resize ( 3 );
-          bndElemConn[0] = no1;
-          bndElemConn[1] = no3;
-          bndElemConn[2] = no2;
-
-          //print ( bndElemConn.begin(), bndElemConn.end() );
-    
-          globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount,elemType,  bndElemConn ) ) );
-          globdat.dom2BndElems[matId].push_back ( bieCount++ );
+        chunk.isValid = false;
+        break;
       }
 
-      continue;
+      chunk.lines.push_back ( elemType );
+      chunk.lines.push_back ( matId    );
+      chunk.lines.push_back ( geoId    );
+      chunk.lines.push_back ( chunk.nodes.size () - nodeCount );
     }
+  } );
 
-    // node element 
+  int  count = 0;
 
-    if ( elemType == 15 )
-    {
-      //globdat.isolatedNodes.push_back ( boost::lexical_cast<int> ( splitLine[5] ) );
-      //continue;
-      
-      int no1 = boost::lexical_cast<int> ( splitLine[5] );
+  for ( int ic = 0; ic < threadCount; ic++ )
+  {
+    if ( !chunks[ic].isValid ) invalidGmshFile ( "Elements" );
+
+    count += chunks[ic].lines.size () / 4;
+  }
 
-      globdat.boundaryNodes.     insert ( no1 );      
-      globdat.bndNodesMap[matId].insert ( no1 );
+  if ( count != elemCount ) invalidGmshFile ( "Elements" );
 
-      continue;
-    }
+  // merge in file order, ie is the line index in the whole section
 
-    // for a 3D mesh, triangles or quadrangles are surface elements
-    // ie. they are boundary elements not bulk elements.
+  int  ie = 0;
 
-    if ( globdat.is3D )
+  for ( int ic = 0; ic < threadCount; ic++ )
+  {
+    const ElemChunk&  chunk = chunks[ic];
+    const int*        nodes = chunk.nodes.data ();
+
+    for ( size_t il = 0; il < chunk.lines.size (); il += 4 )
     {
-      if ( elemType == 2 || elemType == 9 || // linear or quadratic triangle
-     	   elemType == 3 || elemType == 16 ) // linear or quadratic quadrangle
-      {
-	    connectivity.clear ();
+      const int* line = &chunk.lines[il];
 
-        transform ( splitLine.begin()+5, 
-         	        splitLine.end  (), 
-		            back_inserter(connectivity), 
-		            Str2IntFunctor() );
+      builder.addElement ( ie++, line[0], line[1], line[2], nodes, line[3] );
 
-        /* to check elements with coincident nodes such as [123 23 23]
-         *
-        print ( connectivity.begin(), connectivity.end() );
-        IntVector copy ( connectivity );
+      nodes += line[3];
+    }
 
-        std::sort ( copy.begin (), copy.end () );
-        auto last = std::unique ( copy.begin(), copy.end() );
-        copy.erase ( last, copy.end() );
+    chunks[ic] = ElemChunk ();
+  }
 
-        if ( copy.size() != connectivity.size () ){
-          print ( connectivity.begin(), connectivity.end() ); cout << endl;
-          exit(1);
-        }
-        */
+  scan.setPosition ( last );
+}
 
-        globdat.bndNodesMap[matId].insert ( connectivity.begin(),
-	                                          connectivity.end() );
-        if ( globdat.isConverter ){
-            globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount, elemType, connectivity ) ) );
-            globdat.dom2BndElems[matId].push_back ( bieCount++ );
-        }
-        continue;
-      }
-    }
+// ------------------------------------------------------------
+//    readNodesBinary
+// ------------------------------------------------------------
 
-    // material => elements
-    // element  => material (domain)
+// binary 2.2 file: node-number (int) x y z (double) per node
 
-    globdat.dom2Elems[matId].push_back ( ie );
-    globdat.elem2Domain[ie] = matId;
+static void              readNodesBinary
 
-    // the rest are solid elements 
-    // either 2D solid elements or 3D solid elements
+    ( TextScanner&      scan,
+      GmshMeshBuilder&  builder,
+      int               nodeCount )
+{
+  const size_t  recordSize = sizeof(int) + 3 * sizeof(double);
 
-    // read connectivity 
+  vector<char>  block ( nodeCount * recordSize );
 
-    connectivity.clear ();
+  if ( !scan.readBytes ( block.data (), block.size () ) ) invalidGmshFile ( "Nodes" );
 
-    transform ( splitLine.begin()+5, 
-	            splitLine.end  (), 
-        		back_inserter(connectivity), 
-		        Str2IntFunctor() );
+  const char*   record = block.data ();
 
-    globdat.elemSet.push_back ( ElemPointer ( new Element ( ie, elemType, connectivity ) )  );
+  int           id;
+  double        xyz[3];
 
-    globdat.elemId2Position[ie] = globdat.elemSet.size() - 1;
+  for ( int in = 0; in < nodeCount; in++, record += recordSize )
+  {
+    memcpy ( &id, record,               sizeof(int)        );
+    memcpy (  xyz, record + sizeof(int), 3 * sizeof(double) );
+
+    builder.addNode ( id, xyz[0], xyz[1], xyz[2] );
   }
+}
+
+// ------------------------------------------------------------
+//    readElementsBinary
+// ------------------------------------------------------------
 
-  cout << "Reading elements...done!\n";
+// binary 2.2 file: blocks of elements of the same type, each block
+// starts with elm-type, num-elm-follow, num-tags and every element
+// is then stored as number, tags, nodes (all int)
 
-  file.close ();
+static void              readElementsBinary
 
-  // check validity of input
+    ( TextScanner&      scan,
+      GmshMeshBuilder&  builder,
+      int               elemCount )
+{
+  IntVector     block;
+
+  int           header[3];
+  int           ie = 0;
 
-  if ( globdat.isDomain )
+  while ( ie < elemCount )
   {
-    Int2IntVectMap::const_iterator it;
-    Int2IntVectMap::const_iterator eit = globdat.dom2Elems.end   ();
+    if ( !scan.readBytes ( header, sizeof(header) ) ) invalidGmshFile ( "Elements" );
 
-    it = globdat.dom2Elems.find ( globdat.rigidDomain[0] );
+    const int   elemType  = header[0];
+    const int   count     = header[1];
+    const int   tagCount  = header[2];
+    const int   nodeCount = GmshMeshBuilder::getNodeCount ( elemType );
 
-    if ( it == eit )
+    if ( nodeCount == 0 )
     {
-      cerr << "invalid number of rigid domain!!!\n";
+      cout << "Unsupported Gmsh element type " << elemType << "!!!\n\n";
       exit(1);
     }
-  }
 
-  if ( globdat.isInterface )
-  {
-  }
+    if ( count <= 0 || tagCount < 0 || ie + count > elemCount )
+    {
+      invalidGmshFile ( "Elements" );
+    }
 
-  if ( globdat.isNotch )
-  {
-    cout << "Existing notch segment is: " << globdat.segment[0] << endl;
+    const int   width     = 1 + tagCount + nodeCount;
+
+    block.resize ( (size_t) count * width );
+
+    if ( !scan.readBytes ( block.data (), block.size () * sizeof(int) ) )
+    {
+      invalidGmshFile ( "Elements" );
+    }
+
+    const int*  record    = block.data ();
+
+    for ( int i = 0; i < count; i++, record += width )
+    {
+      const int matId = tagCount > 0 ? record[1] : 0;
+      const int geoId = tagCount > 1 ? record[2] : 0;
+
+      builder.addElement ( ie++, elemType, matId, geoId,
+                           record + 1 + tagCount, nodeCount );
+    }
   }
+}
+
+// =====================================================================
+//     readGmshVersion
+// =====================================================================
+
+// version of the format given in $MeshFormat, 0 if there is none
 
-  if ( globdat.isIgSegment )
+double                   readGmshVersion
+
+    ( const char* fileName )
+{
+  MappedFile      file;
+  string          section;
+  double          version = 0.;
+
+  if ( !file.open ( fileName ) ) return 0.;
+
+  TextScanner     scan ( file.begin(), file.end() );
+
+  if ( scan.nextSection ( section ) && section == "MeshFormat" )
   {
-    cout << "Do not treat nodes on this segment: "<< globdat.ignoredSegment << endl;
+    if ( !scan.readDouble ( version ) ) version = 0.;
   }
 
-  cout << endl;
+  return version;
+}
+
+// =====================================================================
+//     readGmshMesh
+// =====================================================================
 
-  globdat.nodeElemCount = connectivity.size ();
+void                     readGmshMesh 
 
-  string elemTypeStr = "linear";
+    ( Global&        globdat,
+      const char*    fileName,
+      GmshMeshCache* cache )
+{
+  MappedFile      file;
 
-  if ( globdat.elemSet.size() == 0 )
+  if ( !file.open ( fileName ) ) 
   {
-    cout << "There is no solid elements defined!!!\n";
-    cout << "Please double check your input mesh.\n";
-    exit(-1);
+    cout << "Unable to open mesh file!!!\n\n";
+    exit(1);
   }
 
-  elemType = globdat.elemSet[0]->getElemType ();
+  TextScanner     scan ( file.begin(), file.end() );
+  GmshMeshBuilder builder ( globdat, cache );
+
+  const int       threadCount = globdat.threadCount;
 
-  if ( !globdat.is3D )
+  int             id, idx, dim;
+  int             elemType;
+  int             matId, geoId;
+  int             fileType, dataSize;
+
+  double          version;
+  double          x,y,z;
+
+  IntVector       connectivity;
+
+  string          section;
+  string          name;
+
+  bool            gotElements = false;
+  bool            isBinary    = false;
+
+  cout << "Reading Gmsh mesh file ...\n";
+
+  while ( scan.nextSection ( section ) )
   {
-    if ( elemType == 2 || elemType == 3 )
+    if      ( section == "MeshFormat" )
     {
-      globdat.nodeICount  = globdat.isContinuum ? 4 : 2;
-      globdat.isQuadratic = false;
-      elemTypeStr         = "linear";
+      if ( !scan.readDouble ( version  ) ||
+           !scan.readInt    ( fileType ) ||
+           !scan.readInt    ( dataSize ) ) invalidGmshFile ( "MeshFormat" );
+
+      scan.skipLine ();
+
+      if ( fileType == 1 )
+      {
+        int one = 0;
+
+        if ( dataSize != sizeof(double) )
+        {
+          cout << "Binary Gmsh file with data-size " << dataSize
+               << " is not supported!!!\n\n";
+          exit(1);
+        }
+
+        if ( !scan.readBytes ( &one, sizeof(int) ) ) invalidGmshFile ( "MeshFormat" );
+
+        if ( one != 1 )
+        {
+          cout << "Binary Gmsh file written on a machine with other endianness!!!\n\n";
+          exit(1);
+        }
+
+        scan.skipLine ();
+
+        isBinary = true;
+      }
+      else if ( fileType != 0 )
+      {
+        invalidGmshFile ( "MeshFormat" );
+      }
     }
-    else
+    else if ( section == "PhysicalNames" )
     {
-      globdat.nodeICount  = 6;
-      globdat.isQuadratic = true;
-      elemTypeStr         = "quadratic";
+      cout << "Reading physical names...\n";
+
+      int namesCount;
+
+      if ( !scan.readInt ( namesCount ) ) invalidGmshFile ( "PhysicalNames" );
+
+      scan.skipLine ();
+
+      for ( int in = 0; in < namesCount; in++ )
+      {
+        if ( !scan.readInt ( dim ) || 
+             !scan.readInt ( idx ) ) invalidGmshFile ( "PhysicalNames" );
+
+        scan.readLine ( name );
+
+        builder.addPhysicalName ( idx, name );
+      }
+
+      cout << "Reading physical names...done!\n";
     }
-  }
-  else
-  {
-    // hex8 or tet4 elements 
-    if ( elemType == 4 || elemType == 5 ) 
+    else if ( section == "Nodes" )
     {
-      globdat.nodeICount  = elemType == 4 ? 6 : 8;
-      globdat.isQuadratic = false; 
-      elemTypeStr = "linear";
+      cout << "Reading nodes...\n";
+
+      int nodeCount;
+
+      if ( !scan.readInt ( nodeCount ) ) invalidGmshFile ( "Nodes" );
+
+      scan.skipLine ();
+
+      builder.reserveNodes ( nodeCount );
+
+      if      ( isBinary )
+      {
+        readNodesBinary   ( scan, builder, nodeCount );
+      }
+      else if ( threadCount > 1 )
+      {
+        readNodesParallel ( scan, builder, nodeCount, threadCount );
+      }
+      else
+      {
+        for ( int in = 0; in < nodeCount; in++ )
+        {
+          if ( !scan.readInt    ( id ) ||
+               !scan.readDouble ( x  ) ||
+               !scan.readDouble ( y  ) ||
+               !scan.readDouble ( z  ) ) invalidGmshFile ( "Nodes" );
+
+          scan.skipLine ();
+
+          builder.addNode ( id, x, y, z );
+        }
+      }
+
+      builder.endNodes ();
     }
-    // hex20 or tet10 elements 
-    else
+    else if ( section == "Elements" )
     {
-      globdat.nodeICount  = elemType == 11 ? 12 : 16;
-      globdat.isQuadratic = true;
-      elemTypeStr = "quadratic";
-    }
+      cout << "Reading elements...\n";
 
-    // build faces for 3D elements
-  
-    cout << "Building initial faces of 3D elements...\n\n"; 
+      int elemCount;
 
-    for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
-    {
-      globdat.elemSet[ie]->buildFaces0 ();
-    }
-    cout << "Building initial faces of 3D elements...done\n\n"; 
-  }
-  
-  // check boundary elements of a 3D mesh to see whether zero area elements
-  // exist
-  if ( globdat.is3D )
-  {
-    const int elemCount    = globdat.elemSet      .size();
-    const int bndElemCount = globdat.bndElementSet.size();
-  
-    ElemPointer ep;
-    IntVector connect;
+      if ( !scan.readInt ( elemCount ) ) invalidGmshFile ( "Elements" );
 
-    for ( int ie = 0; ie < bndElemCount; ie++ )
-    {
-      ep = globdat.bndElementSet[ie];
-      ep->getJemConnectivity ( connect ); 
+      scan.skipLine ();
 
-          print ( connect.begin(), connect.end() );
-        IntVector copy ( connect);
+      builder.reserveElements ( elemCount );
 
-        std::sort ( copy.begin (), copy.end () );
-        auto last = std::unique ( copy.begin(), copy.end() );
-        copy.erase ( last, copy.end() );
+      if      ( isBinary )
+      {
+        readElementsBinary   ( scan, builder, elemCount );
+      }
+      else if ( threadCount > 1 )
+      {
+        readElementsParallel ( scan, builder, elemCount, threadCount );
+      }
+      else
+      {
+        for ( int ie = 0; ie < elemCount; ie++ )
+        {
+          connectivity.clear ();
 
-        if ( copy.size() != connect.size () ){
-          print ( connect.begin(), connect.end() );
-          exit(1);
+          if ( !readElementLine ( scan, elemType, matId, geoId,
+                                  connectivity ) ) invalidGmshFile ( "Elements" );
+
+          builder.addElement ( ie, elemType, matId, geoId,
+                               connectivity.data (), connectivity.size () );
         }
+      }
+
+      if ( !builder.endElements () ) exit(1);
+
+      gotElements = true;
     }
   }
 
-  cout << "Check validity of input...done!\n\n";
+  if ( !gotElements ) invalidGmshFile ( "Elements" );
 }
@@ -0,0 +1,165 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * IdMap maps node/element ids to integers (positions, domains). Mesh
+ * ids are nearly contiguous, so the values are kept in a flat vector
+ * indexed by the id. Ids that would make the vector much larger than
+ * the number of entries (negative, or very sparse) go to a hash table.
+ *
+ * As with std::map, operator[] inserts a zero for an unknown id, and
+ * get() returns zero for it without inserting.
+ */
+
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include <unordered_map>
+#include <climits>
+
+#include "typedefs.h"
+
+// =====================================================================
+//     class IdMap
+// =====================================================================
+
+class IdMap
+{
+  public:
+
+                         IdMap       () : count_(0) {}
+
+    inline int&          operator[]  ( int id );
+    inline int           get         ( int id ) const;
+
+    int                  size        () const { return count_; }
+    bool                 empty       () const { return count_ == 0; }
+
+    inline void          clear       ();
+
+    // make room for the ids [0, maxId]
+
+    inline void          reserve     ( int maxId );
+
+  private:
+
+    static constexpr int EMPTY_ = INT_MIN;
+
+    inline bool          grow_       ( int id );
+    inline void          resize_     ( size_t size );
+
+  private:
+
+    IntVector                     dense_;   // EMPTY_ for unused ids
+    std::unordered_map<int,int>   sparse_;
+    int                           count_;
+};
+
+// ==========================================================
+//   implementation of inline functions
+// ==========================================================
+
+inline int& IdMap::operator[] ( int id )
+{
+  if ( (unsigned) id < dense_.size () || grow_ ( id ) )
+  {
+    int& value = dense_[id];
+
+    if ( value == EMPTY_ )
+    {
+      value = 0;
+      count_++;
+    }
+
+    return value;
+  }
+
+  std::pair<std::unordered_map<int,int>::iterator,bool> res =
+
+    sparse_.insert ( std::make_pair ( id, 0 ) );
+
+  if ( res.second ) count_++;
+
+  return res.first->second;
+}
+
+inline int IdMap::get ( int id ) const
+{
+  // the hash table never holds ids covered by the flat table
+
+  if ( (unsigned) id < dense_.size () )
+  {
+    const int value = dense_[id];
+
+    return value == EMPTY_ ? 0 : value;
+  }
+
+  if ( sparse_.empty () ) return 0;
+
+  std::unordered_map<int,int>::const_iterator it = sparse_.find ( id );
+
+  return it == sparse_.end () ? 0 : it->second;
+}
+
+inline void IdMap::clear ()
+{
+  dense_ .clear ();
+  sparse_.clear ();
+  count_ = 0;
+}
+
+inline void IdMap::reserve ( int maxId )
+{
+  if ( maxId >= 0 && (unsigned) maxId >= dense_.size () ) resize_ ( (size_t) maxId + 1 );
+}
+
+// ------------------------------------------------------------
+//    grow_
+// ------------------------------------------------------------
+
+// extend the flat table up to id, if that keeps it reasonably
+// small compared to the number of entries
+
+inline bool IdMap::grow_ ( int id )
+{
+  if ( id < 0 ) return false;
+
+  const size_t limit = 4 * (size_t) count_ + 1024;
+
+  if ( (size_t) id >= limit && (size_t) id >= 2 * dense_.size () ) return false;
+
+  size_t       size  = std::max ( (size_t) id + 1, dense_.size () + dense_.size () / 2 );
+
+  if ( size > limit && (size_t) id < limit ) size = limit;
+
+  resize_ ( size );
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    resize_
+// ------------------------------------------------------------
+
+inline void IdMap::resize_ ( size_t size )
+{
+  const size_t first = dense_.size ();
+
+  dense_.resize ( size, EMPTY_ );
+
+  // ids that were put in the hash table now belong to the flat table
+
+  for ( std::unordered_map<int,int>::iterator it = sparse_.begin (); it != sparse_.end (); )
+  {
+    if ( it->first >= (int) first && (size_t) it->first < size )
+    {
+      dense_[it->first] = it->second;
+      it = sparse_.erase ( it );
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+#endif
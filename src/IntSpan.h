@@ -0,0 +1,44 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * IntSpan is a read-only view of a contiguous range of integers, such
+ * as a row of a CSRGraph or the connectivity of an element in an
+ * ElemSet. It does not own the integers and is invalidated when the
+ * container it looks into grows.
+ */
+
+#ifndef INT_SPAN_H
+#define INT_SPAN_H
+
+// =====================================================================
+//     class IntSpan
+// =====================================================================
+
+// read-only view of a contiguous range of integers
+
+class IntSpan
+{
+  public:
+
+    typedef const int*  const_iterator;
+
+                   IntSpan    () : first_(0), last_(0) {}
+
+                   IntSpan    ( const int* first, const int* last )
+                     : first_(first), last_(last) {}
+
+    const int*     begin      () const { return first_; }
+    const int*     end        () const { return last_;  }
+
+    int            size       () const { return (int) ( last_ - first_ ); }
+    bool           empty      () const { return first_ == last_; }
+
+    int            operator[] ( int i ) const { return first_[i]; }
+
+  private:
+
+    const int*     first_;
+    const int*     last_;
+};
+
+#endif
@@ -3,9 +3,12 @@
 #include <iterator>
 
 #include "InterfaceBuilder.h"
+#include "InterfaceStream.h"
 #include "Global.h"
 #include "Element.h"
+#include "ElementTraits.h"
 #include "Node.h"
+#include "Parallel.h"
 #include "utilities.h"
 
 /*
@@ -64,12 +67,12 @@
 //   doIt
 // ---------------------------------------------------------
 
-void   InterfaceBuilder::doIt ( Global& globdat )
+bool   InterfaceBuilder::doIt ( Global& globdat )
 {
   if      ( globdat.isConverter ) 
   {    
       cout << "Convering mesh to jive format...\n";
-      return;
+      return true;
   }
 
   cout << "Adding interface elements...\n";
@@ -98,19 +101,28 @@ void   InterfaceBuilder::doIt ( Global& globdat )
     doForEverywhere       ( globdat ); 
   }
 
-  if ( globdat.interfaceSet.size () == 0 )
+  // a builder that cannot handle the mesh sets globdat.error
+
+  if ( !globdat.error.empty () ) return false;
+
+  // with --stream, the elements and their groups are in the stream
+
+  InterfaceStream* stream  = globdat.interfaceStream;
+
+  const int   ieCount = stream ? stream->size () : globdat.interfaceSet.size ();
+
+  if ( ieCount == 0 )
   {
     cout << "No interface elements generated!!!\n";
-    exit(1);
+    globdat.error = "no interface elements generated";
+    return false;
   }
   
-  const int   ieCount = globdat.interfaceSet.size ();
-
   ElemPointer ep;
 
   int         index, matid;
 
-  for ( int ie = 0; ie < ieCount; ie++ )
+  for ( int ie = 0; !stream && ie < ieCount; ie++ )
   {
     ep = globdat.interfaceSet[ie];
 
@@ -123,20 +135,32 @@ void   InterfaceBuilder::doIt ( Global& globdat )
   // and interface elements in the bulk (matrix cracks) are assigned 0
   // No longer correct! 
 
-  interfaceMat = std::count ( globdat.interfaceMats.begin(), globdat.interfaceMats.end(), 1 );
-  bulkMat      = std::count ( globdat.interfaceMats.begin(), globdat.interfaceMats.end(), 0 );
+  if ( stream )
+  {
+    interfaceMat = stream->getMatCount ( 1 );
+    bulkMat      = stream->getMatCount ( 0 );
+  }
+  else
+  {
+    interfaceMat = std::count ( globdat.interfaceMats.begin(), globdat.interfaceMats.end(), 1 );
+    bulkMat      = std::count ( globdat.interfaceMats.begin(), globdat.interfaceMats.end(), 0 );
+  }
 
-  const int intElemTypeCount = globdat.mat2InterfaceElems.size ();
+  const int intElemTypeCount = stream ? stream->getMatRuns().size ()
+                                      : globdat.mat2InterfaceElems.size ();
 
   cout << "Adding interface elements...done!\n\n";
 
-  cout << "Number of interface elements added:  " << globdat.interfaceSet.size () << endl
-       << "Number of flow      elements added:  " << globdat.flowElemSet .size () << endl
+  cout << "Number of interface elements added:  " << ieCount << endl
+       << "Number of flow      elements added:  " << ( stream ? stream->getFlowCount ()
+                                                              : globdat.flowElemSet.size () ) << endl
        << "Number of nodes added             :  " << globdat.newNodeSet.size () - globdat.nodeSet.size() << endl
        << "Number of IE types                :  " << intElemTypeCount << endl
        << "Number of elements on the interface: " << interfaceMat << endl
        << "Number of elements in the bulk    :  " << bulkMat << endl
        << "\n\n";
+
+  return true;
 }
 
 // ---------------------------------------------------------
@@ -219,30 +243,33 @@ void   InterfaceBuilder::doForDomain ( Global& globdat )
 
 void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
 {
-  int              n1,n2,p1;
+  int              n1,n2,p1(-1);
   int              m1,m2;
   int              o1,o2, o3;
   int              ieCount(0);
   int              nnode;
   int              bulk1, bulk2;
-  int              flowNode1, flowNode2;
   int              npId, bieCount(0);
 
   ElemPointer      ep;
   
-  IntVector        inodes, inodes0, inodesF, inodesC;
+  IntSpan          connec, inodesF;
+  IntVector        inodes, inodes0, inodesC;
   IntVector        interConnec(globdat.nodeICount);
   IntVector        flowConnec (globdat.nodeICount/2);
   IntVector        interConnec1, interConnec2;
   IntVector        bndElemConn(globdat.nodeICount/2);
 
-  vector<NodePair> doneEdges;   // list of edges already done
+  int              edge;
   set<int>         doneNodes;   // list of edges already done
-  vector<NodePair>::const_iterator  npIt;
   doneNodes.insert(-1);
 
   const  int       elemCount = globdat.elemSet.size ();
 
+  EdgeTable&       edges     = globdat.edgeTable;
+
+  edges.resetDone ();
+
   cout << " - standard 2D material interfaces\n";
 
   // loop over all bulk elements
@@ -251,13 +278,16 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
   {
      ep    = globdat.elemSet[ie];
 
-    ep->getConnectivity         ( inodes  );      // modified connectivity 
-     ep->getCornerConnectivity0 ( inodes0 );
+     connec = ep->getConnectivity         ();      // modified connectivity 
+     inodes .assign ( connec.begin(), connec.end() );
+     connec = ep->getCornerConnectivity0  ();
+     inodes0.assign ( connec.begin(), connec.end() );
 
      if ( globdat.isQuadratic ) 
      {
-       ep->getConnectivity0      ( inodesF ); 
-       ep->getCornerConnectivity ( inodesC );   
+       inodesF = ep->getConnectivity0      (); 
+       connec  = ep->getCornerConnectivity ();   
+       inodesC.assign ( connec.begin(), connec.end() );
        inodesC.push_back ( inodesC[0] );  
      }
 
@@ -280,20 +310,16 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
        o1 = globdat.nodeId2Position[n1];
        o2 = globdat.nodeId2Position[n2];
 
-       m1 = globdat.nodeSet[o1]->getDuplicity ();
-       m2 = globdat.nodeSet[o2]->getDuplicity ();
+       m1 = globdat.nodeSet.getDuplicity ( o1 );
+       m2 = globdat.nodeSet.getDuplicity ( o2 );
 
        // edge on external boundary, also omitted
 
-       npIt = find ( globdat.nodePairs.begin(), globdat.nodePairs.end(), NodePair(n1,n2) ); 
-          cout << globdat.nodePairs.size() << "\n";
+       edge = edges.getEdgeId ( ie, in );
 
-       if ( npIt != globdat.nodePairs.end() )
+       if ( edges.isOnBoundary ( edge ) )
        {
-          cout << "edge (" << n1 << "," << n2 << ")" << endl;
-          cout << npIt-globdat.nodePairs.begin() << "\n";
-          npId = globdat.bndElemsDomain[npIt - globdat.nodePairs.begin()];
-          cout << npId << "\n";
+          npId = edges.getBoundaryDomain ( edge );
 
           if (!globdat.isQuadratic)
           {
@@ -307,7 +333,7 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
             bndElemConn[2] = inodesC[in+1];
           }
 	
-          globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount, bndElemConn ) ) );
+          globdat.bndElementSet.addElement ( bieCount, bndElemConn );
           globdat.dom2BndElems[npId].push_back ( bieCount++ );
 
 	      continue;
@@ -321,9 +347,7 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
 
        // ignore edge already added
 
-       if ( find ( doneEdges.begin(), 
-       	           doneEdges.end  (), 
-       	           NodePair(n1,n2) ) != doneEdges.end() )
+       if ( edges.isDone ( edge ) )
        {
          break;
        }
@@ -332,15 +356,15 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
 
        if ( globdat.isNotch )
        {
-         bool val1, val2;
+         bool val1(false), val2(false);
 
-         double x1 = globdat.nodeSet[o1]->getX ();
-         double y1 = globdat.nodeSet[o1]->getY ();
+         double x1 = globdat.nodeSet.getX ( o1 );
+         double y1 = globdat.nodeSet.getY ( o1 );
 
-         double x2 = globdat.nodeSet[o2]->getX ();
-         double y2 = globdat.nodeSet[o2]->getY ();
+         double x2 = globdat.nodeSet.getX ( o2 );
+         double y2 = globdat.nodeSet.getY ( o2 );
 
-         for ( int is = 0; is < globdat.segment.size(); is++ )
+         for ( size_t is = 0; is < globdat.segment.size(); is++ )
          {
            val1 = globdat.segment[is].isOn ( x1, y1 );
            val2 = globdat.segment[is].isOn ( x2, y2 );
@@ -350,7 +374,6 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
 
          if ( val1 && val2 ) break; // do not add interface on existing notch
        }
-       cout << m1 <<  ", " << m2 << endl;
 
        addInterface ( interConnec, n1, n2, p1, ep->getChanged(), globdat );
 
@@ -358,17 +381,16 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
        bulk2 = ep->getIndexElementContainsEdge ( globdat, 
                    globdat.duplicatedNodes0[n1][1], globdat.duplicatedNodes0[n2][1] );
 
-       cout<< "bulk1 and bulk2: " <<  bulk1 << " " << bulk2 << endl;
        //bulk1 = globdat.elemId2Position[bulk1];
        //bulk2 = globdat.elemId2Position[bulk2];
 
-       globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0,
-                   interConnec, bulk1, bulk2 ) ) );
+       globdat.interfaceSet.addElement ( ieCount, 0,
+                   interConnec, bulk1, bulk2 );
        
        globdat.interfaceMats.push_back (0);
        ieCount++;
 
-       doneEdges.push_back ( NodePair(n1,n2) );
+       edges.setDone ( edge );
 
        // hydraulic fracture is on
 
@@ -387,7 +409,7 @@ void   InterfaceBuilder::doFor2DMatInterface ( Global& globdat )
             flowConnec[1] = globdat.flowNodes[o2];
           }
        
-          globdat.flowElemSet.push_back ( ElemPointer ( new Element ( ieCount, 0, flowConnec ) ) );
+          globdat.flowElemSet.addElement ( ieCount, 0, flowConnec );
        }
     }
   }
@@ -402,23 +424,25 @@ void   InterfaceBuilder::doFor3DMatInterface ( Global& globdat )
 
   ElemPointer        ip, jp;
 
-  IntVector          face, sface, fface;
+  IntVector          face, fface;
   IntVector          interConnec(globdat.nodeICount);
   IntVector          neighbors;
-  vector<IntVector>  doneFaces;
+
+  FaceTable&         faces = globdat.faceTable;
 
   int                nodeCount;
   int                ieCount(0);
-  int                ielem, n, m;
+  int                n, m;
   int                oppVertex, fIndex;
   int                bulk1, bulk2;
 
   const  int         elemCount = globdat.elemSet.size ();
 
+  faces.resetDone ();
+
   for ( int ie = 0; ie < elemCount; ie++ )
   {
     ip    = globdat.elemSet[ie];
-    ielem = ip->getIndex ();
 
     if ( ip->isOnInterface ( face, oppVertex, fIndex,
 	                     globdat.nodeSet, globdat.nodeId2Position, globdat ) )
@@ -443,7 +467,7 @@ void   InterfaceBuilder::doFor3DMatInterface ( Global& globdat )
 
 	    vector<double> zCoord(2); zCoord[0] = 0.; zCoord[1]=-0.265;
 
-	    for ( int is = 0; is < globdat.segment.size(); is++ )
+	    for ( size_t is = 0; is < globdat.segment.size(); is++ )
 	    {
 	      xMin = globdat.segment[is].p1.x; 
 	      xMax = globdat.segment[is].p2.x;
@@ -460,13 +484,11 @@ void   InterfaceBuilder::doFor3DMatInterface ( Global& globdat )
         if (ignored) continue;
       }
 
-      sface = face;
+      // the face and the same face of the neighbour have one id
 
-      sort ( sface.begin(), sface.end() );
+      const int  faceId = faces.getFaceId ( ie, fIndex );
 
-      if ( find ( doneFaces.begin(),
-	              doneFaces.end  (), 
-		          sface ) != doneFaces.end() )
+      if ( faces.isDone ( faceId ) )
       {
 	    continue;
       }
@@ -512,386 +534,316 @@ void   InterfaceBuilder::doFor3DMatInterface ( Global& globdat )
       //bulk1 = globdat.elemId2Position[bulk1];
       //bulk2 = globdat.elemId2Position[bulk2];
 
-      globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0,
-                   interConnec, bulk1, bulk2 ) ) );
+      globdat.interfaceSet.addElement ( ieCount, 0,
+                   interConnec, bulk1, bulk2 );
 
       globdat.interfaceMats.push_back (0);
       globdat.oppositeVertices.push_back ( oppVertex );
       ieCount++;
 
-      doneFaces.push_back ( sface );
+      faces.setDone ( faceId );
     }
   }
 }
 
 // ---------------------------------------------------------
-//   doForDomain2D
+//   InterfaceChunk
 // ---------------------------------------------------------
 
-void   InterfaceBuilder::doForDomain2D ( Global& globdat )
-{
-  int              neiCount;
-  int              nnode;
-  int              n1,n2,n12;
-  int              m1,m2;
-  int              o1,o2;
-  int              p1,p2,p12;
-  int              ielem, jelem, ieCount(0), bieCount(0);
-  int              bulk1, bulk2;
-  int              npId;
-
-  ElemPointer      ep,jp;
-  
-  IntVector        inodes, inodes0, inodes00, inodesF, inodesC;
-  IntVector        jnodes, jnodes0;
-  IntVector        interConnec(globdat.nodeICount);
-  IntVector        bndElemConn(globdat.nodeICount/2);
-  IntVector        neighbors;
-  vector<NodePair> doneEdges;   // list of edges already done
+// Interface (and boundary) elements found by one worker of the domain
+// and everywhere options. The faces (3D) or the elements (2D) are cut
+// into contiguous blocks, one block per worker (--threads); the chunks
+// are then added to globdat in block order, so that the elements are
+// numbered exactly as with a single worker.
 
+struct InterfaceChunk
+{
+  IntVector        connec;      // nodeICount nodes per interface element
+  IntVector        bulks;       // two bulk elements per interface element
+  IntVector        mats;
+  IntVector        oppVertices; // 3D
+  IntVector        edges;       // 2D: edge of every interface element
+  IntVector        flowConnec;  // 2D, hydraulic: nodeICount/2 per interface element
+  IntVector        bndConnec;   // 2D: nodeICount/2 nodes per boundary element
+  IntVector        bndDomains;  // 2D: domain of every boundary element
+};
+
+// collect ( chunk, first, last ) on contiguous blocks of [begin,end)
+
+template <class Collect>
+static void collectChunks
+
+  ( vector<InterfaceChunk>&  chunks,
+    int                      begin,
+    int                      end,
+    int                      workerCount,
+    const Collect&           collect )
+{
+  const int taskCount = end - begin;
 
-  IntVector::const_iterator         it1, it2, it12;
-  vector<NodePair>::const_iterator  npIt;
+  if ( workerCount > taskCount ) workerCount = taskCount;
+  if ( workerCount < 1         ) workerCount = 1;
 
-  const  int        elemCount = globdat.elemSet.size ();
+  chunks.assign ( workerCount, InterfaceChunk () );
 
-  for ( int ie = 0; ie < elemCount; ie++ )
+  parallelFor ( workerCount, workerCount, [&] ( int ic )
   {
-    ep    = globdat.elemSet[ie];
-    ielem = ep->getIndex();
-
-    ep->getConnectivity        ( inodes  );      // full, updated connectivity 
-    ep->getCornerConnectivity0 ( inodes0 );      // for edge, only corner nodes suffice 
-    //inodes00 = inodes0;
-
-    // for quadratic elements, need a full connectivity
-
-    if ( globdat.isQuadratic ) 
-    {
-       ep->getConnectivity0      ( inodesF ); 
-       ep->getCornerConnectivity ( inodesC );   
-       inodesC.push_back ( inodesC[0] );  
-    }
+    const int first = begin + (int) ( (long long) taskCount *  ic      / workerCount );
+    const int last  = begin + (int) ( (long long) taskCount * (ic + 1) / workerCount );
 
-    //print ( inodes0.begin(), inodes0.end() );
-    //print ( inodesF.begin(), inodesF.end() );
-    
-    inodes0.push_back ( inodes0[0] );  
-    inodes .push_back ( inodes [0] );  
+    collect ( chunks[ic], first, last );
+  } );
+}
 
-    nnode = inodes0.size();
+// ---------------------------------------------------------
+//   addChunks
+// ---------------------------------------------------------
 
-    neighbors = globdat.elemNeighbors[ie]; 
-    neiCount  = neighbors.size ();
-    
-    //cout << "doing element " << ie+1 << ":\n ";
-   // print ( neighbors.begin(), neighbors.end() );
+// add the elements of the chunks to globdat (or to the interface
+// stream), in chunk order. With several 2D chunks, an edge may be
+// found by the elements on both of its sides: only the first one is
+// kept, as the serial loop does with the done flag (isResolved: the
+// chunks already did it).
 
-    // loop over edges, add interface along common edge
+static void addChunks
 
-    for ( int in = 0; in < nnode-1; in++ )
-    {
-      // indices of two nodes making the edge 
+  ( const vector<InterfaceChunk>&  chunks,
+    bool                           isResolved,
+    Global&                        globdat )
+{
+  const int        nodeCount = globdat.nodeICount;
+  const int        bndCount  = globdat.nodeICount/2;
 
-      n1 = inodes0[in];
-      n2 = inodes0[in+1];
+  int              ieCount  = globdat.interfaceSet .size ();
+  int              bieCount = globdat.bndElementSet.size ();
+  int              count(0);
 
-      if ( globdat.isQuadratic ) n12 = inodesF[nnode - 1 + in]; // index of midside node
-      
-      //cout << "edge (" << n1 << "," << n2 << ")" << endl;
-
-      // get number of elements around these nodes
+  IntVector        interConnec;
+  IntVector        flowConnec;
+  IntVector        bndElemConn;
 
-      o1 = globdat.nodeId2Position[n1];
-      o2 = globdat.nodeId2Position[n2];
-      m1 = globdat.nodeSet[o1]->getDuplicity ();
-      m2 = globdat.nodeSet[o2]->getDuplicity ();
+  EdgeTable&       edges     = globdat.edgeTable;
 
-      // edge on external boundary, also omitted
-      // build boundary elements
-      
-      npIt = find ( globdat.nodePairs.begin(), globdat.nodePairs.end(), NodePair(n1,n2) ); 
+  InterfaceStream* stream    = globdat.interfaceStream;
+  InterfaceBatch   batch;
 
-      if ( npIt != globdat.nodePairs.end() )
-      {
-         npId = globdat.bndElemsDomain[npIt - globdat.nodePairs.begin()];
+  for ( size_t ic = 0; ic < chunks.size(); ic++ )
+  {
+    count += chunks[ic].mats.size ();
+  }
 
-         if (!globdat.isQuadratic)
-         {
-           bndElemConn[0] = inodes[in];
-	       bndElemConn[1] = inodes[in+1];
-         }
-         else
-         {
-           // note that for corner nodes, using the corner connectivity
-           // for the midside nodes, using the full connectivity 
-           bndElemConn[0] = inodesC[in];
-           bndElemConn[1] = inodes[nnode - 1 + in];
-           bndElemConn[2] = inodesC[in+1];
-           //print (interConnec.begin(), interConnec.end());
-         }
-        
-         globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount, bndElemConn ) ) );
-         globdat.dom2BndElems[npId].push_back ( bieCount++ );
+  if ( !stream )
+  {
+    globdat.interfaceSet    .reserve   ( ieCount + count, ( ieCount + count ) * nodeCount );
+    globdat.interfaceMats   .reserve   ( ieCount + count );
+  }
 
-	      continue;
-      }
-      
-      // not a common edge (or not an interelement boundary), omits
-      
-      if ( ( m1 == 0 ) || ( m2 == 0 ) ) continue;
-      if ( ( m1 == 1 ) || ( m2 == 1 ) ) continue;
+  for ( size_t ic = 0; ic < chunks.size(); ic++ )
+  {
+    const InterfaceChunk& c = chunks[ic];
 
+    for ( size_t ib = 0; ib < c.bndDomains.size(); ib++ )
+    {
+      bndElemConn.assign ( c.bndConnec.begin() +  ib    * bndCount,
+                           c.bndConnec.begin() + (ib+1) * bndCount );
 
-      // ignore edge already added
+      globdat.bndElementSet.addElement ( bieCount, bndElemConn );
+      globdat.dom2BndElems[c.bndDomains[ib]].push_back ( bieCount++ );
+    }
 
-      if ( find ( doneEdges.begin(), 
-		  doneEdges.end  (), 
-		  NodePair(n1,n2) ) != doneEdges.end() )
+    for ( size_t i = 0; i < c.mats.size(); i++ )
+    {
+      if ( !isResolved && !c.edges.empty() )
       {
-	     continue;
+        if ( edges.isDone ( c.edges[i] ) ) continue;
+
+        edges.setDone ( c.edges[i] );
       }
-       
-      // existing notch
 
-      if ( globdat.isNotch )
+      if ( stream )
       {
-        bool val1, val2;
-
-        double x1 = globdat.nodeSet[o1]->getX ();
-        double y1 = globdat.nodeSet[o1]->getY ();
-
-        double x2 = globdat.nodeSet[o2]->getX ();
-        double y2 = globdat.nodeSet[o2]->getY ();
-
-        for ( int is = 0; is < globdat.segment.size(); is++ )
+        batch.connec.insert ( batch.connec.end(),
+                              c.connec.begin() +  i    * nodeCount,
+                              c.connec.begin() + (i+1) * nodeCount );
+        batch.bulks .push_back ( c.bulks[2*i] );
+        batch.bulks .push_back ( c.bulks[2*i+1] );
+        batch.mats  .push_back ( c.mats[i] );
+
+        if ( !c.oppVertices.empty() )
         {
-          val1 = globdat.segment[is].isOn ( x1, y1 );
-          val2 = globdat.segment[is].isOn ( x2, y2 );
-
-          if ( val1 && val2 ) break;
+          batch.oppVertices.push_back ( c.oppVertices[i] );
         }
 
-        if ( val1 && val2 ) break; // do not add interface on existing notch
-      }
+        if ( !c.flowConnec.empty() )
+        {
+          batch.flowConnec.insert ( batch.flowConnec.end(),
+                                    c.flowConnec.begin() +  i    * bndCount,
+                                    c.flowConnec.begin() + (i+1) * bndCount );
+        }
 
-      //int mat = globdat.elem2Domain[ielem];
-
-      // the following check is not necessary!!!
-
-      //if ( ( mat == globdat.rigidDomain ) || ( !ep->getChanged() ) )
-      //{
-      //  //interConnec[0] = n1;
-      //  //interConnec[1] = n2;
-      //  if ( n1 != inodesC[in] || n2 != inodesC[in+1] )
-      //  cout << n1 << " " << n2 << "; " << inodesC[in] << " " << inodesC[in+1] << "\n";
-      //}
-      //else
-      //{
-      //  interConnec[0] = inodes[in];
-      //  interConnec[1] = inodes[in+1];
-      //}
-           
-      if (!globdat.isQuadratic)
-      {
-	    interConnec[0] = inodes[in];
-	    interConnec[1] = inodes[in+1];
-      }
-      else
-      {
-        // note that for corner nodes, using the corner connectivity
-        // for the midside nodes, using the full connectivity 
-	    interConnec[0] = inodesC[in];
-	    interConnec[1] = inodes[nnode - 1 + in];
-	    interConnec[2] = inodesC[in+1];
-        //print (interConnec.begin(), interConnec.end());
+        continue;
       }
 
-      // loop over neighbors of element ie
+      interConnec.assign ( c.connec.begin() +  i    * nodeCount,
+                           c.connec.begin() + (i+1) * nodeCount );
 
-      for ( int je = 0; je < neiCount; je++ )
-      {
-	 jelem = globdat.elemId2Position[neighbors[je]];
-	 jp    = globdat.elemSet[jelem];
-
-	 if ( jp->getIndex() == ielem ) continue; 
+      globdat.interfaceSet.addElement ( ieCount, 0, interConnec,
+                                        c.bulks[2*i], c.bulks[2*i+1] );
+      ieCount++;
 
-	 jp->getConnectivity  ( jnodes  );
-	 jp->getConnectivity0 ( jnodes0 );
+      globdat.interfaceMats.push_back ( c.mats[i] );
 
-	 //print ( jnodes0.begin(), jnodes0.end() );
+      if ( !c.oppVertices.empty() )
+      {
+        globdat.oppositeVertices.push_back ( c.oppVertices[i] );
+      }
 
-	 it1 = find ( jnodes0.begin(), jnodes0.end(), n1 );
-	 it2 = find ( jnodes0.begin(), jnodes0.end(), n2 );
+      if ( !c.flowConnec.empty() )
+      {
+        flowConnec.assign ( c.flowConnec.begin() +  i    * bndCount,
+                            c.flowConnec.begin() + (i+1) * bndCount );
 
-         // a common edge is found between ie and je
+        globdat.flowElemSet.addElement ( ieCount, 0, flowConnec );
+      }
+    }
+  }
 
-	 if ( ( it1 != jnodes0.end() ) && ( it2 != jnodes0.end() ) )
-	 {
-	   p1 = jnodes[it1 - jnodes0.begin()];
-	   p2 = jnodes[it2 - jnodes0.begin()];
-	 
-           if (globdat.isQuadratic)
-           {
-             it12 = find ( jnodes0.begin(), jnodes0.end(), n12 );
-	     p12  = jnodes[it12 - jnodes0.begin()];
-	     
-             interConnec[3] = p1;
-	     interConnec[4] = p12;
-	     interConnec[5] = p2;
-           }
-           else
-           {
-	     interConnec[2] = p1;
-	     interConnec[3] = p2;
-           }
+  if ( stream ) stream->add ( batch );
+}
 
-	   //cout << " found common edge: (" << p1 << "," << p2 << ")" << endl;
-           //print (interConnec.begin(), interConnec.end());
+// ---------------------------------------------------------
+//   buildChunks
+// ---------------------------------------------------------
 
-           
-           bulk1 = ielem;
-           bulk2 = jp->getIndex();
-           // the following is obsolete 
-           //bulk2 = ep->getIndexElementContainsEdge ( globdat, p1, p2 );
+// collect the interface elements of the tasks (elements or faces)
+// [0,taskCount) and add them. With --stream this is done in rounds of
+// STREAM_TASKS tasks per worker, every round going to the interface
+// stream before the next one is collected, so that only the elements
+// of one round are held in memory.
 
-           //cout<< "bulk1 and bulk2: " <<  bulk1 << " " << bulk2 << " " << jp->getIndex() << endl;
-           //bulk1 = globdat.elemId2Position[bulk1];
-           //bulk2 = globdat.elemId2Position[bulk2];
+static const int   STREAM_TASKS = 1 << 14;
 
-           globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0,
-                   interConnec, bulk1, bulk2 ) ) );
-      
-           ieCount++;
+template <class Collect>
+static void buildChunks
 
-           if       ( ( globdat.nodeSet[o1]->getIsInterface() ) && ( globdat.nodeSet[o2]->getIsInterface() ) )
-           {
-             globdat.interfaceMats.push_back ( globdat.nodeMaterial[o1] );
-           }
-           else if  ( globdat.nodeSet[o1]->getIsInterface() )
-           {
-             globdat.interfaceMats.push_back ( globdat.nodeMaterial[o2] );
-           }
-           else
-           {
-             globdat.interfaceMats.push_back ( globdat.nodeMaterial[o1] );
-           }
+  ( int                      taskCount,
+    int                      workerCount,
+    bool                     isResolved,
+    const Collect&           collect,
+    Global&                  globdat )
+{
+  vector<InterfaceChunk>  chunks;
 
-           doneEdges.push_back ( NodePair(n1,n2) );
+  const int               round = globdat.interfaceStream ?
+                                  std::max ( workerCount, 1 ) * STREAM_TASKS : taskCount;
 
-	   break; // only have ONE edge in common
-	 }
-      }
-    }
+  for ( int first = 0; first < taskCount; first += round )
+  {
+    collectChunks ( chunks, first, std::min ( first + round, taskCount ), workerCount, collect );
+    addChunks     ( chunks, isResolved, globdat );
   }
 }
 
 // ---------------------------------------------------------
-//   doForEverywhere2D
+//   collectEdges2D
 // ---------------------------------------------------------
 
-void   InterfaceBuilder::doForEverywhere2D ( Global& globdat )
+// interface elements along the edges of the elements first ... last-1
+// and boundary elements on their boundary edges. isDomain: interface
+// elements get the material of their nodes, otherwise 1 on material
+// interfaces and 0 elsewhere. isResolved: this is the only chunk,
+// mark the edges done here.
+
+template <class Traits>
+static void collectEdges2D
+
+  ( InterfaceChunk&  chunk,
+    int              first,
+    int              last,
+    bool             isDomain,
+    bool             isResolved,
+    Global&          globdat )
 {
-  int              neiCount;
-  int              nnode;
+  const int        corners   = Traits::cornerCount;
+  const int        nodeCount = globdat.nodeICount;   // nodes per interface element
+  const int        bndCount  = globdat.nodeICount/2; // nodes per boundary element
+
   int              n1,n2,n12;
   int              m1,m2;
   int              o1,o2;
   int              p1,p2,p12;
-  int              ielem, jelem, ieCount(0), bieCount(0);
-  int              npId;
-  int              bulk1, bulk2;
+  int              ka,kb;
+  int              npId, edge;
 
-  ElemPointer      ep,jp;
-  
-  IntVector        inodes, inodes0, inodes00, inodesC, inodesF;
-  IntVector        jnodes, jnodes0;
-  IntVector        interConnec(globdat.nodeICount);
-  IntVector        flowConnec (globdat.nodeICount/2);
-  IntVector        bndElemConn(globdat.nodeICount/2);
-  IntVector        neighbors;
-  vector<NodePair> doneEdges;   // list of edges already done
+  int              interConnec[2*Traits::nodesPerEdge];
+  int              bndElemConn[  Traits::nodesPerEdge];
 
+  ElemPointer      ep,jp;
 
-  IntVector::const_iterator it1, it2, it12;
-  vector<NodePair>::const_iterator npIt;
-  
-  cout << " do everywhere for 2D mesh...\n";
+  IntSpan          inodes, inodes0;
+  IntSpan          jnodes, jnodes0;
+  IntSpan          neighbors;
 
-  const  int        elemCount = globdat.elemSet.size ();
+  IntSpan::const_iterator   it1, it2, it12;
 
+  EdgeTable&       edges     = globdat.edgeTable;
 
-  for ( int ie = 0; ie < elemCount; ie++ )       // loop over solid elements
+  for ( int ie = first; ie < last; ie++ )        // loop over solid elements
   {
-    ep    = globdat.elemSet[ie];
-    ielem = ep->getIndex();
+    ep      = globdat.elemSet[ie];
 
-    ep->getConnectivity        ( inodes  );      // modified connectivity 
-    ep->getCornerConnectivity0 ( inodes0 );      // original corner connectivity
-    //inodes00 = inodes0;
+    inodes  = ep->getConnectivity  ();           // modified connectivity
+    inodes0 = ep->getConnectivity0 ();           // original connectivity
 
-    if (globdat.isQuadratic)
-    {
-       ep->getConnectivity0       ( inodesF );
-       ep->getCornerConnectivity  ( inodesC );
-       inodesC.push_back (inodesC[0]);
-    }
-    
-    inodes .push_back ( inodes [0] );     // add first node to make a closed loop
-    inodes0.push_back ( inodes0[0] );     // => edges 
-
-    nnode = inodes0.size();               // # of nodes + 1, e.g. T3 elem => nnode = 4
-
-    neighbors = globdat.elemNeighbors[ie]; 
-    neiCount  = neighbors.size ();
-    
-    //cout << "doing element " << ie+1 << ":\n ";
-   // print ( neighbors.begin(), neighbors.end() );
+    neighbors = globdat.elemNeighbors.getNeighbors ( ie );
 
     // loop over edges, add interface along common edge
 
-    for ( int in = 0; in < nnode-1; in++ )
+    for ( int in = 0; in < corners; in++ )
     {
       // indices of two nodes making the edge (original mesh)
+      // and of the midside node
 
-      n1 = inodes0[in];
-      n2 = inodes0[in+1];
+      ka = Traits::edges.nodes[in][0];
+      kb = Traits::edges.nodes[in][1];
 
-      if (globdat.isQuadratic) n12 = inodesF[nnode-1+in];
-      
-      //cout << "edge (" << n1 << "," << n2 << ")" << endl;
+      n1 = inodes0[ka];
+      n2 = inodes0[kb];
+
+      if constexpr ( Traits::isQuadratic ) n12 = inodes0[corners + in];
 
       // get number of elements around these nodes
-      o1 = globdat.nodeId2Position[n1];
-      o2 = globdat.nodeId2Position[n2];
-      m1 = globdat.nodeSet[o1]->getDuplicity ();
-      m2 = globdat.nodeSet[o2]->getDuplicity ();
-      
+
+      o1 = globdat.nodeId2Position.get ( n1 );
+      o2 = globdat.nodeId2Position.get ( n2 );
+      m1 = globdat.nodeSet.getDuplicity ( o1 );
+      m2 = globdat.nodeSet.getDuplicity ( o2 );
+
       // edge on external boundary, also omitted
       // build boundary elements to apply tractions
       // this must be done before the next if command.
-      
-      npIt = find ( globdat.nodePairs.begin(), globdat.nodePairs.end(), NodePair(n1,n2) ); 
 
-      if ( npIt != globdat.nodePairs.end() )
+      edge = edges.getEdgeId ( ie, in );
+
+      if ( edges.isOnBoundary ( edge ) )
       {
-         //cout << "edge (" << n1 << "," << n2 << ")" << endl;
-         npId = globdat.bndElemsDomain[npIt - globdat.nodePairs.begin()];
+         npId = edges.getBoundaryDomain ( edge );
 
-         if (!globdat.isQuadratic)
+         if constexpr ( !Traits::isQuadratic )
          {
-           bndElemConn[0] = inodes[in];
-           bndElemConn[1] = inodes[in+1];
+           bndElemConn[0] = inodes[ka];
+           bndElemConn[1] = inodes[kb];
          }
          else
          {
-           bndElemConn[0] = inodesC[in];
-           bndElemConn[1] = inodes[nnode-1+in];
-           bndElemConn[2] = inodesC[in+1];
+           bndElemConn[0] = inodes[ka];
+           bndElemConn[1] = inodes[corners + in];
+           bndElemConn[2] = inodes[kb];
          }
-	
-         globdat.bndElementSet.push_back ( ElemPointer ( new Element ( bieCount, bndElemConn ) ) );
-         globdat.dom2BndElems[npId].push_back ( bieCount++ );
+
+         chunk.bndConnec.insert ( chunk.bndConnec.end(),
+                                  bndElemConn, bndElemConn + bndCount );
+         chunk.bndDomains.push_back ( npId );
 
 	     continue;
       }
@@ -899,478 +851,367 @@ void   InterfaceBuilder::doForEverywhere2D ( Global& globdat )
       // not a common edge (or not an interelement boundary), omits
       // This check cannot detect edges on the boundary!!!
       // Therefore, in geo file, must define boundaries as physical quantities.
-      
+
       if ( ( m1 == 0 ) || ( m2 == 0 ) ) continue;
       if ( ( m1 == 1 ) || ( m2 == 1 ) ) continue;
 
       // ignore edge already added
 
-      if ( find ( doneEdges.begin(), 
-		          doneEdges.end  (), 
-		          NodePair(n1,n2) ) != doneEdges.end() )
+      if ( edges.isDone ( edge ) )
       {
 	    continue;
       }
-	
+
       // existing notch
-      
+
       if ( globdat.isNotch )
       {
-        bool val1, val2;
+        bool val1(false), val2(false);
 
-        double x1 = globdat.nodeSet[o1]->getX ();
-        double y1 = globdat.nodeSet[o1]->getY ();
+        double x1 = globdat.nodeSet.getX ( o1 );
+        double y1 = globdat.nodeSet.getY ( o1 );
 
-        double x2 = globdat.nodeSet[o2]->getX ();
-        double y2 = globdat.nodeSet[o2]->getY ();
+        double x2 = globdat.nodeSet.getX ( o2 );
+        double y2 = globdat.nodeSet.getY ( o2 );
 
-        for ( int is = 0; is < globdat.segment.size(); is++ )
+        for ( size_t is = 0; is < globdat.segment.size(); is++ )
         {
           val1 = globdat.segment[is].isOn ( x1, y1 );
           val2 = globdat.segment[is].isOn ( x2, y2 );
 
-          //cout << x1 << " " << y1 << " " << x2 << " " << y2 << endl;
-          //cout << globdat.segment[is] << endl;
-
           if ( val1 && val2 ) {
             break;
           }
 
+          if ( isDomain ) continue;
+
           // if the node coincide with the vertices of the segment
           // then isOn fails to detect that, additional check below is needed
 
           if ( val1  && !val2 )
           {
-            cout << globdat.segment[is] << endl;
-            cout << x1 << " " << y1 << " " << x2 << " " << y2 << endl;
-            cout << "point1 on\n"; 
             if ( ( fabs(x2-globdat.segment[is].p1.x) < 1e-7  &&  fabs(y2-globdat.segment[is].p1.y) < 1e-7 )  ||
                  ( fabs(x2-globdat.segment[is].p2.x) < 1e-7  &&  fabs(y2-globdat.segment[is].p2.y) < 1e-7 )  )
             {
               val2 = true;
-              break; 
+              break;
             }
           }
           if ( val2 && !val1 )
           {
-            cout << globdat.segment[is] << endl;
-            cout << x1 << " " << y1 << " " << x2 << " " << y2 << endl;
-            cout << "point2 on\n"; 
             if ( ( fabs(x1-globdat.segment[is].p1.x) < 1e-7  &&  fabs(y1-globdat.segment[is].p1.y) < 1e-7 )  ||
-                 ( fabs(x1-globdat.segment[is].p2.x) < 1e-7  &&  fabs(y1-globdat.segment[is].p2.y) < 1e-7 )  ) 
+                 ( fabs(x1-globdat.segment[is].p2.x) < 1e-7  &&  fabs(y1-globdat.segment[is].p2.y) < 1e-7 )  )
             {
               val1 = true;
-              break; 
+              break;
             }
           }
         }
 
         if ( val1 && val2 ) break; // do not add interface on existing notch
       }
-	
-      //int mat = globdat.elem2Domain[ielem];
-
-      //if (  inodes == inodes00  )
-      //{
-      //  interConnec[0] = n1;
-      //  interConnec[1] = n2;
-      //}
-      //else
-      //{
-      //  interConnec[0] = inodes[in];
-      //  interConnec[1] = inodes[in+1];
-      //}
-
-      if (!globdat.isQuadratic)
+
+      // note that for corner nodes, using the corner connectivity
+      // for the midside nodes, using the full connectivity
+
+      if constexpr ( !Traits::isQuadratic )
       {
-        interConnec[0] = inodes[in];
-        interConnec[1] = inodes[in+1];
+        interConnec[0] = inodes[ka];
+        interConnec[1] = inodes[kb];
       }
       else
       {
-        interConnec[0] = inodesC[in];
-        interConnec[1] = inodes[nnode-1+in];
-        interConnec[2] = inodesC[in+1];
+        interConnec[0] = inodes[ka];
+        interConnec[1] = inodes[corners + in];
+        interConnec[2] = inodes[kb];
       }
 
-      // loop over neighbors of element ie
+      // loop over the edge neighbors of element ie
 
-      for ( int je = 0; je < neiCount; je++ )
+      for ( int je = 0; je < neighbors.size (); je++ )
       {
-	    jelem = globdat.elemId2Position[neighbors[je]];
-	    jp    = globdat.elemSet[jelem];
-
-	    if ( jp->getIndex() == ielem ) continue;    // skip element ielem 
-
-	    jp->getConnectivity  ( jnodes  );           // modified connectivity
-	    jp->getConnectivity0 ( jnodes0 );           // original connectivity
+	    jp      = globdat.elemSet[neighbors[je]];
 
-	    //print ( jnodes0.begin(), jnodes0.end() );
+	    jnodes  = jp->getConnectivity  ();           // modified connectivity
+	    jnodes0 = jp->getConnectivity0 ();           // original connectivity
 
 	    it1 = find ( jnodes0.begin(), jnodes0.end(), n1 );
 	    it2 = find ( jnodes0.begin(), jnodes0.end(), n2 );
 
-         // find n1,n2 are present in jnodes0, an interelement boundary found
+        // find n1,n2 are present in jnodes0, an interelement boundary found
 
-	    if ( ( it1 != jnodes0.end() ) && ( it2 != jnodes0.end() ) )
-	    {
-	      p1 = jnodes[it1 - jnodes0.begin()];
-	      p2 = jnodes[it2 - jnodes0.begin()];
+	    if ( ( it1 == jnodes0.end() ) || ( it2 == jnodes0.end() ) ) continue;
 
-          if (globdat.isQuadratic)
-          {
-            it12 = find ( jnodes0.begin(), jnodes0.end(), n12 );
-            p12  = jnodes[it12 - jnodes0.begin()];
-          }
+	    p1 = jnodes[it1 - jnodes0.begin()];
+	    p2 = jnodes[it2 - jnodes0.begin()];
+
+        if constexpr ( !Traits::isQuadratic )
+        {
+          interConnec[2] = p1;
+          interConnec[3] = p2;
+        }
+        else
+        {
+          it12 = find ( jnodes0.begin(), jnodes0.end(), n12 );
+          p12  = jnodes[it12 - jnodes0.begin()];
 
-	      //cout << " found common edge: (" << p1 << "," << p2 << ")" << endl;
+          interConnec[3] = p1;
+          interConnec[4] = p12;
+          interConnec[5] = p2;
+        }
 
-          if (!globdat.isQuadratic)
+        chunk.connec.insert ( chunk.connec.end(),
+                              interConnec, interConnec + nodeCount );
+        chunk.bulks.push_back ( ep->getIndex() );
+        chunk.bulks.push_back ( jp->getIndex() );
+        chunk.edges.push_back ( edge );
+
+        if ( isDomain )
+        {
+          if       ( ( globdat.nodeSet.getIsInterface ( o1 ) ) && ( globdat.nodeSet.getIsInterface ( o2 ) ) )
+          {
+            chunk.mats.push_back ( globdat.nodeMaterial[o1] );
+          }
+          else if  ( globdat.nodeSet.getIsInterface ( o1 ) )
           {
-            interConnec[2] = p1;
-            interConnec[3] = p2;
+            chunk.mats.push_back ( globdat.nodeMaterial[o2] );
           }
           else
           {
-            interConnec[3] = p1;
-            interConnec[4] = p12;
-            interConnec[5] = p2;
+            chunk.mats.push_back ( globdat.nodeMaterial[o1] );
           }
-
-          bulk1 = ielem;
-          bulk2 = jp->getIndex();
-              //bulk2 = ep->getIndexElementContainsEdge ( globdat, p1, p2 );
-
-              //cout<< "bulk1 and bulk2: " <<  bulk1 << " " << bulk2 << endl;
-              //bulk1 = globdat.elemId2Position[bulk1];
-              //bulk2 = globdat.elemId2Position[bulk2];
-
-          globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0,
-                  interConnec, bulk1, bulk2 ) ) );
-       
-          ieCount++;
-
-          if ( ( globdat.nodeSet[o1]->getIsInterface() ) && 
-               ( globdat.nodeSet[o2]->getIsInterface() ) )
+        }
+        else
+        {
+          if ( ( globdat.nodeSet.getIsInterface ( o1 ) ) &&
+               ( globdat.nodeSet.getIsInterface ( o2 ) ) )
           {
-            globdat.interfaceMats.push_back ( 1 );
+            chunk.mats.push_back ( 1 );
           }
           else
           {
-            globdat.interfaceMats.push_back ( 0 );
+            chunk.mats.push_back ( 0 );
           }
 
-          doneEdges.push_back ( NodePair(n1,n2) );
-
-  
           if ( globdat.isHydraulic )
           {
-              flowConnec[0] = globdat.flowNodes[o1];
-              flowConnec[1] = globdat.flowNodes[o2];
-          
-              globdat.flowElemSet.push_back ( ElemPointer ( new Element ( ieCount, 0, flowConnec ) ) );
+            chunk.flowConnec.push_back ( globdat.flowNodes[o1] );
+            chunk.flowConnec.push_back ( globdat.flowNodes[o2] );
+            chunk.flowConnec.resize    ( chunk.mats.size() * bndCount, 0 );
           }
+        }
 
-	      break; // only have ONE edge in common
-	    }
+        if ( isResolved ) edges.setDone ( edge );
+
+	    break; // only have ONE edge in common
       }
     }
   }
-
-  cout << ieCount << " interface elements added\n";
 }
 
 // ---------------------------------------------------------
-//   doForDomain3D
+//   doForDomain2D
 // ---------------------------------------------------------
 
-void   InterfaceBuilder::doForDomain3D ( Global& globdat )
+void   InterfaceBuilder::doForDomain2D ( Global& globdat )
 {
-  ElemPointer        ip, jp;
-
-  int                ielem, jelem;
-  int                faceCount, neiCount;
-  int                nodeCount; // # nodes per face
-  int                n, ieCount(0);
-  int                bulk1, bulk2;
-  int                oppVertex;
-  int                imat;
-  
-  IntVector          face, sface, fface, fface0;
-  IntVector          dface, dfaceu, dupNodes;
-  IntVector          interConnec(globdat.nodeICount);
-  IntVector          neighbors;
-  vector<IntVector>  ifaces0, jfaces, jfaces0, jffaces, doneFaces;
-  
-  vector<IntVector>::const_iterator it;
-  IntVector        ::const_iterator iit;
+  const  int        elemCount = globdat.elemSet.size ();
 
-  const  int         elemCount = globdat.elemSet.size ();
-                     nodeCount = globdat.nodeICount/2;
+  const  int        workers   = globdat.threadCount;
 
-  // loop over elements
+  globdat.edgeTable.resetDone ();
 
-  for ( int ie = 0; ie < elemCount; ie++ )
+  dispatch2D ( globdat.elemSet[0]->getElemType (), [&] ( auto traits )
   {
-    ip    = globdat.elemSet[ie];
-    ielem = ip->getIndex ();
-      
-    ip->getSortedFaces0 ( ifaces0 );            // faces of original mesh of element "ie"
-
-    // loop over faces
-
-    faceCount = ifaces0.size ( );
-
-    //cout <<  " element: " << ie << "\n";
+    typedef decltype ( traits )  Traits;
 
-    for ( int kf = 0; kf < faceCount; kf++ )
+    buildChunks ( elemCount, workers, workers == 1,
+                  [&] ( InterfaceChunk& chunk, int first, int last )
     {
-      face. resize ( nodeCount );
-      face  = ifaces0[kf];
-
-      oppVertex = ip->getOppVertex ( kf );
-
-      // omit face already handled
-
-      if ( find ( doneFaces.begin(), doneFaces.end  (), face ) != doneFaces.end() )
-      {
-	    continue;
-      }
-
-      if ( ip->isOnExternalBoundary ( kf, globdat ) )  continue;
-      if ( ip->isUniqueFace         ( kf, globdat ) )  continue;
-            
-      // upper face of the interface element
-
-      ip->getFullFace0 ( fface0, kf );
-      ip->getFullFace  ( fface,  kf );
-
-      for ( int in = 0; in < fface.size(); in++ )
-      {
-         n                          = fface[in];
-	     interConnec[in]            = n;
-      }
-	      
-      neighbors = globdat.elemNeighbors[ie]; 
-      neiCount  = neighbors.size ();
+      collectEdges2D<Traits> ( chunk, first, last, true, workers == 1, globdat );
+    }, globdat );
+  } );
+}
 
-      // loop over neighbors of element ie
+// ---------------------------------------------------------
+//   doForEverywhere2D
+// ---------------------------------------------------------
 
-      for ( int je = 0; je < neiCount; je++ )
-      {
-	    jelem = globdat.elemId2Position[neighbors[je]];
-	    jp    = globdat.elemSet[jelem];
-
-	    if ( jp->getIndex() == ielem ) continue; // omit element being considered
-
-	    // find common face
-
-	    jp->getSortedFaces0        ( jfaces0  );  // original sorted faces
-	    jp->getSortedFaces         ( jfaces   );  // original sorted faces
-	    jp->getFFaces              ( jffaces  );  // modified full faces (work also for quadratic elems)
-
-	    // common face between ielem and jelem found
-	 
-         it = find ( jfaces0.begin(), jfaces0.end  (), face );
-
-	     if ( it != jfaces0.end() )
-	     {
-                //cout <<  " found common face: " << jp->getIndex() << "\n";
-	        
-            dface  = jffaces[it - jfaces0.begin()];
-	        dfaceu = jfaces [it - jfaces0.begin()];
-
-            for ( int in = 0; in < nodeCount; in++ )
-	        {
-              dupNodes = globdat.duplicatedNodes0[fface0[in]]; 
-              int dupNodeCount = dupNodes.size();
-              for ( int id = 0; id < dupNodeCount; id++ )
-              {
-                  iit  = find ( dface.begin(), dface.end  (), dupNodes[id] );
-                  if ( iit != dface.end() )
-                  {
-                     n = *iit;
-                     break;
-                  }
-              }
-	          interConnec[in+nodeCount]  = n;
-	        }
-          
-            // insert this interface 
-           
-            bulk1 = ip->getIndex();
-            bulk2 = jp->getIndex();
-            //bulk2 = ip->getIndexElementContainsFace ( globdat, dfaceu );
+void   InterfaceBuilder::doForEverywhere2D ( Global& globdat )
+{
+  cout << " do everywhere for 2D mesh...\n";
 
-            //cout<< "bulk1 and bulk2: " <<  bulk1 << " " << bulk2 << endl;
-            //cout<< " bulk2: " <<   jp->getIndex() << endl;
-            //bulk1 = globdat.elemId2Position[bulk1];
-            //bulk2 = globdat.elemId2Position[bulk2];
+  const  int        elemCount = globdat.elemSet.size ();
 
-            globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0, interConnec, bulk1, bulk2 ) ) );
+  const  int        workers   = globdat.threadCount;
 
-            //print ( interConnec.begin(), interConnec.end() );
-    
-            if ( ip->isInterfacialFace ( kf, globdat ) )
-            {
-               globdat.interfaceMats.push_back    ( globdat.nodeMaterial[face[0]] );
-            }
-            else
-            {
-               globdat.interfaceMats.push_back    (0);
-            }
+  globdat.edgeTable.resetDone ();
 
-            globdat.oppositeVertices.push_back (oppVertex);
-            ieCount++;
+  dispatch2D ( globdat.elemSet[0]->getElemType (), [&] ( auto traits )
+  {
+    typedef decltype ( traits )  Traits;
 
-            doneFaces.push_back ( face );
+    buildChunks ( elemCount, workers, workers == 1,
+                  [&] ( InterfaceChunk& chunk, int first, int last )
+    {
+      collectEdges2D<Traits> ( chunk, first, last, false, workers == 1, globdat );
+    }, globdat );
+  } );
 
-	        break; // only have ONE face in common
-	     }
-      }      // end of loop over neighbors
-    }
-  }
+  cout << ( globdat.interfaceStream ? globdat.interfaceStream->size ()
+                                    : globdat.interfaceSet.size () ) << " interface elements added\n";
 }
 
 // ---------------------------------------------------------
-//   doForEverywhere3D
+//   collectFaces3D
 // ---------------------------------------------------------
 
-void   InterfaceBuilder::doForEverywhere3D ( Global& globdat )
+// interface elements on the interior faces first ... last-1 of the
+// face table. isDomain: faces with a node of duplicity one are
+// omitted, faces on material interfaces get the material of their
+// lowest node (0 otherwise).
+
+template <class Traits>
+static void collectFaces3D
+
+  ( InterfaceChunk&  chunk,
+    int              first,
+    int              last,
+    bool             isDomain,
+    Global&          globdat )
 {
+  const int          nodeCount = Traits::fullPerFace; // # nodes per face
+
   ElemPointer        ip, jp;
 
-  int                ielem, jelem;
-  int                faceCount, neiCount;
-  int                nodeCount; // # nodes per face
-  int                n, ieCount(0);
-  int                bulk1, bulk2;
-  int                oppVertex;
-  
-  IntVector          face, sface, fface, fface0;
-  IntVector          dface, dfaceu, dupNodes;
-  IntVector          interConnec(globdat.nodeICount);
-  IntVector          neighbors;
-  vector<IntVector>  ifaces0, jfaces, jfaces0, jffaces, doneFaces;
-  
-  vector<IntVector>::const_iterator it;
-  IntVector        ::const_iterator iit;
+  int                kf;
+  int                n;
 
-  const  int         elemCount = globdat.elemSet.size ();
-                     nodeCount = globdat.nodeICount/2;
+  IntSpan            face;
+  IntSpan            fface, fface0, dface;
+  int                interConnec[Traits::interfaceNodeCount];
 
-  // loop over elements
+  IntSpan          ::const_iterator iit;
+  Int2IntVectMap   ::const_iterator dit;
 
-  for ( int ie = 0; ie < elemCount; ie++ )
+  const FaceTable&   faces     = globdat.faceTable;
+
+  for ( int iface = first; iface < last; iface++ )
   {
-    ip    = globdat.elemSet[ie];
-    ielem = ip->getIndex ();
+    if ( !faces.isInterior ( iface ) ) continue;
 
-    ip->getSortedFaces0 ( ifaces0 );            // faces of original mesh of element "ie"
+    ip = globdat.elemSet[faces.getElement   ( iface, 0 )];
+    kf =                 faces.getLocalFace ( iface, 0 );
 
-    // loop over faces
+    if (             ip->isOnExternalBoundary ( kf, globdat ) )  continue;
+    if ( isDomain && ip->isUniqueFace         ( kf, globdat ) )  continue;
 
-    faceCount = ifaces0.size ( );
+    // upper face of the interface element
 
-    //cout <<  " element: " << ie << "\n";
+    fface0 = ip->getFullFace0 ( kf );
+    fface  = ip->getFullFace  ( kf );
 
-    for ( int kf = 0; kf < faceCount; kf++ )
+    for ( int in = 0; in < nodeCount; in++ )
     {
-      face. resize ( nodeCount );
-      face  = ifaces0[kf];
+      interConnec[in]            = fface[in];
+    }
 
-      oppVertex = ip->getOppVertex ( kf );
+    n = fface[nodeCount-1];
 
-      // omit face already handled
+    // lower face: modified full face of the element on the other side
+    // (work also for quadratic elems)
 
-      if ( find ( doneFaces.begin(), doneFaces.end  (), face ) != doneFaces.end() )
-      {
-	    continue;
-      }
+    jp    = globdat.elemSet[faces.getElement ( iface, 1 )];
 
-      if ( ip->isOnExternalBoundary ( kf, globdat ) )  continue;
-            
-      // upper face of the interface element
+    dface = jp->getFullFace ( faces.getLocalFace ( iface, 1 ) );
 
-      ip->getFullFace0 ( fface0, kf );
-      ip->getFullFace  ( fface,  kf );
+    for ( int in = 0; in < nodeCount; in++ )
+    {
+      dit = globdat.duplicatedNodes0.find ( fface0[in] );
 
-      for ( int in = 0; in < fface.size(); in++ )
+      if ( dit != globdat.duplicatedNodes0.end() )
       {
-         n                          = fface[in];
-	     interConnec[in]            = n;
-      }
-	      
-      neighbors = globdat.elemNeighbors[ie]; 
-      neiCount  = neighbors.size ();
-
-      // loop over neighbors of element ie
+        const IntVector& dupNodes = dit->second;
 
-      for ( int je = 0; je < neiCount; je++ )
-      {
-	    jelem = globdat.elemId2Position[neighbors[je]];
-	    jp    = globdat.elemSet[jelem];
-
-	    if ( jp->getIndex() == ielem ) continue; // omit element being considered
-
-	    // find common face
-
-	    jp->getSortedFaces0        ( jfaces0  );  // original sorted faces
-	    jp->getSortedFaces         ( jfaces   );  // original sorted faces
-	    jp->getFFaces              ( jffaces  );  // modified full faces (work also for quadratic elems)
-
-	    // common face between ielem and jelem found
-	 
-         it = find ( jfaces0.begin(), jfaces0.end  (), face );
-
-	     if ( it != jfaces0.end() )
-	     {
-                //cout <<  " found common face: " << jp->getIndex() << "\n";
-	        
-            dface  = jffaces[it - jfaces0.begin()];
-	        dfaceu = jfaces [it - jfaces0.begin()];
-
-            for ( int in = 0; in < nodeCount; in++ )
-	        {
-              dupNodes = globdat.duplicatedNodes0[fface0[in]]; 
-              for ( int id = 0; id < dupNodes.size(); id++ )
-              {
-                  iit  = find ( dface.begin(), dface.end  (), dupNodes[id] );
-                  if ( iit != dface.end() )
-                  {
-                     n = *iit;
-                     break;
-                  }
-              }
-	          interConnec[in+nodeCount]  = n;
-	        }
-          
-            // insert this interface 
-           
-            bulk1 = ip->getIndex();
-            bulk2 = jp->getIndex();
-            //bulk2 = ip->getIndexElementContainsFace ( globdat, dfaceu );
+        for ( size_t id = 0; id < dupNodes.size(); id++ )
+        {
+          iit  = find ( dface.begin(), dface.end  (), dupNodes[id] );
+          if ( iit != dface.end() )
+          {
+            n = *iit;
+            break;
+          }
+        }
+      }
+      interConnec[in+nodeCount]  = n;
+    }
 
-            //cout<< "bulk1 and bulk2: " <<  bulk1 << " " << bulk2 << endl;
-            //cout<< " bulk2: " <<   jp->getIndex() << endl;
-            //bulk1 = globdat.elemId2Position[bulk1];
-            //bulk2 = globdat.elemId2Position[bulk2];
+    // insert this interface
 
-            globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, 0, interConnec, bulk1, bulk2 ) ) );
+    chunk.connec.insert ( chunk.connec.end(),
+                          interConnec, interConnec + Traits::interfaceNodeCount );
+    chunk.bulks.push_back ( ip->getIndex() );
+    chunk.bulks.push_back ( jp->getIndex() );
 
-            globdat.interfaceMats.push_back    (0);
-            globdat.oppositeVertices.push_back (oppVertex);
-            ieCount++;
+    if ( isDomain && ip->isInterfacialFace ( kf, globdat ) )
+    {
+      // lowest node of the face
 
-            doneFaces.push_back ( face );
+      face = ip->getFace0 ( kf );
 
-	        break; // only have ONE face in common
-	     }
-      }      // end of loop over neighbors
+      chunk.mats.push_back ( globdat.nodeMaterial[*min_element ( face.begin(), face.end() )] );
     }
+    else
+    {
+      chunk.mats.push_back ( 0 );
+    }
+
+    chunk.oppVertices.push_back ( ip->getOppVertex ( kf ) );
   }
 }
 
+// ---------------------------------------------------------
+//   doForDomain3D
+// ---------------------------------------------------------
+
+void   InterfaceBuilder::doForDomain3D ( Global& globdat )
+{
+  // loop over faces shared by two elements, in the order of the
+  // elements (and their faces) on the first side
+
+  dispatch3D ( globdat.elemSet[0]->getElemType (), [&] ( auto traits )
+  {
+    typedef decltype ( traits )  Traits;
+
+    buildChunks ( globdat.faceTable.faceCount (), globdat.threadCount, true,
+                  [&] ( InterfaceChunk& chunk, int first, int last )
+    {
+      collectFaces3D<Traits> ( chunk, first, last, true, globdat );
+    }, globdat );
+  } );
+}
+
+// ---------------------------------------------------------
+//   doForEverywhere3D
+// ---------------------------------------------------------
+
+void   InterfaceBuilder::doForEverywhere3D ( Global& globdat )
+{
+  // loop over faces shared by two elements, in the order of the
+  // elements (and their faces) on the first side
+
+  dispatch3D ( globdat.elemSet[0]->getElemType (), [&] ( auto traits )
+  {
+    typedef decltype ( traits )  Traits;
+
+    buildChunks ( globdat.faceTable.faceCount (), globdat.threadCount, true,
+                  [&] ( InterfaceChunk& chunk, int first, int last )
+    {
+      collectFaces3D<Traits> ( chunk, first, last, false, globdat );
+    }, globdat );
+  } );
+}
+
 // ---------------------------------------------------------
 //   doFor2DPolycrystal
 // ---------------------------------------------------------
@@ -1381,43 +1222,44 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
   int              p1,p2;
   int              m1,m2;
   int              o1,o2;
-  int              ielem;
   int		       nnode, ieCount = 0;
+  int              edge;
 
   ElemPointer      ep, jp;
   
-  IntVector        inodes0, inodes, inodesF;
+  IntSpan          connec, inodesF;
+  IntVector        inodes0, inodes;
 
   IntVector        interConnec(globdat.nodeICount);
-  IntVector        neighbors;
-
-  vector<NodePair> doneEdges;   
 
   int              ignoredEdgeCount = 0;
 
   const  int       elemCount = globdat.elemSet.size ();
 
+  EdgeTable&       edges     = globdat.edgeTable;
+
+  edges.resetDone ();
+
   cout << elemCount << endl;
 
   for ( int ie = 0; ie < elemCount; ie++ )
   {
      ep    = globdat.elemSet[ie];
-     ielem = ep->getIndex();
 
-     ep->getCornerConnectivity0 ( inodes0 ); 
-     ep->getCornerConnectivity  ( inodes  ); 
+     connec  = ep->getCornerConnectivity0 (); 
+     inodes0.assign ( connec.begin(), connec.end() );
+     connec  = ep->getCornerConnectivity  (); 
+     inodes .assign ( connec.begin(), connec.end() );
 
      if ( globdat.isQuadratic ) 
      {
-       ep->getConnectivity0 ( inodesF ); 
+       inodesF = ep->getConnectivity0 (); 
      }
 
      inodes0.push_back ( inodes0[0] );  
      inodes .push_back ( inodes [0] );  
 
      nnode     = inodes0.size();
- 
-     neighbors = globdat.elemNeighbors[ie]; 
 
      // loop over edges, add interface along common edge
 
@@ -1433,8 +1275,8 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
        o1  = globdat.nodeId2Position[n10];
        o2  = globdat.nodeId2Position[n20];
 
-       m1  = globdat.nodeSet[o1]->getDuplicity ();
-       m2  = globdat.nodeSet[o2]->getDuplicity ();
+       m1  = globdat.nodeSet.getDuplicity ( o1 );
+       m2  = globdat.nodeSet.getDuplicity ( o2 );
 
        // not a common edge, omits
        
@@ -1443,18 +1285,16 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
 
        // edge on external boundary, also omitted
 
-       if ( find ( globdat.nodePairs.begin(), 
-       	           globdat.nodePairs.end  (), 
-       	           NodePair(n10,n20) ) != globdat.nodePairs.end() )
+       edge = edges.getEdgeId ( ie, in );
+
+       if ( edges.isOnBoundary ( edge ) )
        {
          continue;
        }
 
        // ignore edge already added
 
-       if ( find ( doneEdges.begin(), 
-       	           doneEdges.end  (), 
-       	           NodePair(n10,n20) ) != doneEdges.end() )
+       if ( edges.isDone ( edge ) )
        {
          break;
        }
@@ -1472,11 +1312,11 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
        
        if ( globdat.isNotch )
        {
-         double x1 = globdat.nodeSet[o1]->getX ();
-         double y1 = globdat.nodeSet[o1]->getY ();
+         double x1 = globdat.nodeSet.getX ( o1 );
+         double y1 = globdat.nodeSet.getY ( o1 );
 
-         double x2 = globdat.nodeSet[o2]->getX ();
-         double y2 = globdat.nodeSet[o2]->getY ();
+         double x2 = globdat.nodeSet.getX ( o2 );
+         double y2 = globdat.nodeSet.getY ( o2 );
 
          bool val1 = globdat.segment[0].isOn ( x1, y1 );
          bool val2 = globdat.segment[0].isOn ( x2, y2 );
@@ -1515,7 +1355,7 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
                //cout << n1 << " p1 (" << x1 << "," << y1 << ")\n";
                //cout << n2 << " p2 (" << x2 << "," << y2 << ")\n\n";
 
-           doneEdges.push_back ( NodePair(n10,n20) );
+           edges.setDone ( edge );
            ignoredEdgeCount++;
 
            break;
@@ -1532,7 +1372,7 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
        }
        else if  ( m1 == 3 || m2 == 3 || m1 == 4 || m2 == 4 ) // junction node
        {
-         findCommonEdge ( p1, p2, n10, n20, ielem, neighbors, globdat );
+         findCommonEdge ( p1, p2, n10, n20, ie, globdat );
 
          if ( ep->getChanged() )
          {
@@ -1553,17 +1393,23 @@ void   InterfaceBuilder::doFor2DPolycrystal ( Global& globdat )
        else
        {
          cerr << "Impossible for this case to happen (assumed a triple junction)!!!\n";
-         exit(1);
+         globdat.error = "polycrystal node shared by more than four grains";
+         return;
        }
 
-       globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, interConnec ) )
-       			       );
+       globdat.interfaceSet.addElement ( ieCount, interConnec );
   
        //cout << "one interface element added"  << endl; 
 
        globdat.interfaceMats.push_back (0);
        ieCount++;
-       doneEdges.push_back ( NodePair(n1,n2) );
+
+       // (n1,n2) is the torn edge: it is an edge of the original mesh
+       // only if the element was not changed
+
+       edge = edges.findEdge ( n1, n2 );
+
+       if ( edge >= 0 ) edges.setDone ( edge );
     }
   }
 
@@ -1582,13 +1428,13 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
   IntVector          face, sface;
   IntVector          interConnec;
   IntVector          neighbors;
-  IntVector          inodes, inodes0;
+  IntSpan            inodes, inodes0;
 
-  vector<IntVector>  doneFaces;
+  FaceTable&         faces = globdat.faceTable;
 
   int                nodeCount;
   int                ieCount(0);
-  int                ielem, m, n, mat;
+  int                m, n, mat;
   int                oppVertex, fIndex;
 
   bool               isOnInterface;
@@ -1598,10 +1444,11 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
   
   cout << " ...for 3D polycrystal : \n";
 
+  faces.resetDone ();
+
   for ( int ie = 0; ie < elemCount; ie++ )
   {
     ip    = globdat.elemSet[ie];
-    ielem = ip->getIndex ();
 
     cout << " ...for 3D polycrystal0 : \n";
     cout << ip->getElemType() << "\n";
@@ -1612,8 +1459,8 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
   
     cout << " ...for 3D polycrystal1 : \n";
 
-    ip->getConnectivity  ( inodes  );
-    ip->getConnectivity0 ( inodes0 );
+    inodes  = ip->getConnectivity  ();
+    inodes0 = ip->getConnectivity0 ();
 
     if ( isOnInterface )
     {
@@ -1630,7 +1477,7 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
       for ( int in = 0; in < nodeCount; in++ )
       {
         m    = face[in];
-        mat  = globdat.nodeSet[globdat.nodeId2Position[m]]->getDuplicity();
+        mat  = globdat.nodeSet.getDuplicity ( globdat.nodeId2Position[m] );
 
         if ( mat == 3 ) 
         {
@@ -1647,8 +1494,8 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
 	int    n1   = face[0];
 	int    n2   = face[1];
 
-        double x1   = globdat.nodeSet[globdat.nodeId2Position[n1]]->getX ();
-        double x2   = globdat.nodeSet[globdat.nodeId2Position[n2]]->getX ();
+        double x1   = globdat.nodeSet.getX ( globdat.nodeId2Position[n1] );
+        double x2   = globdat.nodeSet.getX ( globdat.nodeId2Position[n2] );
 
 	double x = x1 > x2 ? x1 : x2;
 
@@ -1661,9 +1508,9 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
       sface = face;
       sort ( sface.begin(), sface.end() );
 
-      if ( find ( doneFaces.begin(),
-	          doneFaces.end  (), 
-		  sface ) != doneFaces.end() )
+      const int  faceId = faces.getFaceId ( ie, fIndex );
+
+      if ( faces.isDone ( faceId ) )
       {
 	continue;
       }
@@ -1681,8 +1528,8 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
       }
       else
       {
-	IntVector           neighbors;
-	IntVector           jnodes,jnodes0;
+	IntSpan             neighbors;
+	IntSpan             jnodes,jnodes0;
 	vector<IntVector>   jfaces;
 
 	int                 neiCount, jelem;
@@ -1691,13 +1538,13 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
 
 	ElemPointer         jp;
 
-        IntVector::const_iterator it1, it2, it3, it0, itE;
+        IntSpan::const_iterator   it1, it2, it3, it0, itE;
 
 	m1 = face[0];
 	m2 = face[1];
 	m3 = face[2];
 
-	if ( inodes == inodes0 ) 
+	if ( equal ( inodes.begin(), inodes.end(), inodes0.begin() ) ) 
 	{
 	  interConnec[0] = m1;
 	  interConnec[1] = m2;
@@ -1717,25 +1564,21 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
 	  interConnec[2] = inodes[it3-it0];
 	}
 
-	neighbors = globdat.elemNeighbors[ie]; 
+	neighbors = globdat.elemNeighbors.getNeighbors ( ie ); 
         neiCount  = neighbors.size ();
 
-        // loop over neighbors of element ie
+        // loop over the face neighbors of element ie
 
 	for ( int je = 0; je < neiCount; je++ )
 	{
-	   jelem = globdat.elemId2Position[neighbors[je]];
+	   jelem = neighbors[je];
 	   jp    = globdat.elemSet[jelem];
 
-	   // omit element being considered
-
-	   if ( jp->getIndex() == ielem ) continue; 
-
 	   // find common face
 
 	   jp->getSortedFaces   ( jfaces  );
-	   jp->getConnectivity  ( jnodes  );
-	   jp->getConnectivity0 ( jnodes0 );
+	   jnodes  = jp->getConnectivity  ();
+	   jnodes0 = jp->getConnectivity0 ();
 
 	   // common face between ielem and jelem found
 
@@ -1763,13 +1606,13 @@ void   InterfaceBuilder::doFor3DPolycrystal ( Global& globdat )
 
       // insert this interface 
 
-      globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, interConnec ) ) );
+      globdat.interfaceSet.addElement ( ieCount, interConnec );
 
       globdat.interfaceMats.push_back    (0);
       globdat.oppositeVertices.push_back (oppVertex);
       ieCount++;
 
-      doneFaces.push_back ( sface );
+      faces.setDone ( faceId );
     }
   }
 }
@@ -1866,8 +1709,8 @@ void  addDiscreteInterface
     {
       bool val1;
 
-      double x1 = globdat.nodeSet[o1]->getX ();
-      double y1 = globdat.nodeSet[o1]->getY ();
+      double x1 = globdat.nodeSet.getX ( o1 );
+      double y1 = globdat.nodeSet.getY ( o1 );
 
       for ( int is = 0; is < globdat.segment.size(); is++ )
       {
@@ -1881,7 +1724,7 @@ void  addDiscreteInterface
     interConnec[0] = globdat.duplicatedNodes0[index][0] ;
     interConnec[1] = globdat.duplicatedNodes0[index][1] ;
          
-    globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, interConnec ) ) );
+    globdat.interfaceSet.addElement ( ieCount, interConnec );
        
     globdat.interfaceMats.push_back (0);
     ieCount++;
@@ -1904,24 +1747,29 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
 
   ElemPointer      ep;
   
-  IntVector        connec, inodes0, edge1, edge2, edge3, edge4;
+  IntSpan          connec;
+  IntVector        inodes0, edge1, edge2, edge3, edge4;
   IntVector        interConnec;
   IntVector        interConnec1, interConnec2;
   vector< vector<int> > edges;
 
-  vector<NodePair> doneEdges;   // list of edges already done
   set<int>         doneNodes;   // list of edges already done
   doneNodes.insert(-1);
 
   const  int       elemCount = globdat.elemSet.size ();
          int       numNode;
          int       order;
+         int       edge;
+
+  EdgeTable&       edgeTable = globdat.edgeTable;
+
+  edgeTable.resetDone ();
 
   for ( int ie = 0; ie < elemCount; ie++ )
   {
      ep    = globdat.elemSet[ie];
 
-     ep->getConnectivity0 ( connec );
+     connec = ep->getConnectivity0 ();
 
      numNode = connec.size ();
 
@@ -2145,8 +1993,8 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
        o1 = globdat.nodeId2Position[n1];
        o2 = globdat.nodeId2Position[n2];
 
-       m1 = globdat.nodeSet[o1]->getDuplicity ();
-       m2 = globdat.nodeSet[o2]->getDuplicity ();
+       m1 = globdat.nodeSet.getDuplicity ( o1 );
+       m2 = globdat.nodeSet.getDuplicity ( o2 );
 
        // not a common edge, omits
 
@@ -2154,19 +2002,19 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
        if ( ( m1 == 1 ) || ( m2 == 1 ) ) continue;
 
        // edge on external boundary, also omitted
+       // (the corners of a NURBS element are not those of its
+       // connectivity, so its edges are looked up by their nodes)
 
-       if ( find ( globdat.nodePairs.begin(), 
-       	           globdat.nodePairs.end  (), 
-       	           NodePair(n1,n2) ) != globdat.nodePairs.end() )
+       edge = edgeTable.addEdge ( n1, n2 );
+
+       if ( edgeTable.isOnBoundary ( edge ) )
        {
          continue;
        }
 
        // ignore edge already added
 
-       if ( find ( doneEdges.begin(), 
-       	           doneEdges.end  (), 
-       	           NodePair(n1,n2) ) != doneEdges.end() )
+       if ( edgeTable.isDone ( edge ) )
        {
          break;
        }
@@ -2175,13 +2023,13 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
 
        if ( globdat.isNotch )
        {
-         bool val1, val2;
+         bool val1(false), val2(false);
 
-         double x1 = globdat.nodeSet[o1]->getX ();
-         double y1 = globdat.nodeSet[o1]->getY ();
+         double x1 = globdat.nodeSet.getX ( o1 );
+         double y1 = globdat.nodeSet.getY ( o1 );
 
-         double x2 = globdat.nodeSet[o2]->getX ();
-         double y2 = globdat.nodeSet[o2]->getY ();
+         double x2 = globdat.nodeSet.getX ( o2 );
+         double y2 = globdat.nodeSet.getY ( o2 );
 
          for ( int is = 0; is < globdat.segment.size(); is++ )
          {
@@ -2206,7 +2054,7 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
        if ( ss > 2 )
        {
          o1 = globdat.nodeId2Position[interConnec1[1]];
-         m1 = globdat.nodeSet[o1]->getDuplicity ();
+         m1 = globdat.nodeSet.getDuplicity ( o1 );
 	 if ( m1 == 0 || m1 == 1 ) continue;
        }
 
@@ -2240,12 +2088,12 @@ void   InterfaceBuilder::doFor2DMatInterfaceNURBS ( Global& globdat )
          }
        //}
 
-       globdat.interfaceSet.push_back ( ElemPointer ( new Element ( ieCount, interConnec ) ) );
+       globdat.interfaceSet.addElement ( ieCount, interConnec );
        
        globdat.interfaceMats.push_back (0);
        ieCount++;
 
-       doneEdges.push_back ( NodePair(n1,n2) );
+       edgeTable.setDone ( edge );
     }
 
     edge1.clear();
@@ -2325,36 +2173,29 @@ void                     findCommonEdge
 	   int&               p2,
 	   int                n1,
 	   int                n2,
-	   int                ielem,
-	   const IntVector&   neighbors,
+	   int                ie,
 	   Global&            globdat )
 
 {
-  IntVector                 jnodes, jnodes0;
-  IntVector::const_iterator it1, it2;
+  IntSpan                   jnodes, jnodes0;
+  IntSpan::const_iterator   it1, it2;
 
   ElemPointer               jp;
 
   int                       jelem;
 
-  const int                 neiCount = neighbors.size ();
+  const IntSpan             neighbors = globdat.elemNeighbors.getNeighbors ( ie );
+  const int                 neiCount  = neighbors.size ();
 
-  // loop over neighbors of element ie
+  // loop over the edge neighbors of element ie
 
   for ( int je = 0; je < neiCount; je++ )
   {
-     jelem = globdat.elemId2Position[neighbors[je]];
+     jelem = neighbors[je];
      jp    = globdat.elemSet[jelem];
 
-     // omit element being considered
-
-     if ( jp->getIndex() == ielem ) 
-     {
-       continue; 
-     }
-
-     jp->getCornerConnectivity  ( jnodes  );
-     jp->getCornerConnectivity0 ( jnodes0 );
+     jnodes  = jp->getCornerConnectivity  ();
+     jnodes0 = jp->getCornerConnectivity0 ();
 
      it1 = find ( jnodes0.begin(), jnodes0.end(), n1 );
      it2 = find ( jnodes0.begin(), jnodes0.end(), n2 );
@@ -16,7 +16,9 @@ class  InterfaceBuilder
 {
   public:
 
-    static    void       doIt 
+    // false (and globdat.error) if no interface element could be added
+
+    static    bool       doIt 
 
          ( Global& globdat );
 
@@ -105,8 +107,7 @@ void                     findCommonEdge
 	   int&              p2,
 	   int               n1,
 	   int               n2,
-	   int               ielem,
-	   const IntVector&  neighbors,
+	   int               ie,
 	   Global&           globdat );
 
 #endif
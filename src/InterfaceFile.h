@@ -0,0 +1,455 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * Binary form of the interface file (--interface-binary) and a reader
+ * for it. This header does not depend on the rest of the program, so a
+ * solver can include it as is: the reader maps the file and returns
+ * the arrays in place, without parsing or copying anything.
+ *
+ * Layout (all offsets in bytes from the start of the file, every
+ * section starts on a multiple of 8):
+ *
+ *   InterfaceFileHeader    magic "CIGENIFB", byte order mark, version,
+ *                          dimension, counts, number of sections
+ *   InterfaceFileSection   one entry per section: id, bytes per value,
+ *                          values per row, offset, number of rows
+ *   sections               fixed stride arrays, see InterfaceFileSection::Id
+ *
+ * The file is written in the byte order of the machine that wrote it;
+ * byteOrder is INTERFACE_FILE_BYTE_ORDER in that order. A reader on a
+ * machine with the other byte order swaps the bytes of a copy of the
+ * file instead of mapping it. Readers skip sections they do not know,
+ * so sections can be added without changing the version; the version
+ * changes when the meaning of an existing section does.
+ *
+ * Usage:
+ *
+ *   InterfaceFileReader  file;
+ *
+ *   if ( !file.open ( "mesh-interface.bin" ) ) ... file.getError ()
+ *
+ *   InterfaceArray<int32_t>  nodes = file.getElementNodes ();
+ *
+ *   for ( size_t ie = 0; ie < nodes.rows; ie++ )
+ *     ... nodes[ie][0] ... nodes[ie][nodes.stride-1]
+ */
+
+#ifndef INTERFACE_FILE_H
+#define INTERFACE_FILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// =====================================================================
+//     file layout
+// =====================================================================
+
+static const char      INTERFACE_FILE_MAGIC[8]   = { 'C','I','G','E','N','I','F','B' };
+static const uint32_t  INTERFACE_FILE_BYTE_ORDER = 0x01020304;
+static const uint32_t  INTERFACE_FILE_VERSION    = 1;
+
+struct InterfaceFileHeader
+{
+  char        magic[8];
+  uint32_t    byteOrder;
+  uint32_t    version;
+  uint32_t    dimension;
+  uint32_t    nodesPerElement;
+  uint64_t    elementCount;
+  uint64_t    nodeCount;
+  uint64_t    sectionCount;
+};
+
+struct InterfaceFileSection
+{
+  enum Id
+  {
+    ELEMENT_IDS        = 1,   // int32, id of every interface element
+    ELEMENT_MATERIALS  = 2,   // int32, material of every interface element
+    ELEMENT_BULKS      = 3,   // int32, bulk1 bulk2 of every interface element
+    ELEMENT_NODES      = 4,   // int32, connectivity (nodesPerElement per row)
+    NODE_IDS           = 5,   // int32, id of every node of the original mesh
+    NODE_KINDS         = 6,   // int32, 2 for interfacial nodes, 1 otherwise
+    DUPLICATE_OFFSETS  = 7,   // int64, nodeCount+1 offsets in DUPLICATE_NODES
+    DUPLICATE_NODES    = 8,   // int32, the node and its duplicates (if any)
+    FLOW_NODES         = 9,   // int32, flow node of every node (--flow)
+    OPPOSITE_VERTICES  = 10   // int32, per interface element (3D)
+  };
+
+  uint32_t    id;
+  uint32_t    valueSize;    // bytes per value
+  uint64_t    stride;       // values per row
+  uint64_t    offset;
+  uint64_t    rows;
+};
+
+// =====================================================================
+//     struct InterfaceArray
+// =====================================================================
+
+// rows x stride values in the file (data is 0 if the section is absent)
+
+template <class T>
+struct InterfaceArray
+{
+  const T*    data;
+  size_t      rows;
+  size_t      stride;
+
+  size_t      size        () const { return rows * stride; }
+  const T*    operator [] ( size_t row ) const { return data + row * stride; }
+};
+
+// =====================================================================
+//     class InterfaceFileReader
+// =====================================================================
+
+class InterfaceFileReader
+{
+  public:
+
+    InterfaceFileReader  () : data_(0), size_(0), isMapped_(false), sections_(0)
+    {
+      memset ( &header_, 0, sizeof(header_) );
+    }
+
+   ~InterfaceFileReader  () { close (); }
+
+    // map (or read) and check the file, false with getError() if it
+    // cannot be used
+
+    inline bool                   open     ( const char* fileName );
+    inline void                   close    ();
+
+    const std::string&            getError () const { return error_; }
+
+    const InterfaceFileHeader&    getHeader() const { return header_; }
+
+    int      getDimension       () const { return header_.dimension; }
+    size_t   getElementCount    () const { return header_.elementCount; }
+    size_t   getNodesPerElement () const { return header_.nodesPerElement; }
+    size_t   getNodeCount       () const { return header_.nodeCount; }
+
+    InterfaceArray<int32_t>  getElementIds       () const { return get_<int32_t> ( InterfaceFileSection::ELEMENT_IDS ); }
+    InterfaceArray<int32_t>  getElementMaterials () const { return get_<int32_t> ( InterfaceFileSection::ELEMENT_MATERIALS ); }
+    InterfaceArray<int32_t>  getElementBulks     () const { return get_<int32_t> ( InterfaceFileSection::ELEMENT_BULKS ); }
+    InterfaceArray<int32_t>  getElementNodes     () const { return get_<int32_t> ( InterfaceFileSection::ELEMENT_NODES ); }
+    InterfaceArray<int32_t>  getNodeIds          () const { return get_<int32_t> ( InterfaceFileSection::NODE_IDS ); }
+    InterfaceArray<int32_t>  getNodeKinds        () const { return get_<int32_t> ( InterfaceFileSection::NODE_KINDS ); }
+    InterfaceArray<int64_t>  getDuplicateOffsets () const { return get_<int64_t> ( InterfaceFileSection::DUPLICATE_OFFSETS ); }
+    InterfaceArray<int32_t>  getDuplicateNodes   () const { return get_<int32_t> ( InterfaceFileSection::DUPLICATE_NODES ); }
+    InterfaceArray<int32_t>  getFlowNodes        () const { return get_<int32_t> ( InterfaceFileSection::FLOW_NODES ); }
+    InterfaceArray<int32_t>  getOppositeVertices () const { return get_<int32_t> ( InterfaceFileSection::OPPOSITE_VERTICES ); }
+
+  private:
+
+    InterfaceFileReader              ( const InterfaceFileReader& );
+    InterfaceFileReader& operator =  ( const InterfaceFileReader& );
+
+    template <class T>
+    InterfaceArray<T>             get_     ( uint32_t id ) const;
+
+    inline bool                   fail_    ( const char* message );
+    inline bool                   check_   ();
+
+    static inline void            swap_    ( char* data, size_t valueSize, size_t count );
+
+    static inline bool            hasRoom_ ( const InterfaceFileHeader&  header,
+                                             size_t                      size );
+    static inline bool            hasRoom_ ( const InterfaceFileSection& section,
+                                             size_t                      size );
+
+  private:
+
+    const char*                   data_;
+    size_t                        size_;
+    bool                          isMapped_;
+    std::vector<char>             buffer_;    // copy of the file if not mapped
+
+    InterfaceFileHeader           header_;
+    const InterfaceFileSection*   sections_;
+    std::string                   error_;
+};
+
+// #####################################################################
+//   Implementation
+// #####################################################################
+
+// ---------------------------------------------------------------------
+//   open
+// ---------------------------------------------------------------------
+
+inline bool InterfaceFileReader::open ( const char* fileName )
+{
+  close ();
+
+  error_.clear ();
+
+#if !defined(_WIN32)
+
+  int fd = ::open ( fileName, O_RDONLY );
+
+  if ( fd < 0 ) return fail_ ( "unable to open the file" );
+
+  struct stat st;
+
+  if ( fstat ( fd, &st ) != 0 || st.st_size < (off_t) sizeof(header_) )
+  {
+    ::close ( fd );
+    return fail_ ( "not an interface file" );
+  }
+
+  void* addr = mmap ( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+  ::close ( fd );
+
+  if ( addr != MAP_FAILED )
+  {
+    data_     = static_cast<const char*> ( addr );
+    size_     = st.st_size;
+    isMapped_ = true;
+  }
+
+#endif
+
+  // fall back to reading the whole file at once
+
+  if ( !isMapped_ )
+  {
+    FILE* file = fopen ( fileName, "rb" );
+
+    if ( !file ) return fail_ ( "unable to open the file" );
+
+    fseek ( file, 0, SEEK_END );
+    buffer_.resize ( ftell ( file ) );
+    fseek ( file, 0, SEEK_SET );
+
+    const bool ok = fread ( buffer_.data (), 1, buffer_.size (), file ) == buffer_.size ();
+
+    fclose ( file );
+
+    if ( !ok ) return fail_ ( "unable to read the file" );
+
+    data_ = buffer_.data ();
+    size_ = buffer_.size ();
+  }
+
+  return check_ ();
+}
+
+// ---------------------------------------------------------------------
+//   close
+// ---------------------------------------------------------------------
+
+inline void InterfaceFileReader::close ()
+{
+#if !defined(_WIN32)
+  if ( isMapped_ )
+  {
+    munmap ( const_cast<char*> ( data_ ), size_ );
+  }
+#endif
+
+  buffer_.clear ();
+
+  data_     = 0;
+  size_     = 0;
+  isMapped_ = false;
+  sections_ = 0;
+
+  memset ( &header_, 0, sizeof(header_) );
+}
+
+// ---------------------------------------------------------------------
+//   fail_
+// ---------------------------------------------------------------------
+
+inline bool InterfaceFileReader::fail_ ( const char* message )
+{
+  close ();
+
+  error_ = message;
+
+  return false;
+}
+
+// ---------------------------------------------------------------------
+//   check_
+// ---------------------------------------------------------------------
+
+// check the header and the section table; a file written with the
+// other byte order is copied and swapped
+
+inline bool InterfaceFileReader::check_ ()
+{
+  if ( size_ < sizeof(header_) ||
+       memcmp ( data_, INTERFACE_FILE_MAGIC, sizeof(INTERFACE_FILE_MAGIC) ) != 0 )
+  {
+    return fail_ ( "not an interface file" );
+  }
+
+  memcpy ( &header_, data_, sizeof(header_) );
+
+  if ( header_.byteOrder != INTERFACE_FILE_BYTE_ORDER )
+  {
+    swap_ ( reinterpret_cast<char*> ( &header_.byteOrder ), 4, 1 );
+
+    if ( header_.byteOrder != INTERFACE_FILE_BYTE_ORDER )
+    {
+      return fail_ ( "unknown byte order" );
+    }
+
+    if ( isMapped_ )
+    {
+      std::vector<char> copy ( data_, data_ + size_ );
+
+      munmap ( const_cast<char*> ( data_ ), size_ );
+
+      isMapped_ = false;
+      buffer_.swap ( copy );
+      data_     = buffer_.data ();
+    }
+
+    char* data = buffer_.data ();
+
+    swap_ ( data + 8,  4, 4 );
+    swap_ ( data + 24, 8, 3 );
+
+    memcpy ( &header_, data, sizeof(header_) );
+
+    if ( !hasRoom_ ( header_, size_ ) )
+    {
+      return fail_ ( "truncated interface file" );
+    }
+
+    InterfaceFileSection* sections =
+      reinterpret_cast<InterfaceFileSection*> ( data + sizeof(header_) );
+
+    for ( size_t is = 0; is < header_.sectionCount; is++ )
+    {
+      swap_ ( reinterpret_cast<char*> ( &sections[is].id ),     4, 2 );
+      swap_ ( reinterpret_cast<char*> ( &sections[is].stride ), 8, 3 );
+
+      const InterfaceFileSection& s = sections[is];
+
+      if ( hasRoom_ ( s, size_ ) )
+      {
+        swap_ ( data + s.offset, s.valueSize, s.rows * s.stride );
+      }
+    }
+  }
+
+  if ( header_.version > INTERFACE_FILE_VERSION )
+  {
+    return fail_ ( "interface file written by a newer version" );
+  }
+
+  if ( !hasRoom_ ( header_, size_ ) )
+  {
+    return fail_ ( "truncated interface file" );
+  }
+
+  sections_ = reinterpret_cast<const InterfaceFileSection*> ( data_ + sizeof(header_) );
+
+  for ( size_t is = 0; is < header_.sectionCount; is++ )
+  {
+    const InterfaceFileSection& s = sections_[is];
+
+    if ( s.offset % 8 != 0 || !hasRoom_ ( s, size_ ) )
+    {
+      return fail_ ( "truncated interface file" );
+    }
+  }
+
+  return true;
+}
+
+// ---------------------------------------------------------------------
+//   hasRoom_
+// ---------------------------------------------------------------------
+
+// the counts come from the file: compare by division, so that a
+// corrupt count cannot overflow the size of the section table or of a
+// section (rows x stride x valueSize)
+
+inline bool InterfaceFileReader::hasRoom_
+
+  ( const InterfaceFileHeader&  header,
+    size_t                      size )
+
+{
+  return size >= sizeof(header) &&
+         header.sectionCount <= ( size - sizeof(header) ) / sizeof(InterfaceFileSection);
+}
+
+inline bool InterfaceFileReader::hasRoom_
+
+  ( const InterfaceFileSection& s,
+    size_t                      size )
+
+{
+  if ( s.offset > size ) return false;
+
+  if ( s.rows == 0 || s.stride == 0 || s.valueSize == 0 ) return true;
+
+  const uint64_t values = ( size - s.offset ) / s.valueSize;
+
+  return s.stride <= values && s.rows <= values / s.stride;
+}
+
+// ---------------------------------------------------------------------
+//   swap_
+// ---------------------------------------------------------------------
+
+inline void InterfaceFileReader::swap_
+
+  ( char*   data,
+    size_t  valueSize,
+    size_t  count )
+
+{
+  for ( size_t i = 0; i < count; i++, data += valueSize )
+  {
+    for ( size_t k = 0; k < valueSize / 2; k++ )
+    {
+      std::swap ( data[k], data[valueSize-1-k] );
+    }
+  }
+}
+
+// ---------------------------------------------------------------------
+//   get_
+// ---------------------------------------------------------------------
+
+template <class T>
+InterfaceArray<T> InterfaceFileReader::get_ ( uint32_t id ) const
+{
+  InterfaceArray<T> array = { 0, 0, 0 };
+
+  for ( size_t is = 0; is < header_.sectionCount; is++ )
+  {
+    const InterfaceFileSection& s = sections_[is];
+
+    if ( s.id == id && s.valueSize == sizeof(T) )
+    {
+      array.data   = reinterpret_cast<const T*> ( data_ + s.offset );
+      array.rows   = s.rows;
+      array.stride = s.stride;
+    }
+  }
+
+  return array;
+}
+
+#endif
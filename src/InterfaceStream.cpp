@@ -0,0 +1,253 @@
+#include "InterfaceStream.h"
+#include "Global.h"
+
+// ---------------------------------------------------------
+//   InterfaceBatch::clear
+// ---------------------------------------------------------
+
+void InterfaceBatch::clear ()
+{
+  connec     .clear ();
+  bulks      .clear ();
+  mats       .clear ();
+  oppVertices.clear ();
+  flowConnec .clear ();
+}
+
+// ---------------------------------------------------------
+//   constructor
+// ---------------------------------------------------------
+
+InterfaceStream::InterfaceStream ( const Global& globdat )
+
+  : count_       ( 0 ),
+    nodeCount_   ( globdat.nodeICount ),
+    threadCount_ ( globdat.threadCount ),
+    is3D_        ( globdat.is3D ),
+    isHydraulic_ ( globdat.isHydraulic ),
+    isBinary_    ( globdat.isInterfaceBinary )
+
+{
+  openSpill_ ( jemElements_   );
+  openSpill_ ( jemNeighbours_ );
+  openSpill_ ( elements_      );
+
+  if ( is3D_ )     openSpill_ ( opposite_ );
+
+  if ( isBinary_ )
+  {
+    openSpill_ ( mats_  );
+    openSpill_ ( bulks_ );
+  }
+}
+
+// ---------------------------------------------------------
+//   add
+// ---------------------------------------------------------
+
+/*
+ * The lines are formatted on --threads threads (see
+ * TextWriter::writeParallel) and the element indices of every
+ * material are appended to its last run when they follow it.
+ */
+
+void InterfaceStream::add ( const InterfaceBatch& batch )
+{
+  const int   count     = batch.mats.size ();
+  const int   first     = count_;
+  const int   nodeCount = nodeCount_;
+  const int   flowCount = nodeCount_ / 2;
+
+  for ( int i = 0; i < count; i++ )
+  {
+    IntVector& runs = matRuns_[batch.mats[i]];
+
+    if ( !runs.empty () && runs.back () == first + i - 1 )
+    {
+      runs.back () = first + i;
+    }
+    else
+    {
+      runs.push_back ( first + i );
+      runs.push_back ( first + i );
+    }
+  }
+
+  // jem mesh file, the ids are added by copyJemElements
+
+  jemElements_.writeParallel ( count, threadCount_, [&] ( TextWriter& out, int i )
+  {
+    const int* connec = batch.connec.data () + (size_t) i * nodeCount;
+
+    out.writeList ( connec, connec + nodeCount, " " );
+
+    if ( isHydraulic_ )
+    {
+      const int* fconnec = batch.flowConnec.data () + (size_t) i * flowCount;
+
+      out.writeList ( fconnec, fconnec + flowCount, " " );
+    }
+
+    out << ";\n";
+  } );
+
+  jemNeighbours_.writeParallel ( count, threadCount_, [&] ( TextWriter& out, int i )
+  {
+    out << batch.bulks[2*i] << " " << batch.bulks[2*i+1] << ";\n";
+  } );
+
+  // interface file
+
+  if ( isBinary_ )
+  {
+    elements_.writeBytes ( batch.connec.data (), (size_t) count * nodeCount * sizeof(int) );
+    mats_    .writeBytes ( batch.mats  .data (), (size_t) count *             sizeof(int) );
+    bulks_   .writeBytes ( batch.bulks .data (), (size_t) count * 2 *         sizeof(int) );
+
+    if ( is3D_ )
+    {
+      opposite_.writeBytes ( batch.oppVertices.data (), (size_t) count * sizeof(int) );
+    }
+  }
+  else
+  {
+    elements_.writeParallel ( count, threadCount_, [&] ( TextWriter& out, int i )
+    {
+      const int* connec = batch.connec.data () + (size_t) i * nodeCount;
+
+      out << first + i << " "
+          << batch.mats[i] << " "
+          << batch.bulks[2*i] << " "
+          << batch.bulks[2*i+1] << " ";
+
+      out.writeList ( connec, connec + nodeCount, " " );
+
+      out << "\n";
+    } );
+
+    if ( is3D_ )
+    {
+      for ( int i = 0; i < count; i++ )
+      {
+        opposite_ << batch.oppVertices[i] << "\n";
+      }
+    }
+  }
+
+  count_ += count;
+}
+
+// ---------------------------------------------------------
+//   getMatCount
+// ---------------------------------------------------------
+
+int InterfaceStream::getMatCount ( int mat ) const
+{
+  Int2IntVectMap::const_iterator it = matRuns_.find ( mat );
+
+  int count = 0;
+
+  if ( it == matRuns_.end () ) return 0;
+
+  for ( size_t ir = 0; ir < it->second.size (); ir += 2 )
+  {
+    count += it->second[ir+1] - it->second[ir] + 1;
+  }
+
+  return count;
+}
+
+// ---------------------------------------------------------
+//   copy functions
+// ---------------------------------------------------------
+
+void InterfaceStream::copyJemElements ( TextWriter& file, int firstId )
+{
+  copySpill_ ( jemElements_, file, firstId );
+}
+
+void InterfaceStream::copyJemNeighbours ( TextWriter& file, int firstId )
+{
+  copySpill_ ( jemNeighbours_, file, firstId );
+}
+
+void InterfaceStream::copyElements ( TextWriter& file )
+{
+  copySpill_ ( elements_, file );
+}
+
+void InterfaceStream::copyOppVertices ( TextWriter& file )
+{
+  if ( is3D_ ) copySpill_ ( opposite_, file );
+}
+
+void InterfaceStream::copyMats ( TextWriter& file )
+{
+  if ( isBinary_ ) copySpill_ ( mats_, file );
+}
+
+void InterfaceStream::copyBulks ( TextWriter& file )
+{
+  if ( isBinary_ ) copySpill_ ( bulks_, file );
+}
+
+// ---------------------------------------------------------
+//   openSpill_
+// ---------------------------------------------------------
+
+void InterfaceStream::openSpill_ ( TextWriter& spill )
+{
+  if ( !spill.openTemporary () )
+  {
+    cout << "Unable to open temporary file for --stream!!!\n\n";
+    exit(1);
+  }
+}
+
+// ---------------------------------------------------------
+//   copySpill_
+// ---------------------------------------------------------
+
+void InterfaceStream::copySpill_
+
+  ( TextWriter&  spill,
+    TextWriter&  file,
+    int          firstId )
+
+{
+  vector<char>  block ( 1 << 20 );
+
+  size_t        offset      = 0;
+  size_t        size;
+
+  bool          isLineStart = true;
+
+  while ( ( size = spill.readBack ( offset, block.data (), block.size () ) ) > 0 )
+  {
+    offset += size;
+
+    if ( firstId < 0 )
+    {
+      file.writeBytes ( block.data (), size );
+      continue;
+    }
+
+    const char*  data = block.data ();
+    const char*  end  = data + size;
+
+    while ( data < end )
+    {
+      if ( isLineStart ) file << firstId++ << " ";
+
+      const char* eol = std::find ( data, end, '\n' );
+
+      isLineStart = eol != end;
+
+      if ( isLineStart ) eol++;
+
+      file.writeBytes ( data, eol - data );
+
+      data = eol;
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * Streaming mode (--stream). The domain and everywhere builders hand
+ * their interface elements to an InterfaceStream, one bounded batch at
+ * a time, instead of adding them to globdat.interfaceSet. The stream
+ * numbers the elements, keeps their count and the element groups per
+ * material (as ranges of ids), and spills what the output files need
+ * to anonymous temporary files: the lines of the jem mesh file (without
+ * the element ids, which depend on the number of boundary and flow
+ * elements) and the lines or arrays of the interface file. writeMesh
+ * and writeInterface copy them at their place, so the files are the
+ * same as without --stream while the memory no longer grows with the
+ * number of interface elements.
+ */
+
+#ifndef INTERFACE_STREAM_H
+#define INTERFACE_STREAM_H
+
+#include "typedefs.h"
+#include "TextWriter.h"
+
+struct Global;
+
+// =====================================================================
+//     struct InterfaceBatch
+// =====================================================================
+
+// consecutive interface elements, numbered from InterfaceStream::size()
+
+struct InterfaceBatch
+{
+  IntVector        connec;      // nodeICount nodes per interface element
+  IntVector        bulks;       // two bulk elements per interface element
+  IntVector        mats;
+  IntVector        oppVertices; // 3D
+  IntVector        flowConnec;  // 2D, hydraulic: nodeICount/2 per element
+
+  void             clear       ();
+};
+
+// =====================================================================
+//     class InterfaceStream
+// =====================================================================
+
+class InterfaceStream
+{
+  public:
+
+    // spill files for the outputs selected in globdat (jem mesh file,
+    // text or binary interface file)
+
+    explicit             InterfaceStream   ( const Global& globdat );
+
+    void                 add               ( const InterfaceBatch& batch );
+
+    int                  size              () const { return count_; }
+    int                  getFlowCount      () const { return isHydraulic_ ? count_ : 0; }
+
+    // material => runs first last (inclusive) of the element indices
+
+    const Int2IntVectMap&  getMatRuns      () const { return matRuns_; }
+
+    int                  getMatCount       ( int mat ) const;
+
+    // jem mesh file: element lines and neighbours, every line preceded
+    // by its id (firstId for the first element)
+
+    void                 copyJemElements   ( TextWriter& file, int firstId );
+    void                 copyJemNeighbours ( TextWriter& file, int firstId );
+
+    // interface file: element lines (text) or connectivity (binary),
+    // opposite vertices (3D); materials and bulk elements (binary)
+
+    void                 copyElements      ( TextWriter& file );
+    void                 copyOppVertices   ( TextWriter& file );
+    void                 copyMats          ( TextWriter& file );
+    void                 copyBulks         ( TextWriter& file );
+
+  private:
+
+                         InterfaceStream   ( const InterfaceStream& );
+    InterfaceStream&     operator =        ( const InterfaceStream& );
+
+    static void          openSpill_        ( TextWriter& spill );
+
+    // copy a spill file, with firstId, firstId+1 ... before every line
+    // if firstId >= 0
+
+    static void          copySpill_        ( TextWriter&  spill,
+                                             TextWriter&  file,
+                                             int          firstId = -1 );
+
+  private:
+
+    int                  count_;
+    int                  nodeCount_;    // nodes per interface element
+    int                  threadCount_;
+    bool                 is3D_;
+    bool                 isHydraulic_;
+    bool                 isBinary_;     // binary interface file
+
+    Int2IntVectMap       matRuns_;
+
+    TextWriter           jemElements_;
+    TextWriter           jemNeighbours_;
+
+    TextWriter           elements_;     // text lines or connectivity
+    TextWriter           opposite_;     // 3D
+    TextWriter           mats_;         // binary only
+    TextWriter           bulks_;        // binary only
+};
+
+#endif
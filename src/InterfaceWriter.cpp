@@ -1,7 +1,250 @@
+#include <functional>
+
 #include "InterfaceWriter.h"
+#include "InterfaceFile.h"
+#include "InterfaceStream.h"
 #include "Global.h"
 #include "Element.h"
 #include "Node.h"
+#include "TextWriter.h"
+
+// ---------------------------------------------------------
+//   getNodesPerElement
+// ---------------------------------------------------------
+
+// nodes per interface element: globdat.nodeICount is the size of the
+// continuum elements, the polycrystal builders store the corner nodes
+// of the faces only
+
+static int  getNodesPerElement
+
+  ( const Global&  globdat )
+
+{
+  if ( globdat.interfaceStream || globdat.interfaceSet.empty () )
+  {
+    return globdat.nodeICount;
+  }
+
+  return globdat.interfaceSet[0]->getConnectivity ().size ();
+}
+
+// ---------------------------------------------------------
+//   writeBinaryInterface
+// ---------------------------------------------------------
+
+/*
+ * Write the data of the text interface file in the binary format of
+ * InterfaceFile.h: a header, the table of the sections and one fixed
+ * stride array per section, in native byte order. With --stream the
+ * element sections are copied from the spill files of the stream.
+ */
+
+static void  writeBinaryInterface
+
+(       Global&  globdat,
+  const char*    fileName )
+
+{
+  InterfaceStream*     stream    = globdat.interfaceStream;
+
+  const int            ieCount   = stream ? stream->size () : globdat.interfaceSet.size ();
+  const int            inCount   = globdat.nodeSet.size ();
+  const int            nodeCount = getNodesPerElement ( globdat );
+
+  cout << "Writing interface elements...\n";
+
+  // interface elements (kept by the stream with --stream)
+
+  const int            keptCount = stream ? 0 : ieCount;
+
+  vector<int32_t>      bulks     ( 2 * (size_t) keptCount );
+  vector<int32_t>      elemIds   ( keptCount );
+  vector<int32_t>      connec    ( (size_t) keptCount * nodeCount );
+
+  for ( int ie = 0; ie < keptCount; ie++ )
+  {
+    ElemPointer ep     = globdat.interfaceSet[ie];
+    IntSpan     inodes = ep->getConnectivity ();
+
+    if ( inodes.size () != nodeCount )
+    {
+      cout << "Interface elements of different sizes, "
+           << "use the text interface file!!!\n\n";
+      exit(1);
+    }
+
+    elemIds[ie]     = ep->getIndex ();
+    bulks[2*ie]     = ep->getBulk1 ();
+    bulks[2*ie+1]   = ep->getBulk2 ();
+
+    std::copy ( inodes.begin (), inodes.end (), connec.begin () + (size_t) ie * nodeCount );
+  }
+
+  // nodes of the original mesh: kind and duplicates (node first)
+
+  vector<int32_t>      kinds     ( inCount );
+  vector<int64_t>      dupOffsets( inCount + 1, 0 );
+  vector<int32_t>      dupNodes;
+  vector<int32_t>      flowNodes;
+
+  Int2IntVectMap::const_iterator dit;
+
+  for ( int in = 0; in < inCount; in++ )
+  {
+    kinds[in] = globdat.nodeSet.getIsInterface ( in ) ? 2 : 1;
+
+    dit = globdat.duplicatedNodes.find ( globdat.nodeSet.getIndex ( in ) );
+
+    if ( dit != globdat.duplicatedNodes.end () )
+    {
+      dupNodes.insert ( dupNodes.end (), dit->second.begin (), dit->second.end () );
+    }
+
+    dupOffsets[in+1] = dupNodes.size ();
+  }
+
+  if ( globdat.isHydraulic )
+  {
+    flowNodes.resize ( inCount );
+
+    for ( int in = 0; in < inCount; in++ )
+    {
+      flowNodes[in] = globdat.flowNodes[globdat.nodeId2Position.get ( globdat.nodeSet.getIndex ( in ) )];
+    }
+  }
+
+  // sections, each one starting on a multiple of 8 bytes
+
+  // the data of a section is either an array or written by copy
+
+  typedef std::function<void(TextWriter&)> CopyFunc;
+
+  struct Section
+  {
+    InterfaceFileSection  entry;
+    const void*           data;
+    CopyFunc              copy;
+  };
+
+  vector<Section>      sections;
+
+  auto addSection = [&] ( uint32_t id, uint32_t valueSize, size_t stride,
+                          size_t rows, const void* data, CopyFunc copy = CopyFunc () )
+  {
+    Section s = { { id, valueSize, stride, 0, rows }, data, copy };
+
+    sections.push_back ( s );
+  };
+
+  typedef InterfaceFileSection IFS;
+
+  if ( stream )
+  {
+    auto copyIds = [ieCount] ( TextWriter& file )
+    {
+      int32_t block[1024];
+
+      for ( int ie = 0; ie < ieCount; ie += 1024 )
+      {
+        const int n = std::min ( 1024, ieCount - ie );
+
+        for ( int i = 0; i < n; i++ ) block[i] = ie + i;
+
+        file.writeBytes ( block, n * sizeof(int32_t) );
+      }
+    };
+
+    addSection ( IFS::ELEMENT_IDS,       4, 1,         ieCount, 0, copyIds );
+    addSection ( IFS::ELEMENT_MATERIALS, 4, 1,         ieCount, 0,
+                 [stream] ( TextWriter& file ) { stream->copyMats     ( file ); } );
+    addSection ( IFS::ELEMENT_BULKS,     4, 2,         ieCount, 0,
+                 [stream] ( TextWriter& file ) { stream->copyBulks    ( file ); } );
+    addSection ( IFS::ELEMENT_NODES,     4, nodeCount, ieCount, 0,
+                 [stream] ( TextWriter& file ) { stream->copyElements ( file ); } );
+  }
+  else
+  {
+    addSection ( IFS::ELEMENT_IDS,       4, 1,         ieCount,   elemIds.data () );
+    addSection ( IFS::ELEMENT_MATERIALS, 4, 1,         ieCount,   globdat.interfaceMats.data () );
+    addSection ( IFS::ELEMENT_BULKS,     4, 2,         ieCount,   bulks.data () );
+    addSection ( IFS::ELEMENT_NODES,     4, nodeCount, ieCount,   connec.data () );
+  }
+
+  addSection ( IFS::NODE_IDS,          4, 1,         inCount,   globdat.nodeSet.getIndexData () );
+  addSection ( IFS::NODE_KINDS,        4, 1,         inCount,   kinds.data () );
+  addSection ( IFS::DUPLICATE_OFFSETS, 8, 1,         inCount+1, dupOffsets.data () );
+  addSection ( IFS::DUPLICATE_NODES,   4, 1,         dupNodes.size (), dupNodes.data () );
+
+  if ( globdat.isHydraulic )
+  {
+    addSection ( IFS::FLOW_NODES,      4, 1,         inCount,   flowNodes.data () );
+  }
+
+  if ( globdat.is3D && stream )
+  {
+    addSection ( IFS::OPPOSITE_VERTICES, 4, 1,       ieCount,   0,
+                 [stream] ( TextWriter& file ) { stream->copyOppVertices ( file ); } );
+  }
+  else if ( globdat.is3D )
+  {
+    addSection ( IFS::OPPOSITE_VERTICES, 4, 1,       ieCount,   globdat.oppositeVertices.data () );
+  }
+
+  InterfaceFileHeader  header;
+
+  memcpy ( header.magic, INTERFACE_FILE_MAGIC, sizeof(header.magic) );
+
+  header.byteOrder       = INTERFACE_FILE_BYTE_ORDER;
+  header.version         = INTERFACE_FILE_VERSION;
+  header.dimension       = globdat.is3D ? 3 : 2;
+  header.nodesPerElement = nodeCount;
+  header.elementCount    = ieCount;
+  header.nodeCount       = inCount;
+  header.sectionCount    = sections.size ();
+
+  uint64_t             offset = sizeof(header) + sections.size () * sizeof(InterfaceFileSection);
+
+  for ( size_t is = 0; is < sections.size (); is++ )
+  {
+    InterfaceFileSection& e = sections[is].entry;
+
+    e.offset = offset;
+    offset  += ( e.rows * e.stride * e.valueSize + 7 ) / 8 * 8;
+  }
+
+  TextWriter           file;
+
+  if ( !file.open ( fileName ) )
+  {
+    cout << "Unable to open interface file!!!\n\n";
+    exit(1);
+  }
+
+  const char           padding[8] = { 0 };
+
+  file.writeBytes ( &header, sizeof(header) );
+
+  for ( size_t is = 0; is < sections.size (); is++ )
+  {
+    file.writeBytes ( &sections[is].entry, sizeof(InterfaceFileSection) );
+  }
+
+  for ( size_t is = 0; is < sections.size (); is++ )
+  {
+    const InterfaceFileSection& e    = sections[is].entry;
+    const size_t                size = e.rows * e.stride * e.valueSize;
+
+    if ( sections[is].copy ) sections[is].copy      ( file );
+    else                     file.writeBytes ( sections[is].data, size );
+
+    file.writeBytes ( padding, ( 8 - size % 8 ) % 8 );
+  }
+
+  file.close ();
+
+  cout << "Writing interface elements...done!\n\n";
+}
 
 // ---------------------------------------------------------
 //   writeInterface
@@ -19,6 +262,8 @@
  * Number-of-node
  * nodeId  dupNode1 dupNode2 1 (1 to indicate not an interfacial node)
  * nodeId  dupNode1 dupNode2 2 (2 to indicate nodeId is an interfacial node)
+ *
+ * or, with --interface-binary, in the binary format of InterfaceFile.h.
  */
 
 void  writeInterface 
@@ -29,27 +274,43 @@ void  writeInterface
 {
   if (globdat.outAbaqus)   return;
   if (globdat.isConverter) return;
+
+  if ( globdat.isInterfaceBinary )
+  {
+    writeBinaryInterface ( globdat, fileName );
+    return;
+  }
  
-  const int   ieCount = globdat.interfaceSet.size ();
+  InterfaceStream* stream = globdat.interfaceStream;
+
+  const int   ieCount = stream ? stream->size () : globdat.interfaceSet.size ();
   const int   inCount = globdat.nodeSet.     size ();
 
   ElemPointer ep;
 
-  IntVector   connec;
+  IntSpan     connec;
   IntVector   dupNodes;
 
   int         index;
   int         inter;
 
-  ofstream    file ( fileName, std::ios::out );
+  TextWriter  file;
+
+  if ( !file.open ( fileName ) )
+  {
+    cout << "Unable to open interface file!!!\n\n";
+    exit(1);
+  }
   
   cout << "Writing interface elements...\n";
 
   file << "Element\n" 
-       << ieCount    << endl
-       << globdat.nodeICount << endl;
+       << ieCount    << "\n"
+       << getNodesPerElement ( globdat ) << "\n";
 
-  for ( int ie = 0; ie < ieCount; ie++ )
+  if ( stream ) stream->copyElements ( file );
+
+  for ( int ie = 0; !stream && ie < ieCount; ie++ )
   {
     ep = globdat.interfaceSet[ie];
 
@@ -58,24 +319,21 @@ void  writeInterface
          << ep->getBulk1() << " " 
          << ep->getBulk2() << " ";
 
-    ep->getConnectivity ( connec );
+    connec = ep->getConnectivity ();
 
-    copy ( connec.begin(), 
-	   connec.end(), 
-	   ostream_iterator<int> ( file, " " ) 
-	 );
+    file.writeList ( connec.begin(), connec.end(), " " );
 
     file << "\n";
   }
 
-  file << "Node\n" << inCount << endl;
+  file << "Node\n" << inCount << "\n";
 
   for ( int in = 0; in < inCount; in++ )
   {
-    index  = globdat.nodeSet[in]->getIndex ();
+    index  = globdat.nodeSet.getIndex ( in );
     inter  = 1;
 
-    if ( globdat.nodeSet[in]->getIsInterface () )
+    if ( globdat.nodeSet.getIsInterface ( in ) )
     {
       inter = 2;
     }
@@ -92,24 +350,23 @@ void  writeInterface
 
     if ( dupNodes.size () != 1 )
     {
-      copy ( dupNodes.begin(),
-	         dupNodes.end  (), 
-	         ostream_iterator<int> ( file, " " ) 
-	   );
+      file.writeList ( dupNodes.begin(), dupNodes.end(), " " );
     }
     else
     {
       file << index << " " << inter;
     }
 
-    file << endl;
+    file << "\n";
   }
 
   if ( globdat.is3D )
   {
     file << "OppositeVertices\n";
 
-    for ( int ie = 0; ie < ieCount; ie++ )
+    if ( stream ) stream->copyOppVertices ( file );
+
+    for ( int ie = 0; !stream && ie < ieCount; ie++ )
     {
       file << globdat.oppositeVertices[ie] << "\n";
     }
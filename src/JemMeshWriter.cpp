@@ -1,6 +1,8 @@
 #include "Global.h"
 #include "Node.h"
 #include "Element.h"
+#include "InterfaceStream.h"
+#include "TextWriter.h"
 
 
 #include <boost/algorithm/string.hpp>
@@ -10,6 +12,84 @@
 #include <iomanip>
 
 
+// ---------------------------------------------------------------------
+//   writeIdList
+// ---------------------------------------------------------------------
+
+// {ids[0]+offset,...}: every run of three or more consecutive ids is
+// written as a range [first:last+1] (the end is excluded in jem/jive)
+
+static void              writeIdList
+
+    ( TextWriter&       file,
+      const IntVector&  ids,
+      int               offset = 0 )
+{
+  const int count = ids.size ();
+
+  file << "{";
+
+  for ( int i = 0; i < count; )
+  {
+    int j = i + 1;
+
+    while ( j < count && ids[j] == ids[j-1] + 1 ) j++;
+
+    if ( i > 0 ) file << ",";
+
+    if ( j - i >= 3 )
+    {
+      file << "[" << ids[i] + offset << ":" << ids[j-1] + offset + 1 << "]";
+      i = j;
+    }
+    else
+    {
+      file << ids[i] + offset;
+      i++;
+    }
+  }
+
+  file << "}\n";
+}
+
+// ---------------------------------------------------------------------
+//   writeRunList
+// ---------------------------------------------------------------------
+
+// as writeIdList, for ids given as maximal runs first last (inclusive)
+
+static void              writeRunList
+
+    ( TextWriter&       file,
+      const IntVector&  runs,
+      int               offset = 0 )
+{
+  file << "{";
+
+  for ( size_t ir = 0; ir < runs.size (); ir += 2 )
+  {
+    const int first = runs[ir]   + offset;
+    const int last  = runs[ir+1] + offset;
+
+    if ( ir > 0 ) file << ",";
+
+    if ( last - first >= 2 )
+    {
+      file << "[" << first << ":" << last + 1 << "]";
+    }
+    else
+    {
+      for ( int id = first; id <= last; id++ )
+      {
+        if ( id > first ) file << ",";
+        file << id;
+      }
+    }
+  }
+
+  file << "}\n";
+}
+
 // =====================================================================
 //     writeJemMesh
 // =====================================================================
@@ -19,9 +99,18 @@ void                     writeJemMesh
     ( Global&     globdat,
       const char* fileName )
 {
-  ofstream file ( fileName, std::ios::out );
+  // nodes are written with the shortest decimals that read back to
+  // the same double (see TextWriter)
+
+  TextWriter file;
+
+  if ( !file.open ( fileName ) )
+  {
+    cout << "Unable to open output mesh file!!!\n\n";
+    exit(1);
+  }
 
-  cout << setprecision(10);   file << setprecision(10);//increase the precision
+  cout << setprecision(10);
   
   cout << "Writing nodes...\n";
 
@@ -29,28 +118,33 @@ void                     writeJemMesh
 
   const int nodeCount    = globdat.newNodeSet.size   ();
   const int elemCount    = globdat.elemSet.size      ();
-  const int felemCount   = globdat.flowElemSet.size  ();
+  InterfaceStream* stream = globdat.interfaceStream;
+
+  const int felemCount   = stream ? stream->getFlowCount () : globdat.flowElemSet.size ();
   const int bndElemCount = globdat.bndElementSet.size();
 
-  NodePointer np;
+  const NodeSet& nodes = globdat.newNodeSet;
+
+  // nodes and elements are formatted on --threads threads, in blocks
+  // that are written in order (see TextWriter::writeParallel)
+
+  const int      threadCount = globdat.threadCount;
 
-  for ( int in = 0; in < nodeCount; in ++ )
+  file.writeParallel ( nodeCount, threadCount, [&] ( TextWriter& out, int in )
   {
-    np = globdat.newNodeSet[in];
- 
     if ( !globdat.is3D )
     {
-      file << np->getIndex() 
-           << " " << np->getX() << " " << np->getY() << ";\n";
+      out << nodes.getIndex ( in ) 
+          << " " << nodes.getX ( in ) << " " << nodes.getY ( in ) << ";\n";
     }
     else
     {
-      file << np->getIndex() << " " 
-	   << np->getX() << " " 
-	   << np->getY() << " "
-	   << np->getZ() << ";\n";
+      out << nodes.getIndex ( in ) << " " 
+	  << nodes.getX ( in ) << " " 
+	  << nodes.getY ( in ) << " "
+	  << nodes.getZ ( in ) << ";\n";
     }
-  }
+  } );
 
   file << "</Nodes>\n";
 
@@ -60,25 +154,24 @@ void                     writeJemMesh
 
   file << "<Elements>\n";
 
-  ElemPointer ep;
-  IntVector   connect, newConnect;
-
-  for ( int ie = 0; ie < elemCount; ie ++ )
+  file.writeParallel ( elemCount, threadCount, [&] ( TextWriter& out, int ie )
   {
-    ep = globdat.elemSet[ie];
+    static thread_local IntVector connect;
+
+    ElemPointer ep = globdat.elemSet[ie];
 
-    file << ep->getIndex () << " ";
+    out << ep->getIndex () << " ";
 
     //cout << ie << "\n";
 
     ep->getJemConnectivity ( connect ); 
 
-    copy ( connect.begin(), connect.end(), ostream_iterator<int> (file, " " ) );
+    out.writeList ( connect.begin(), connect.end(), " " );
 
     //print ( connect.begin(), connect.end() );
 
-    file << ";\n";
-  }
+    out << ";\n";
+  } );
 
   cout << "Writing bulk elements...done!\n\n";
   
@@ -86,22 +179,26 @@ void                     writeJemMesh
   {
     cout << "Writing boundary elements...\n";
 
-    for ( int ie = 0; ie < bndElemCount; ie++ )
+    const int lastIndex = globdat.elemSet[elemCount-1]->getIndex();
+
+    file.writeParallel ( bndElemCount, threadCount, [&] ( TextWriter& out, int ie )
     {
-      ep = globdat.bndElementSet[ie];
+      static thread_local IntVector connect;
+
+      ElemPointer ep = globdat.bndElementSet[ie];
 
       // id of boundary elements numbered from the id of the last bulk element
 
-      file << globdat.elemSet[elemCount-1]->getIndex() + ie + 1 << " ";
+      out << lastIndex + ie + 1 << " ";
 
       ep->getJemConnectivity ( connect ); 
 
       //print ( connect.begin(), connect.end() );
 
-      copy ( connect.begin(), connect.end(), ostream_iterator<int> (file, " " ) );
+      out.writeList ( connect.begin(), connect.end(), " " );
 
-      file << ";\n";
-    }
+      out << ";\n";
+    } );
   }
 
   cout << "Writing boundary elements...done!\n\n";
@@ -122,7 +219,7 @@ void                     writeJemMesh
 
       ep->getJemConnectivity ( connect ); 
 
-      copy ( connect.begin(), connect.end(), ostream_iterator<int> (file, " " ) );
+      file.writeList ( connect.begin(), connect.end(), " " );
 
       file << ";\n";
     }
@@ -136,60 +233,44 @@ void                     writeJemMesh
   // if isHydraulic is true.
 
 
-  const int   ieCount = globdat.interfaceSet.size ();
-  const int   inCount = globdat.nodeSet.     size ();
+  const int   ieCount = stream ? stream->size () : globdat.interfaceSet.size ();
   
         int   start1  = globdat.elemSet[elemCount-1]->getIndex() + bndElemCount + felemCount;
         int   start2  = start1 + ieCount;
 
-  IntVector   connec;
-
   cout << "Writing interface elements in the solid mesh file...\n";
 
-  if ( globdat.isHydraulic == false)
+  if ( stream )
   {
-     for ( int ie = 0; ie < ieCount; ie++ )
+     stream->copyJemElements ( file, start1 + 1 );
+  }
+  else if ( globdat.isHydraulic == false)
+  {
+     file.writeParallel ( ieCount, threadCount, [&] ( TextWriter& out, int ie )
      {
-       ep = globdat.interfaceSet[ie];
-
-       file << start1 + ie + 1 << " ";
+       IntSpan connec = globdat.interfaceSet[ie]->getConnectivity ();
 
-       ep->getConnectivity ( connec );
+       out << start1 + ie + 1 << " ";
 
-       copy ( connec.begin(), 
-              connec.end(), 
-              ostream_iterator<int> ( file, " " ) 
-        );
+       out.writeList ( connec.begin(), connec.end(), " " );
 
-       file << ";\n";
-     }
+       out << ";\n";
+     } );
   }
   else
   {
-     ElemPointer fep;
-     IntVector   fconnec;
-
-     for ( int ie = 0; ie < ieCount; ie++ )
+     file.writeParallel ( ieCount, threadCount, [&] ( TextWriter& out, int ie )
      {
-       ep  = globdat.interfaceSet[ie];
-       fep = globdat.flowElemSet[ie];
-
-       file << start1 + ie + 1 << " ";
+       IntSpan connec  = globdat.interfaceSet[ie]->getConnectivity ();
+       IntSpan fconnec = globdat.flowElemSet [ie]->getConnectivity ();
 
-       ep ->getConnectivity ( connec );
-       fep->getConnectivity ( fconnec );
+       out << start1 + ie + 1 << " ";
 
-       copy ( connec.begin(), 
-              connec.end(), 
-              ostream_iterator<int> ( file, " " ) 
-        );
-       copy ( fconnec.begin(), 
-              fconnec.end(), 
-              ostream_iterator<int> ( file, " " ) 
-        );
+       out.writeList ( connec.begin(), connec.end(), " " );
+       out.writeList ( fconnec.begin(), fconnec.end(), " " );
 
-       file << ";\n";
-     }
+       out << ";\n";
+     } );
   }
   
   cout << "Writing interface elements in the solid mesh file...done\n";
@@ -209,15 +290,11 @@ void                     writeJemMesh
     IntVector elems   = it->second; 
 
     //file << "<ElementGroup name=\"" << domName << "\">\n{";
-    file << "<ElementGroup name=" << globdat.physicalNames[domName] << ">\n{";
+    file << "<ElementGroup name=" << globdat.physicalNames[domName] << ">\n";
     
-    for ( int ie = 0; ie < elems.size()-1; ie++ )
-    {
-      file << elems[ie] << ",";
-    }
+    writeIdList ( file, elems );
 
-    file << elems[elems.size()-1] << "}\n"
-         << "</ElementGroup>\n\n";
+    file << "</ElementGroup>\n\n";
   }
 
   cout << "Writing bulk element groups...done!\n\n";
@@ -235,14 +312,11 @@ void                     writeJemMesh
       IntVector elems   = it->second; 
 
       //file << "<ElementGroup name=\"" << domName << "\">\n{";
-      file << "<ElementGroup name=" << globdat.physicalNames[domName] << ">\n{";
+      file << "<ElementGroup name=" << globdat.physicalNames[domName] << ">\n";
       
-      for ( int ie = 0; ie < elems.size()-1; ie++ )
-      {
-        file << elems[ie] + globdat.elemSet[elemCount-1]->getIndex() + 1<< ",";
-      }
+      writeIdList ( file, elems, globdat.elemSet[elemCount-1]->getIndex() + 1 );
 
-      file << elems[elems.size()-1] + globdat.elemSet[elemCount-1]->getIndex() + 1<< "}\n" << "</ElementGroup>\n\n";
+      file << "</ElementGroup>\n\n";
     }
 
     cout << "Writing boundary element groups...done!\n\n";
@@ -256,22 +330,16 @@ void                     writeJemMesh
      file << start1+1 << ":" << start2+1 << "]}\n";
      file << "</ElementGroup>\n\n";
      
-     it  = globdat.mat2InterfaceElems.begin ();
-     eit = globdat.mat2InterfaceElems.end   ();
+     const Int2IntVectMap& groups = stream ? stream->getMatRuns () : globdat.mat2InterfaceElems;
 
-     for ( ; it != eit; ++it )
+     for ( Int2IntVectMap::const_iterator git = groups.begin (); git != groups.end (); ++git )
      {
-       int       domName = it->first; 
-       IntVector elems   = it->second; 
-
-       file << "<ElementGroup name=\"" << domName << "\">\n{";
+       file << "<ElementGroup name=\"" << git->first << "\">\n";
        
-       for ( int ie = 0; ie < elems.size()-1; ie++ )
-       {
-         file << elems[ie] + start1 + 1 << ",";
-       }
+       if ( stream ) writeRunList ( file, git->second, start1 + 1 );
+       else          writeIdList  ( file, git->second, start1 + 1 );
 
-       file << elems[elems.size()-1] + start1 + 1 << "}\n" << "</ElementGroup>\n\n";
+       file << "</ElementGroup>\n\n";
      }
 
      cout << "Writing interface element groups...done!\n\n";
@@ -281,13 +349,20 @@ void                     writeJemMesh
      file << "<ElementDatabase name = \"neighbours\">\n";
      file << "<Column name = \"connect\" type = \"int\">\n";
      
-     for ( int ie = 0; ie < ieCount; ie++ )
+     if ( stream )
      {
-       ep = globdat.interfaceSet[ie];
-       
-       file << start1+ie+1 << " " 
-            << ep->getBulk1() << " " 
-            << ep->getBulk2() << ";\n";
+       stream->copyJemNeighbours ( file, start1 + 1 );
+     }
+     else
+     {
+       file.writeParallel ( ieCount, threadCount, [&] ( TextWriter& out, int ie )
+       {
+         ElemPointer ep = globdat.interfaceSet[ie];
+         
+         out << start1+ie+1 << " " 
+             << ep->getBulk1() << " " 
+             << ep->getBulk2() << ";\n";
+       } );
      }
 
      file << "</Column>\n";
@@ -317,24 +392,15 @@ void                     writeJemMesh
       IntVector   nodes;
       copy ( elems.begin(), elems.end(), back_inserter(nodes) );
       
-      int       nodeCount = nodes.size( ) - 1;
-
-      file << "<NodeGroup name=" << globdat.physicalNames[domName]  << ">\n{";
+      file << "<NodeGroup name=" << globdat.physicalNames[domName]  << ">\n";
       
-      for ( int ie = 0; ie < nodeCount; ie++ )
-      {
-	    file << nodes[ie] << ",";
-      }
+      writeIdList ( file, nodes );
 
-      file << nodes[nodeCount] << "}\n" << "</NodeGroup>\n\n";
+      file << "</NodeGroup>\n\n";
     }
   }
   else
   {
-    IntVector dupNodes;
-
-    int nodeCount, dupCount;
-
     Int2IntSetMap::iterator sit  = globdat.bndNodesMap.begin ();
     Int2IntSetMap::iterator seit = globdat.bndNodesMap.end   ();
 
@@ -344,41 +410,24 @@ void                     writeJemMesh
       IntSet    elems   = sit->second; 
 
       IntVector   nodes;
-      copy ( elems.begin(), elems.end(), back_inserter(nodes) );
-      
-      nodeCount = nodes.size( ) - 1;
 
-      file << "<NodeGroup name=\"" << domName << "\">\n{";
-      
-      for ( int ie = 0; ie < nodeCount; ie++ )
+      for ( IntSet::const_iterator nit = elems.begin(); nit != elems.end(); ++nit )
       {
-	    file << nodes[ie] << ","; // original node also present in dupNodes
-    
-        dupNodes = globdat.duplicatedNodes[nodes[ie]];
+        nodes.push_back ( *nit ); // original node also present in dupNodes
 
-        dupCount = dupNodes.size ( );
-    
-        if ( dupCount != 0 )
+        Int2IntVectMap::const_iterator dit = globdat.duplicatedNodes.find ( *nit );
+
+        if ( dit != globdat.duplicatedNodes.end() && dit->second.size() != 0 )
         {
-          copy ( dupNodes.begin()+1,
-	             dupNodes.end  (), 
-	             ostream_iterator<int> ( file, ", " ) 
-	       );
+          nodes.insert ( nodes.end(), dit->second.begin()+1, dit->second.end() );
         }
       }
 
-      dupNodes = globdat.duplicatedNodes[nodes[nodeCount]];
-      dupCount = dupNodes.size ( );
-    
-      if ( dupCount != 0 )
-      {
-        copy ( dupNodes.begin()+1,
-	           dupNodes.end  (), 
-	           ostream_iterator<int> ( file, ", " ) 
-	     );
-      }
+      file << "<NodeGroup name=\"" << domName << "\">\n";
       
-      file << nodes[nodeCount] << "}\n" << "</NodeGroup>\n\n";
+      writeIdList ( file, nodes );
+
+      file << "</NodeGroup>\n\n";
     }
   }
 
@@ -402,7 +451,7 @@ void                     writeJemMesh
 
   if ( globdat.isNeper )
   {
-    NodePointer np;
+    const NodeSet& nodes = globdat.newNodeSet;
 
     int             id;
     double          x,y;
@@ -410,11 +459,9 @@ void                     writeJemMesh
 
     for ( int in = 0; in < nodeCount; in ++ )
     {
-      np = globdat.newNodeSet[in];
- 
-      id = np->getIndex();
-      x  = np->getX    (); 
-      y  = np->getY    ();
+      id = nodes.getIndex ( in );
+      x  = nodes.getX ( in ); 
+      y  = nodes.getY ( in );
 
       if ( abs ( x - globdat.xMin ) < 1e-16 ) left .push_back ( id );
       if ( abs ( x - globdat.xMax ) < 1e-16 ) right.push_back ( id );
@@ -422,46 +469,29 @@ void                     writeJemMesh
       if ( abs ( y - globdat.yMin ) < 1e-16 ) lower.push_back ( id );
     }
 
-    const int leftNodeCount  = left .size ();
-    const int rightNodeCount = right.size ();
-    const int upperNodeCount = upper.size ();
-    const int lowerNodeCount = lower.size ();
-    
-    file << "<NodeGroup name=\"" << "left" << "\">\n{";
+    file << "<NodeGroup name=\"" << "left" << "\">\n";
 
-    for ( int in = 0; in < leftNodeCount-1; ++in )
-    {
-	  file << left[in] << ",";
-    }
+    writeIdList ( file, left );
 
-    file << left[leftNodeCount-1] << "}\n" << "</NodeGroup>\n\n";
+    file << "</NodeGroup>\n\n";
     
-    file << "<NodeGroup name=\"" << "right" << "\">\n{";
+    file << "<NodeGroup name=\"" << "right" << "\">\n";
 
-    for ( int in = 0; in < rightNodeCount-1; ++in )
-    {
-	  file << right[in] << ",";
-    }
+    writeIdList ( file, right );
 
-    file << right[rightNodeCount-1] << "}\n" << "</NodeGroup>\n\n";
+    file << "</NodeGroup>\n\n";
 
-    file << "<NodeGroup name=\"" << "upper" << "\">\n{";
+    file << "<NodeGroup name=\"" << "upper" << "\">\n";
 
-    for ( int in = 0; in < upperNodeCount-1; ++in )
-    {
-	  file << upper[in] << ",";
-    }
+    writeIdList ( file, upper );
 
-    file << upper[upperNodeCount-1] << "}\n" << "</NodeGroup>\n\n";
+    file << "</NodeGroup>\n\n";
 
-    file << "<NodeGroup name=\"" << "lower" << "\">\n{";
+    file << "<NodeGroup name=\"" << "lower" << "\">\n";
 
-    for ( int in = 0; in < lowerNodeCount-1; ++in )
-    {
-	  file << lower[in] << ",";
-    }
+    writeIdList ( file, lower );
 
-    file << lower[lowerNodeCount-1] << "}\n" << "</NodeGroup>\n\n";
+    file << "</NodeGroup>\n\n";
   }
 
   cout << "Writing node groups...done!\n\n";
@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ------------------------------------------------------------
+//    constructor/destructor
+// ------------------------------------------------------------
+
+MappedFile::MappedFile ()
+
+  : data_(0), size_(0), isMapped_(false)
+{
+}
+
+MappedFile::~MappedFile ()
+{
+  close ();
+}
+
+// ------------------------------------------------------------
+//    open
+// ------------------------------------------------------------
+
+bool MappedFile::open ( const char* fileName )
+{
+  close ();
+
+#if !defined(_WIN32)
+
+  int fd = ::open ( fileName, O_RDONLY );
+
+  if ( fd < 0 ) return false;
+
+  struct stat st;
+
+  if ( fstat ( fd, &st ) != 0 )
+  {
+    ::close ( fd );
+    return false;
+  }
+
+  size_ = st.st_size;
+
+  // mmap does not accept empty files
+
+  if ( size_ == 0 )
+  {
+    ::close ( fd );
+    data_ = "";
+    return true;
+  }
+
+  void* addr = mmap ( 0, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+  ::close ( fd );
+
+  if ( addr != MAP_FAILED )
+  {
+    madvise ( addr, size_, MADV_SEQUENTIAL );
+
+    data_     = static_cast<const char*> ( addr );
+    isMapped_ = true;
+
+    return true;
+  }
+
+  size_ = 0;
+
+#endif
+
+  // fall back to reading the whole file at once
+
+  ifstream file ( fileName, std::ios::in | std::ios::binary );
+
+  if ( !file ) return false;
+
+  file.seekg ( 0, std::ios::end );
+  buffer_.resize ( file.tellg () );
+  file.seekg ( 0, std::ios::beg );
+  file.read  ( buffer_.data (), buffer_.size () );
+
+  data_ = buffer_.data ();
+  size_ = buffer_.size ();
+
+  return true;
+}
+
+// ------------------------------------------------------------
+//    close
+// ------------------------------------------------------------
+
+void MappedFile::close ()
+{
+#if !defined(_WIN32)
+  if ( isMapped_ )
+  {
+    munmap ( const_cast<char*>( data_ ), size_ );
+  }
+#endif
+
+  buffer_.clear ();
+
+  data_     = 0;
+  size_     = 0;
+  isMapped_ = false;
+}
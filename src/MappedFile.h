@@ -0,0 +1,47 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * Read-only view of a whole file. On POSIX systems the file is memory
+ * mapped so that readers can scan it in place without copying it into
+ * strings; elsewhere it is read into a single buffer.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "typedefs.h"
+
+// =====================================================================
+//     class MappedFile
+// =====================================================================
+
+class MappedFile
+{
+  public:
+
+                     MappedFile  ();
+                    ~MappedFile  ();
+
+    // map the file, return false if it cannot be opened
+
+    bool             open        ( const char* fileName );
+    void             close       ();
+
+    const char*      begin       () const { return data_; }
+    const char*      end         () const { return data_ + size_; }
+    size_t           size        () const { return size_; }
+
+  private:
+
+                     MappedFile  ( const MappedFile& );
+    MappedFile&      operator =  ( const MappedFile& );
+
+  private:
+
+    const char*      data_;
+    size_t           size_;
+    bool             isMapped_;
+    vector<char>     buffer_;    // used when mmap is not available
+};
+
+#endif
@@ -35,23 +35,21 @@ void                     writeMatlabMesh
   const int felemCount   = globdat.flowElemSet.size  ();
   const int bndElemCount = globdat.bndElementSet.size();
 
-  NodePointer np;
+  const NodeSet& nodes = globdat.newNodeSet;
 
   for ( int in = 0; in < nodeCount; in ++ )
   {
-    np = globdat.newNodeSet[in];
- 
     if ( !globdat.is3D )
     {
-      nFile << np->getIndex() 
-           << " " << np->getX() << " " << np->getY() << "\n";
+      nFile << nodes.getIndex ( in ) 
+           << " " << nodes.getX ( in ) << " " << nodes.getY ( in ) << "\n";
     }
     else
     {
-      nFile << np->getIndex() << " " 
-	        << np->getX() << " " 
-	        << np->getY() << " "
-	        << np->getZ() << "\n";
+      nFile << nodes.getIndex ( in ) << " " 
+	        << nodes.getX ( in ) << " " 
+	        << nodes.getY ( in ) << " "
+	        << nodes.getZ ( in ) << "\n";
     }
   }
 
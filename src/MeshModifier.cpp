@@ -3,6 +3,7 @@
 #include "Global.h"
 #include "Node.h"
 #include "Element.h"
+#include "Parallel.h"
 
 // -------------------------------------------------------
 //    doIt
@@ -20,7 +21,15 @@ void MeshModifier::doIt
 {
 
   buildNodeSupport      ( globdat );
-  buildNeighborElems    ( globdat );
+
+  if ( !globdat.isConverter )
+  {
+    if ( globdat.is3D ) buildFaceTable ( globdat );
+    else                buildEdgeTable ( globdat );
+
+    buildNeighborElems  ( globdat );
+  }
+
   buildInterfacialNodes ( globdat );
   duplicateNodes        ( globdat ); 
   addFlowNodes          ( globdat ); 
@@ -39,17 +48,50 @@ void MeshModifier::buildNodeSupport
   const int   elemCount = globdat.elemSet.size ();
         int   inodeCount;
 
-  IntVector   inodes;
+  IntSpan     inodes;
 
   ElemPointer ep;
 
+  CSRGraph&   support   = globdat.nodeSupport;
+
   cout << "building nodal support...\n";
 
+  if ( globdat.threadCount > 1 )
+  {
+    const ElemSet& elems = globdat.elemSet;
+
+    support.build ( elemCount, globdat.threadCount,
+                    [&elems] ( int ie ) { return elems[ie]->getConnectivity (); },
+                    [&elems] ( int ie ) { return elems[ie]->getIndex        (); } );
+
+    cout << "building nodal support...done!\n\n";
+    return;
+  }
+
+  // two passes: count the elements of every node, then store them
+  // (in the order of elemSet)
+
+  support.beginCount ();
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    inodes = globdat.elemSet[ie]->getConnectivity ();
+
+    inodeCount = inodes.size ();
+
+    for ( int in = 0; in < inodeCount; in++ )
+    {
+      support.addCount ( inodes[in] );
+    }
+  }
+
+  support.beginFill ();
+
   for ( int ie = 0; ie < elemCount; ie++ )
   {
     ep = globdat.elemSet[ie];
 
-    ep->getConnectivity ( inodes );
+    inodes = ep->getConnectivity ();
 
     inodeCount = inodes.size ();
 
@@ -57,10 +99,12 @@ void MeshModifier::buildNodeSupport
 
     for ( int in = 0; in < inodeCount; in++ )
     {
-      globdat.nodeSupport[inodes[in]].push_back ( ep->getIndex () );
+      support.addEntry ( inodes[in], ep->getIndex () );
     }
   }
 
+  support.endFill ();
+
   cout << "building nodal support...done!\n\n";
 }
 
@@ -69,49 +113,76 @@ void MeshModifier::buildNodeSupport
 //    buildNeighborElems
 // -------------------------------------------------------
 
+/*
+ *  Two elements are neighbors if they share a face (3D) or an edge (2D)
+ *  of the original mesh. Needs the face or edge table.
+ */
+
 void MeshModifier::buildNeighborElems
 
   ( Global&  globdat )
 
 {
-  int         inodeCnt;
+  cout << "building element neighbors...\n";
 
-  ElemPointer ep;
+  const int   elemCount = globdat.elemSet.size ();
 
-  IntVector   inodes;
+  if ( globdat.is3D )
+  {
+    globdat.elemNeighbors.build ( globdat.faceTable, elemCount, globdat.threadCount );
+  }
+  else
+  {
+    globdat.elemNeighbors.build ( globdat.edgeTable, elemCount, globdat.threadCount );
+  }
 
-  cout << "building element neighbors...\n";
+  cout << "building element neighbors...done!\n\n";
+}
 
-  const int   elemCount = globdat.elemSet.size ();
+// -------------------------------------------------------
+//    buildFaceTable
+// -------------------------------------------------------
 
-  globdat.elemNeighbors.resize ( elemCount );
+/*
+ *  Number the faces of the original 3D mesh, so that the elements
+ *  sharing a face are found without searching the neighbors.
+ */
 
-  for ( int ie = 0; ie < elemCount; ie++ )
-  {
-    ep = globdat.elemSet[ie];
+void MeshModifier::buildFaceTable
 
-    ep->getConnectivity ( inodes );
+  ( Global&  globdat )
 
-    inodeCnt = inodes.size ();
+{
+  cout << "building face table...\n";
 
-    IntSet neighbors;
+  globdat.faceTable.build ( globdat.elemSet, globdat.nodeSupport,
+                            globdat.elemId2Position, globdat.threadCount );
 
-    for ( int in = 0; in < inodeCnt; in++ )
-    {
-      int ii = inodes[in];
+  cout << "building face table...done!\n\n";
+}
 
-      for ( int iee = 0; iee < globdat.nodeSupport[ii].size(); iee++ )
-      {
-	    neighbors.insert ( globdat.nodeSupport[ii][iee] );
-      }
-    }
+// -------------------------------------------------------
+//    buildEdgeTable
+// -------------------------------------------------------
 
-    copy ( neighbors.begin(), neighbors.end(), back_inserter ( globdat.elemNeighbors[ie] ) );
-  }
+/*
+ *  Number the edges of the original 2D mesh and mark those on the
+ *  boundary (physical lines), so that the 2D interface builders need
+ *  not search the lists of boundary edges and of edges already done.
+ */
 
-  //print ( elemNeighbors );
+void MeshModifier::buildEdgeTable
 
-  cout << "building element neighbors...done!\n\n";
+  ( Global&  globdat )
+
+{
+  cout << "building edge table...\n";
+
+  globdat.edgeTable.build ( globdat.elemSet, globdat.nodeSupport,
+                            globdat.elemId2Position, globdat.nodePairs,
+                            globdat.bndElemsDomain, globdat.threadCount );
+
+  cout << "building edge table...done!\n\n";
 }
 
 
@@ -127,52 +198,60 @@ void MeshModifier::buildInterfacialNodes
   const int   nodeCount = globdat.nodeSet.size ();
   const int   elemCount = globdat.elemSet.size ();
   
-  int         index, suppCount, imat, matCount;
-  int         rCount;
-  int         duplicity;
   int         nnode;
 
-  IntSet      matSet;
-  IntVector   inodes, support;
+  IntVector   inodes;
 
-  NodePointer np;
+  NodeSet&    nodes = globdat.nodeSet;
   ElemPointer ep;
 
+  // the nodes are classified independently (on several threads),
+  // then gathered in node order
+
+  const char  SUPPORTED = 1;   // belongs to more than one element
+  const char  INTERFACE = 2;   // belongs to more than one material
+
+  IntVector     material ( nodeCount, 0 );  // sum of the materials around a node
+  vector<char>  state    ( nodeCount, 0 );
+
   cout << "detecting interface nodes...\n";
 
-  for ( int in = 0; in < nodeCount; in++ )
+  parallelFor ( nodeCount, globdat.threadCount, [&] ( int in )
   {
-    rCount    = 0;
-    np        = globdat.nodeSet[in];
-    index     = np->getIndex ();
-    support   =  globdat.nodeSupport[index];
-    suppCount =  support.size (); 
+    int         imat, matCount, rCount = 0;
+    int         duplicity;
+
+    static thread_local IntVector  matSet;   // materials around the node
 
-    //print ( support.begin(), support.end() );
+    matSet.clear ();
+
+    const int   index     = nodes.getIndex ( in );
+    IntSpan     support   = globdat.nodeSupport[index];
+    const int   suppCount = support.size (); 
 
     // ignore nodes belong to only ONE element
-    if ( suppCount == 1 ) continue; 
+    if ( suppCount == 1 ) return; 
     
     // check if this node is on an external boundary or not
 
-    if ( find ( globdat.boundaryNodes.begin(), 
-	            globdat.boundaryNodes.end(), index 
-              ) != globdat.boundaryNodes.end () 
-       )
+    if ( globdat.boundaryNodes.count ( index ) )
     {
-      np->setIsOnBoundary ( true );
+      nodes.setIsOnBoundary ( in, true );
     }
 
     for ( int ie = 0; ie < suppCount; ie++ )
     {
-      imat = globdat.elem2Domain[support[ie]]; 
+      imat = globdat.elem2Domain.get ( support[ie] ); 
 
-      matSet.insert ( imat );
+      matSet.push_back ( imat );
 
       if ( imat == globdat.rigidDomain[0] ) rCount++;
       if ( imat == globdat.rigidDomain[1] ) rCount++;
     }
 
+    sort ( matSet.begin(), matSet.end() );
+    matSet.erase ( unique ( matSet.begin(), matSet.end() ), matSet.end() );
+
     matCount  = matSet.size ();
 
     // if interface elements are created everywhere then 
@@ -186,10 +265,10 @@ void MeshModifier::buildInterfacialNodes
       // where traction are applied
       // 15 Nov 2017
 
-      if ( np->getIsOnBoundary () )
+      if ( nodes.getIsOnBoundary ( in ) )
       {
-        //double x  = np->getX    (); 
-        //double y  = np->getY    ();
+        //double x  = nodes.getX ( in ); 
+        //double y  = nodes.getY ( in );
 
         //if ( ( x > globdat.xMin ) && ( x < globdat.xMax ) )
         //{
@@ -206,73 +285,79 @@ void MeshModifier::buildInterfacialNodes
     {
       duplicity = matCount != 1 ? suppCount - rCount + 1 : suppCount;
     }
+    else
+    {
+      duplicity = nodes.getDuplicity ( in );    // converter: unchanged
+    }
 
-    np->setDuplicity   ( duplicity );
+    nodes.setDuplicity ( in, duplicity );
         
-    globdat.nodeMaterial.push_back ( std::accumulate(matSet.rbegin(), matSet.rend(),0));
+    material[in] = std::accumulate ( matSet.rbegin(), matSet.rend(), 0 );
+    state   [in] = matCount != 1 ? SUPPORTED | INTERFACE : SUPPORTED;
 
-    if ( matCount != 1 )    // interfacial node 
+    if ( matCount == 1 && globdat.isDomain )
     {
-      if ( !globdat.isIgSegment )   // option --noInterface is false
-      {
-        np->setIsInterface ( true ); 
-        globdat.interfaceNodes.push_back ( index );
-      }
-      else
+      if ( binary_search ( matSet.begin(), matSet.end(), globdat.rigidDomain[0] ) ||
+           binary_search ( matSet.begin(), matSet.end(), globdat.rigidDomain[1] ) )
       {
-	    if ( globdat.ignoredSegment.isOn ( np->getX(), np->getY() ) )
-	    {
-          np->setDuplicity   ( 1 );
-	    }
-	    else
-	    {
-	      np->setIsInterface ( true ); 
-          globdat.interfaceNodes.push_back ( index );
-	    }
+        nodes.setIsRigid ( in, true );
+        nodes.setDuplicity ( in, 1 );
       }
     }
+  } );
+
+  for ( int in = 0; in < nodeCount; in++ )
+  {
+    if ( !( state[in] & SUPPORTED ) ) continue;
+
+    globdat.nodeMaterial.push_back ( material[in] );
+
+    if ( !( state[in] & INTERFACE ) ) continue;
+
+    // interfacial node 
+
+    if ( !globdat.isIgSegment )   // option --noInterface is false
+    {
+      nodes.setIsInterface ( in, true ); 
+      globdat.interfaceNodes.push_back ( nodes.getIndex ( in ) );
+    }
     else
     {
-      if ( globdat.isDomain )
+      if ( globdat.ignoredSegment.isOn ( nodes.getX ( in ), nodes.getY ( in ) ) )
+      {
+        nodes.setDuplicity ( in, 1 );
+      }
+      else
       {
-	     if ( find ( matSet.begin(), 
-	                 matSet.end  (), 
-	     	    globdat.rigidDomain[0] ) != matSet.end () )
-	     {
-	       np->setIsRigid   ( true );
-	       np->setDuplicity ( 1    );
-	     }
-
-	     if ( find ( matSet.begin(), 
-	                 matSet.end  (), 
-	     	    globdat.rigidDomain[1] ) != matSet.end () )
-	     {
-	       np->setIsRigid   ( true );
-	       np->setDuplicity ( 1    );
-	     }
+        nodes.setIsInterface ( in, true ); 
+        globdat.interfaceNodes.push_back ( nodes.getIndex ( in ) );
       }
     }
+  }
 
-    matSet.clear (); // clear for the next node
+  // the interface builders read nodeMaterial at node positions;
+  // pad it so that they never read past its end
 
-  }
+  globdat.nodeMaterial.resize ( nodeCount, 0 );
 
   // For polycrystal, there are some edges connecting
   // two interfacial nodes but this edge is not a grain
   // boundary, so do not add interface element along this edge.
+  // (only used by the 2D polycrystal builder)
 
-  if ( globdat.isPolycrystal )
+  if ( globdat.isPolycrystal && !globdat.is3D )
   {
      int n1, n2; //, m1, m2, o1, o2;
      int neiCount, jelem, ielem;
      int imat, jmat;
 
      ElemPointer jp;
-     IntVector   neighbors, jnodes0;
+     IntSpan     neighbors;
+     IntSpan     connec, jnodes0;
 
      bool        found;
 
-     IntVector::const_iterator it1, it2;
+     IntSpan::const_iterator   it1, it2;
 
      // loop over all elements
 
@@ -287,10 +372,11 @@ void MeshModifier::buildInterfacialNodes
 	if ( ep->isInterfaceElement ( globdat.nodeSet, 
 	                              globdat.nodeId2Position, globdat ) ) 
 	{
-          neighbors = globdat.elemNeighbors[ie]; 
+          neighbors = globdat.elemNeighbors.getNeighbors ( ie ); 
 	  neiCount  = neighbors.size ();
 
-	  ep->getCornerConnectivity0 ( inodes ); //print (inodes.begin(), inodes.end());
+	  connec = ep->getCornerConnectivity0 (); //print (inodes.begin(), inodes.end());
+	  inodes.assign ( connec.begin(), connec.end() );
 	  inodes.push_back ( inodes[0] );  
 	  nnode = inodes.size()-1;
 
@@ -307,14 +393,10 @@ void MeshModifier::buildInterfacialNodes
 
 	    for ( int je = 0; je < neiCount; je++ )
 	    {
-	       jelem = globdat.elemId2Position[neighbors[je]];
+	       jelem = neighbors[je];
 	       jp    = globdat.elemSet[jelem];
 
-	       // omit element being considered
-
-	       if ( jp->getIndex() == ielem ) continue; 
-
-	       jp->getCornerConnectivity0 ( jnodes0 );
+	       jnodes0 = jp->getCornerConnectivity0 ();
 	       it1 = find ( jnodes0.begin(), jnodes0.end(), n1 );
 	       it2 = find ( jnodes0.begin(), jnodes0.end(), n2 );
 
@@ -322,7 +404,7 @@ void MeshModifier::buildInterfacialNodes
 
 	       if (  it1 != jnodes0.end()  && it2 != jnodes0.end()  )
 	       {
-                 jmat  = globdat.elem2Domain[neighbors[je]];
+                 jmat  = globdat.elem2Domain[jp->getIndex()];
                  
 		 //print (jnodes0.begin(), jnodes0.end());
 		 //cout << imat << "," << jmat << endl;
@@ -377,18 +459,16 @@ void MeshModifier::duplicateNodes
         int     index, duplicity;
 	int     idd(0);
 
-  NodePointer   np;
+  NodeSet&      nodes = globdat.nodeSet;
   
   for ( int in = 0; in < nodeCount; in++ )
   {
-    np    = globdat.nodeSet[in];
-
-    index = np->getIndex ();
+    index = nodes.getIndex ( in );
 
     // if only generate interface elements along material
     // interfaces, then ignore nodes which are not interfacial
 
-    if (  ( globdat.isInterface || globdat.isPolycrystal ) && !np->getIsInterface ()  ) 
+    if (  ( globdat.isInterface || globdat.isPolycrystal ) && !nodes.getIsInterface ( in )  ) 
     {
       continue;
     }
@@ -396,12 +476,12 @@ void MeshModifier::duplicateNodes
     // no interface elements in rigid domain then
     // not duplicate nodes that are defined rigid.
 
-    if ( ( globdat.isDomain ) && ( np->getIsRigid() ) )
+    if ( ( globdat.isDomain ) && ( nodes.getIsRigid ( in ) ) )
     {
       continue;
     }
 
-    duplicity = np->getDuplicity ();
+    duplicity = nodes.getDuplicity ( in );
 
     //cout << duplicity << "\n";
     
@@ -413,9 +493,7 @@ void MeshModifier::duplicateNodes
     {
       idd++;
 
-      globdat.newNodeSet.push_back ( NodePointer 	  
-        	                          ( new Node (np->getX(), np->getY(), np->getZ(), idd + nodeCount ) ) 
-                                   );
+      globdat.newNodeSet.addNode ( nodes.getX ( in ), nodes.getY ( in ), nodes.getZ ( in ), idd + nodeCount );
 
       globdat.duplicatedNodes[index].push_back ( idd + nodeCount );
     }
@@ -453,19 +531,17 @@ void MeshModifier::addFlowNodes
   globdat.flowNodes.resize ( nodeCount0 );
   //globdat.flowNodes = -1;
 
-  NodePointer   np;
+  NodeSet&      nodes = globdat.nodeSet;
   
   for ( int in = 0; in < nodeCount0; in++ )
   {
-    np    = globdat.nodeSet[in];
-
-    index = np->getIndex ();
+    index = nodes.getIndex ( in );
 
     // if only generate interface elements along material
     // interfaces, then ignore nodes which are not interfacial
 
     if (  ( globdat.isInterface || globdat.isPolycrystal ) && 
-	  !np->getIsInterface ()  ) 
+	  !nodes.getIsInterface ( in )  ) 
     {
       continue;
     }
@@ -473,12 +549,12 @@ void MeshModifier::addFlowNodes
     // no interface elements in rigid domain then
     // not duplicate nodes that are defined rigid.
 
-    if ( ( globdat.isDomain ) && ( np->getIsRigid() ) )
+    if ( ( globdat.isDomain ) && ( nodes.getIsRigid ( in ) ) )
     {
       continue;
     }
 
-    duplicity = np->getDuplicity ();
+    duplicity = nodes.getDuplicity ( in );
 
     //cout << duplicity << "\n";
     
@@ -486,8 +562,7 @@ void MeshModifier::addFlowNodes
  
     idd++;
 
-    globdat.newNodeSet.push_back ( NodePointer 	  
-	                             ( new Node (np->getX(), np->getY(), np->getZ(), idd + nodeCount ) ) );
+    globdat.newNodeSet.addNode ( nodes.getX ( in ), nodes.getY ( in ), nodes.getZ ( in ), idd + nodeCount );
 
     globdat.flowNodes[in] = ( idd + nodeCount );
   }
@@ -532,6 +607,31 @@ void MeshModifier::tearElements
 }
 
 
+// -------------------------------------------------------
+//    tearing rules
+// -------------------------------------------------------
+
+/*
+ *  Every tearing rule below handles the nodes on their own (on
+ *  --threads workers): for the element support[ie] of a node, it
+ *  stores the new id of the node in newIds[support.rowOffset(node)+ie]
+ *  instead of replacing the node in the connectivity of the element.
+ *  applyTearing then writes all the new ids, one element at a time.
+ */
+
+// a later new id for the same node and element only counts if the
+// earlier ones kept the old id (as successive changeConnectivity calls)
+
+static inline void  setNewId
+
+  ( int&  slot,
+    int   oldId,
+    int   newId )
+
+{
+  if ( slot < 0 || slot == oldId ) slot = newId;
+}
+
 // -------------------------------------------------------
 //    tearInterfaceElements
 // -------------------------------------------------------
@@ -541,49 +641,39 @@ void MeshModifier::tearInterfaceElements
   ( Global&  globdat )
 
 {
-  IntVector       support;
+  const CSRGraph& nodeSupport    = globdat.nodeSupport;
 
-  const int       interNodeCount = globdat.interfaceNodes.size (); 
+  const int       interNodeCount = globdat.interfaceNodes.size ();
 
-  int             inode; 
-  int             suppCount;
-  int             ielem;
-  int             mat,imat;
+  IntVector       newIds ( nodeSupport.entryCount (), -1 );
 
   // loop over interface nodes
 
-  for ( int in = 0; in < interNodeCount; in++ )
+  parallelFor ( interNodeCount, globdat.threadCount, [&] ( int in )
   {
-    inode      = globdat.interfaceNodes[in];
+    const int     inode     = globdat.interfaceNodes[in];
 
-    support    = globdat.nodeSupport[inode];
-    suppCount  = support.size ();
+    IntSpan       support   = nodeSupport[inode];
+    const int     suppCount = support.size ();
+    int* const    slots     = newIds.data () + nodeSupport.rowOffset ( inode );
 
-    mat        = globdat.elem2Domain[support[0]];
+    Int2IntVectMap::const_iterator dit = globdat.duplicatedNodes.find ( inode );
+
+    if ( dit == globdat.duplicatedNodes.end () ) return;
+
+    const int     mat       = globdat.elem2Domain.get ( support[0] );
 
     // loop over support of this node
 
     for ( int ie = 1; ie < suppCount; ie++ )
     {
-      ielem    = globdat.elemId2Position[support[ie]]; 
-      imat     = globdat.elem2Domain[support[ie]];
-
-      if ( imat == mat ) continue;
+      if ( globdat.elem2Domain.get ( support[ie] ) == mat ) continue;
 
-      globdat.elemSet[ielem]->changeConnectivity 
-	
-	             ( inode, globdat.duplicatedNodes[inode][1] );
+      setNewId ( slots[ie], inode, dit->second[1] );
     }
-  }
+  } );
 
-  if ( globdat.is3D )
-  {
-     cout << "  -rebuilding faces for 3D elements...\n";
-     for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
-     {
-       globdat.elemSet[ie]->buildFaces ();
-     }
-  }
+  applyTearing ( newIds, globdat );
 }
 
 // -------------------------------------------------------
@@ -595,50 +685,53 @@ void MeshModifier::tearDomainElements
   ( Global&  globdat )
 
 {
-  const  int         nodeCount = globdat.nodeSet.size ();
+  const CSRGraph&    nodeSupport = globdat.nodeSupport;
 
-         int         inode;
-     	 int         ielem, iel;
-	     int         suppCount;
+  const  int         nodeCount   = globdat.nodeSet.size ();
 
-	 IntVector   support;
+  IntVector          newIds ( nodeSupport.entryCount (), -1 );
 
-  for ( int in = 0; in < nodeCount; in++ )
+  parallelFor ( nodeCount, globdat.threadCount, [&] ( int in )
   {
     // ignore nodes in rigid domain
 
-    if ( globdat.nodeSet[in]->getIsRigid() ) 
+    if ( globdat.nodeSet.getIsRigid ( in ) )
     {
-      continue;
+      return;
     }
 
-    inode      = globdat.nodeSet[in]->getIndex ();
-    support    = globdat.nodeSupport[inode];
-    suppCount  = support.size ();
+    const int     inode     = globdat.nodeSet.getIndex ( in );
+
+    IntSpan       support   = nodeSupport[inode];
+    const int     suppCount = support.size ();
+    int* const    slots     = newIds.data () + nodeSupport.rowOffset ( inode );
+
+    Int2IntVectMap::const_iterator dit = globdat.duplicatedNodes.find ( inode );
+
+    if ( dit == globdat.duplicatedNodes.end () ) return;
+
+    const IntVector& dupNodes = dit->second;
 
     // different treatment for interfacial nodes
 
-    if ( globdat.nodeSet[in]->getIsInterface() )
+    if ( globdat.nodeSet.getIsInterface ( in ) )
     {
-      //cout << inode << ":   "; // detect interface node correctly
-      //print ( support.begin(), support.end() );
-      //print ( duplicatedNodes[inode].begin(), duplicatedNodes[inode].end());
-
       int c = 0;
 
       for ( int ie = 0; ie < suppCount; ie++ )
       {
-        iel      = support[ie];
-        if ( ( globdat.elem2Domain[iel] == globdat.rigidDomain[0] ) ||
-             ( globdat.elem2Domain[iel] == globdat.rigidDomain[1] ) )
+        const int dom = globdat.elem2Domain.get ( support[ie] );
+
+        if ( ( dom == globdat.rigidDomain[0] ) ||
+             ( dom == globdat.rigidDomain[1] ) )
 	    {
-	      continue; 
+	      continue;
 	    }
-        ielem    = globdat.elemId2Position[iel]; 
-        globdat.elemSet[ielem]->changeConnectivity ( inode, globdat.duplicatedNodes[inode][1+c] );
+
+        setNewId ( slots[ie], inode, dupNodes[1+c] );
 	    c++;
       }
-      continue;  // to next node (the below is skipped)
+      return;  // to next node (the below is skipped)
     }
 
     // the rest is handled in the following ...
@@ -646,21 +739,11 @@ void MeshModifier::tearDomainElements
 
     for ( int ie = 1; ie < suppCount; ie++ )
     {
-      iel      = support[ie];
-      ielem    = globdat.elemId2Position[iel]; 
-      
-      globdat.elemSet[ielem]->changeConnectivity ( inode, globdat.duplicatedNodes[inode][ie] );
-    }
-  }
-  
-  if ( globdat.is3D )
-  {
-    cout << "  -rebuilding faces for 3D elements...\n"; 
-    for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
-    {
-        globdat.elemSet[ie]->buildFaces ();
+      setNewId ( slots[ie], inode, dupNodes[ie] );
     }
-  }
+  } );
+
+  applyTearing ( newIds, globdat );
 }
 
 // -------------------------------------------------------
@@ -672,41 +755,35 @@ void MeshModifier::tearAllElements
   ( Global&  globdat )
 
 {
-  const  int         nodeCount = globdat.nodeSet.size ();
+  const CSRGraph&    nodeSupport = globdat.nodeSupport;
 
-         int         inode;
-	     int         ielem, iel;
-	     int         suppCount;
+  const  int         nodeCount   = globdat.nodeSet.size ();
 
-	     IntVector   support;
+  IntVector          newIds ( nodeSupport.entryCount (), -1 );
 
-  for ( int in = 0; in < nodeCount; in++ )
+  parallelFor ( nodeCount, globdat.threadCount, [&] ( int in )
   {
-    inode      = globdat.nodeSet[in]->getIndex ();
-    support    = globdat.nodeSupport[inode];
-    suppCount  = globdat.nodeSet[in]->getDuplicity ();
-    //suppCount  = support.size ();
+    const int     inode     = globdat.nodeSet.getIndex ( in );
+    const int     suppCount = globdat.nodeSet.getDuplicity ( in );
+
+    if ( suppCount < 2 ) return;
+
+    int* const    slots     = newIds.data () + nodeSupport.rowOffset ( inode );
+
+    Int2IntVectMap::const_iterator dit = globdat.duplicatedNodes.find ( inode );
+
+    if ( dit == globdat.duplicatedNodes.end () ) return;
 
     // first element in the support keeps the original connectivity
     // so, only loop over from second elem in the support
 
     for ( int ie = 1; ie < suppCount; ie++ )
     {
-      iel      = support[ie];
-      ielem    = globdat.elemId2Position[iel]; 
-      
-      globdat.elemSet[ielem]->changeConnectivity ( inode, globdat.duplicatedNodes[inode][ie] );
-    }
-  }
-   
-  if ( globdat.is3D )
-  {
-    cout << "  -rebuilding faces for 3D elements...\n"; 
-    for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
-    {
-        globdat.elemSet[ie]->buildFaces ();
+      setNewId ( slots[ie], inode, dit->second[ie] );
     }
-  }
+  } );
+
+  applyTearing ( newIds, globdat );
 }
 
 // -------------------------------------------------------
@@ -718,45 +795,48 @@ void MeshModifier::tearPolycrystalElements
   ( Global&  globdat )
 
 {
-  IntVector       support;
+  const CSRGraph& nodeSupport    = globdat.nodeSupport;
 
-  const int       interNodeCount = globdat.interfaceNodes.size (); 
+  const int       interNodeCount = globdat.interfaceNodes.size ();
 
-  int             inode, jnode; 
-  int             suppCount;
-  int             ielem, jelem;
-  int             mat, imat, jmat, matCount;
+  IntVector       newIds ( nodeSupport.entryCount (), -1 );
 
   // loop over interface nodes
 
-  for ( int in = 0; in < interNodeCount; in++ )
+  parallelFor ( interNodeCount, globdat.threadCount, [&] ( int in )
   {
-    inode      = globdat.interfaceNodes[in];
-    jnode      = globdat.nodeId2Position[inode];
+    const int     inode     = globdat.interfaceNodes[in];
+    const int     jnode     = globdat.nodeId2Position.get ( inode );
+
+    IntSpan       support   = nodeSupport[inode];
+    const int     suppCount = support.size ();
+    int* const    slots     = newIds.data () + nodeSupport.rowOffset ( inode );
 
-    support    = globdat.nodeSupport[inode];
-    suppCount  = support.size ();
+    const int     matCount  = globdat.nodeSet.getDuplicity ( jnode );
 
-    matCount   = globdat.nodeSet[jnode]->getDuplicity ();
+    int           mat, imat, jmat;
+
+    Int2IntVectMap::const_iterator dit = globdat.duplicatedNodes.find ( inode );
+
+    if ( dit == globdat.duplicatedNodes.end () ) return;
+
+    const IntVector& dupNodes = dit->second;
 
     // loop over support of this node
 
     if ( matCount == 2 ) // node between 2 intergrnular boundaries
     {
       // first element in the support is kept unchanded
-    
-      mat = globdat.elem2Domain[support[0]];
+
+      mat = globdat.elem2Domain.get ( support[0] );
 
       for ( int ie = 1; ie < suppCount; ie++ )
       {
-	ielem    = globdat.elemId2Position[support[ie]]; 
-	imat     = globdat.elem2Domain[support[ie]];
+	imat     = globdat.elem2Domain.get ( support[ie] );
 
 	if ( imat == mat ) continue;
 
-	globdat.elemSet[ielem]->changeConnectivity 
-	  
-	          ( inode, globdat.duplicatedNodes[inode][1] );
+	setNewId ( slots[ie], inode, dupNodes[1] );
       }
     }
     else // nodes at the junction with 3 materials
@@ -773,22 +853,17 @@ void MeshModifier::tearPolycrystalElements
 	  continue;
 	}
 
-	ielem    = globdat.elemId2Position[support[ie]]; 
-	imat     = globdat.elem2Domain[support[ie]];
+	imat     = globdat.elem2Domain.get ( support[ie] );
 
         for ( int je = 0; je < suppCount; je++ )
         {
 	  if ( je < ie ) continue;
 
-	  jmat     = globdat.elem2Domain[support[je]]; 
+	  jmat     = globdat.elem2Domain.get ( support[je] );
 
 	  if ( jmat != imat ) continue;
-	
-	  jelem    = globdat.elemId2Position[support[je]]; 
 
-	  globdat.elemSet[jelem]->changeConnectivity 
-
-	            ( inode, globdat.duplicatedNodes[inode][jj] );
+	  setNewId ( slots[je], inode, dupNodes[jj] );
 
 	  doneNodes.push_back ( ie );
 	  doneNodes.push_back ( je );
@@ -797,14 +872,67 @@ void MeshModifier::tearPolycrystalElements
 	jj++;
       }
     }
-  }
+  } );
+
+  applyTearing ( newIds, globdat );
+}
+
+// -------------------------------------------------------
+//    applyTearing
+// -------------------------------------------------------
+
+/*
+ *  Every element only writes its own connectivity (and faces): the
+ *  local node in gets the new id of the entry of the element in the
+ *  support of that node. Only the 3D elements whose connectivity did
+ *  change need their faces rebuilt (see Element::buildFaces0).
+ */
+
+void MeshModifier::applyTearing
+
+  ( const IntVector&  newIds,
+    Global&           globdat )
+
+{
+  const CSRGraph&  nodeSupport = globdat.nodeSupport;
+
+  const int        elemCount   = globdat.elemSet.size ();
 
   if ( globdat.is3D )
   {
-    cout << "  -rebuilding faces for 3D elements...\n"; 
-    for ( int ie = 0; ie < globdat.elemSet.size (); ie++ )
+    cout << "  -rebuilding faces for 3D elements...\n";
+
+    // buildFaces must not grow the face pool in the parallel loop
+
+    globdat.elemSet.reserveFaces ();
+  }
+
+  parallelFor ( elemCount, globdat.threadCount, [&] ( int ie )
+  {
+    ElemPointer   ep        = globdat.elemSet[ie];
+    IntSpan       connec    = ep->getConnectivity ();
+    const int     ielem     = ep->getIndex        ();
+    const int     nodeCount = connec.size ();
+
+    for ( int in = 0; in < nodeCount; in++ )
     {
-        globdat.elemSet[ie]->buildFaces ();
+      const int   inode   = connec[in];
+
+      IntSpan     support = nodeSupport[inode];
+      const int*  slots   = newIds.data () + nodeSupport.rowOffset ( inode );
+
+      for ( int je = 0; je < support.size (); je++ )
+      {
+        if ( support[je] != ielem ) continue;
+
+        if ( slots[je] >= 0 && slots[je] != inode )
+        {
+          ep->changeNode ( in, slots[je] );
+          break;
+        }
+      }
     }
-  }
+
+    if ( globdat.is3D && ep->getChanged () ) ep->buildFaces ();
+  } );
 }
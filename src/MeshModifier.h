@@ -1,6 +1,8 @@
 #ifndef MESH_MODIFIER_H
 #define MESH_MODIFIER_H
 
+#include "typedefs.h"
+
 struct Global;
 
 // ========================================================
@@ -23,6 +25,14 @@ class MeshModifier
 
      ( Global& globdat );
 
+  static void        buildFaceTable
+
+     ( Global& globdat );
+
+  static void        buildEdgeTable
+
+     ( Global& globdat );
+
   static void        buildInterfacialNodes
 
      ( Global& globdat );
@@ -56,6 +66,14 @@ class MeshModifier
   static void        tearPolycrystalElements
 
      ( Global& globdat );
+
+  // newIds holds one id per entry of the nodal support (-1: unchanged);
+  // write them to the element connectivities (and rebuild the faces)
+
+  static void        applyTearing
+
+     ( const IntVector&  newIds,
+       Global&           globdat );
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "MeshReader.h"
 #include "Global.h"
 #include "Element.h"
+#include "GmshMeshCache.h"
 
 // =====================================================================
 //     readMesh
@@ -19,12 +20,52 @@ void                     readMesh
 {
   string    filename  ( fileName );
   StrVector filenames;
+  string    cacheState;
 
   boost::split ( filenames, filename, boost::is_any_of(".") );
 
   if      ( filenames[1] == "msh" )
   {
-    readGmshMesh ( globdat, fileName );
+    GmshMeshCache  cache ( fileName );
+    GmshMeshCache* record = 0;
+
+    // with --mesh-cache, use the sidecar file if it is up to date,
+    // otherwise read the mesh file and record it for the next run
+
+    if ( globdat.useMeshCache )
+    {
+      if ( cache.load () )
+      {
+        cout << "Reading Gmsh mesh cache " << cache.getFileName () << " ...\n";
+
+        cache.replay ( globdat );
+
+        cacheState = "hit";
+      }
+      else
+      {
+        record     = &cache;
+        cacheState = "miss";
+      }
+    }
+
+    if ( cacheState != "hit" )
+    {
+      if ( readGmshVersion ( fileName ) >= 4. )
+      {
+        readGmsh4Mesh ( globdat, fileName, record );
+      }
+      else
+      {
+        readGmshMesh  ( globdat, fileName, record );
+      }
+    }
+
+    if ( record )
+    {
+      if ( cache.save () ) cacheState += " (written " + cache.getFileName () + ")";
+      else                 cacheState += " (unable to write "  + cache.getFileName () + ")";
+    }
   }
   else if ( filenames[1] == "nurbs" )
   {
@@ -55,6 +96,9 @@ void                     readMesh
   cout << "Number of elements............................ " << globdat.elemSet.size       () << endl;
   cout << "Number of element groups...................... " << globdat.dom2Elems.size     () << endl;
   cout << "Number of boundary element groups............. " << globdat.dom2BndElems.size  () << endl;
+  if ( globdat.useMeshCache ){
+  cout << "Mesh cache.................................... " << ( cacheState.empty () ? "not used" : cacheState ) << endl;
+  }
   if (globdat.is3D){
   cout << "Three dimensional mesh is being considered\n";
   }
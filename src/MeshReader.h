@@ -2,11 +2,26 @@
 #define MESH_READER_H
 
 struct Global;
+class  GmshMeshCache;
+
+// entities read from the file are recorded in cache if given
 
 void                     readGmshMesh 
 
-    ( Global&     globdat,
-      const char* fileName );
+    ( Global&        globdat,
+      const char*    fileName,
+      GmshMeshCache* cache = 0 );
+
+
+void                     readGmsh4Mesh 
+
+    ( Global&        globdat,
+      const char*    fileName,
+      GmshMeshCache* cache = 0 );
+
+double                   readGmshVersion 
+
+    ( const char* fileName );
 
 
 void                     readNURBSMesh 
@@ -66,16 +66,14 @@ void                     readNURBSMesh
   {
     file >> id >> x >> y;
 
-    globdat.nodeSet.push_back ( NodePointer( new Node(x,y,z,id) ) );
-
-    globdat.nodeId2Position[id] = globdat.nodeSet.size()-1;
+    globdat.nodeId2Position[id] = globdat.nodeSet.addNode ( x, y, z, id );
   }
 
   // checking two or three dimensional mesh
 
   for ( int in = 0; in < nodeCount; in++ )
   {
-    if ( globdat.nodeSet[in]->getZ() != 0. )
+    if ( globdat.nodeSet.getZ ( in ) != 0. )
     {
       globdat.is3D = true;
       break;
@@ -115,7 +113,7 @@ void                     readNURBSMesh
        case 6: elemType = 9; break;     // six node triangle elements
     }
 
-    globdat.elemSet.push_back ( ElemPointer ( new Element ( ie, elemType, connectivity, true ) )  );
+    globdat.elemSet.addElement ( ie, elemType, connectivity, true );
 
     globdat.elemId2Position[ie] = globdat.elemSet.size() - 1;
   }
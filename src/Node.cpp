@@ -1,20 +1,46 @@
 #include "Node.h"
 
+// ------------------------------------------------------------
+//    reserve, clear
+// ------------------------------------------------------------
 
-Node::Node ( double x, double y, double z, int index )
-  : x_(x), y_(y), z_(z), index_(index), 
-    duplicity_(1), interface_(false),
-    onBoundary_(false), done_(false), isRigid_(false)
+void NodeSet::reserve ( int count )
 {
+  x_        .reserve ( count );
+  y_        .reserve ( count );
+  z_        .reserve ( count );
+  index_    .reserve ( count );
+  duplicity_.reserve ( count );
+  flags_    .reserve ( count );
 }
 
-Node::Node ( const Node& aNode )
-  : x_(aNode.getX()), y_(aNode.getY()), index_(aNode.getIndex())
+void NodeSet::clear ()
 {
+  x_        .clear ();
+  y_        .clear ();
+  z_        .clear ();
+  index_    .clear ();
+  duplicity_.clear ();
+  flags_    .clear ();
 }
 
-ostream&  operator << ( ostream& os, const Node& aNode )
+// ------------------------------------------------------------
+//    addNode
+// ------------------------------------------------------------
+
+int NodeSet::addNode
+
+  ( double  x,
+    double  y,
+    double  z,
+    int     index )
 {
-  return os;
-}
+  x_        .push_back ( x     );
+  y_        .push_back ( y     );
+  z_        .push_back ( z     );
+  index_    .push_back ( index );
+  duplicity_.push_back ( 1     );
+  flags_    .push_back ( 0     );
 
+  return index_.size () - 1;
+}
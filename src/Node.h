@@ -4,87 +4,94 @@
 #include "typedefs.h"
 
 // =====================================================================
-//     class NODE
+//     class NodeSet
 // =====================================================================
 
-class Node
+/*
+ * The nodes are stored as a structure of arrays: coordinates, ids and
+ * duplicities in contiguous vectors and the boolean attributes packed
+ * in one byte per node. A node is referred to by its position in the
+ * set (see Global::nodeId2Position for id => position).
+ */
+
+class NodeSet
 {
   public:
 
-                     Node ( double x, double y, double z, int index );
+    int              size           () const { return index_.size (); }
+    bool             empty          () const { return index_.empty (); }
 
-		     Node ( const Node& aNode );
+    void             reserve        ( int count );
+    void             clear          ();
 
-    double           getX           () const { return x_; }		     
-    double           getY           () const { return y_; }		     
-    double           getZ           () const { return z_; }		     
-    double           getIndex       () const { return index_; }
-    bool             getIsInterface () const { return interface_;}
-    bool             getIsOnBoundary() const { return onBoundary_;}
-    bool             getDone        () const { return done_;}
-    bool             getIsRigid     () const { return isRigid_;}
+    // append a node (duplicity 1, no flags set), return its position
 
-    int              getDuplicity   () const { return duplicity_;}
+    int              addNode
 
+      ( double         x,
+        double         y,
+        double         z,
+        int            index );
 
-    void             setDuplicity   ( int dupl ) { duplicity_ = dupl; }
+    double           getX           ( int i ) const { return x_[i]; }
+    double           getY           ( int i ) const { return y_[i]; }
+    double           getZ           ( int i ) const { return z_[i]; }
+    int              getIndex       ( int i ) const { return index_[i]; }
+    int              getDuplicity   ( int i ) const { return duplicity_[i]; }
 
-    void             setIsInterface ( bool interface ) { interface_ = interface; }
+    bool             getIsInterface ( int i ) const { return flags_[i] & INTERFACE; }
+    bool             getIsOnBoundary( int i ) const { return flags_[i] & BOUNDARY; }
+    bool             getDone        ( int i ) const { return flags_[i] & DONE; }
+    bool             getIsRigid     ( int i ) const { return flags_[i] & RIGID; }
 
-    void             setIsOnBoundary ( bool bound ) { onBoundary_ = bound; }
+    void             setDuplicity   ( int i, int dupl ) { duplicity_[i] = dupl; }
 
-    void             setDone ( bool done ){ done_ = done;}
+    void             setIsInterface ( int i, bool interface ) { setFlag_ ( i, INTERFACE, interface ); }
 
-    void             setIsRigid ( bool rig )
-    {
-      isRigid_ = rig;
+    void             setIsOnBoundary( int i, bool bound )     { setFlag_ ( i, BOUNDARY, bound ); }
+
+    void             setDone        ( int i, bool done )      { setFlag_ ( i, DONE, done ); }
 
-      if ( interface_ ) isRigid_ = false;
+    // an interface node is never rigid
+
+    void             setIsRigid     ( int i, bool rig )
+    {
+      setFlag_ ( i, RIGID, rig && !getIsInterface ( i ) );
     }
 
-  public:
+    // coordinate and id arrays, for sweeps over all nodes
 
-    IntVector        support;
+    const double*    getXData       () const { return x_.data (); }
+    const double*    getYData       () const { return y_.data (); }
+    const double*    getZData       () const { return z_.data (); }
+    const int*       getIndexData   () const { return index_.data (); }
 
   private:
 
-    double           x_;
-    double           y_;
-    double           z_;
-
-    int              index_;
-    int              duplicity_;
+    enum             Flag
+    {
+      INTERFACE = 1,
+      BOUNDARY  = 2,
+      DONE      = 4,
+      RIGID     = 8
+    };
 
-    bool             interface_;
-    bool             onBoundary_;
-    bool             done_;
-    bool             isRigid_;
-};
+    void             setFlag_       ( int i, Flag flag, bool on )
+    {
+      if ( on ) flags_[i] |=  flag;
+      else      flags_[i] &= ~flag;
+    }
 
-ostream&  operator << ( ostream& os, const Node& aNode );
+  private:
 
-struct XCoordComp 
-{
-  bool operator () ( const NodePointer n1, const NodePointer n2 )
-  {
-    return n1->getX() < n2->getX();  
-  }
-};
+    vector<double>          x_;
+    vector<double>          y_;
+    vector<double>          z_;
 
-struct YCoordComp 
-{
-  bool operator () ( const NodePointer n1, const NodePointer n2 )
-  {
-    return n1->getY() < n2->getY();  
-  }
-};
+    IntVector               index_;
+    IntVector               duplicity_;
 
-struct ZCoordComp 
-{
-  bool operator () ( const NodePointer n1, const NodePointer n2 )
-  {
-    return n1->getZ() < n2->getZ();  
-  }
+    vector<unsigned char>   flags_;
 };
 
 #endif
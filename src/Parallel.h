@@ -0,0 +1,52 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * Minimal helpers to run independent tasks on a few threads. The tasks
+ * are given to the threads in contiguous blocks and every task writes
+ * to its own output, so that merging the results in task order gives
+ * the same answer as the serial code, whatever the number of threads.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <thread>
+
+#include "typedefs.h"
+
+// --------------------------------------------------------------------
+//   parallelFor: func(i) for i = 0 ... taskCount-1
+// --------------------------------------------------------------------
+
+template <class Func>
+void parallelFor ( int          taskCount,
+                   int          threadCount,
+                   const Func&  func )
+{
+  if ( threadCount > taskCount ) threadCount = taskCount;
+
+  if ( threadCount <= 1 )
+  {
+    for ( int i = 0; i < taskCount; i++ ) func ( i );
+    return;
+  }
+
+  vector<std::thread>  threads;
+
+  threads.reserve ( threadCount );
+
+  for ( int it = 0; it < threadCount; it++ )
+  {
+    const int first = (int) ( (long long) taskCount *  it      / threadCount );
+    const int last  = (int) ( (long long) taskCount * (it + 1) / threadCount );
+
+    threads.push_back ( std::thread ( [&func, first, last] ()
+    {
+      for ( int i = first; i < last; i++ ) func ( i );
+    } ) );
+  }
+
+  for ( size_t it = 0; it < threads.size (); it++ ) threads[it].join ();
+}
+
+#endif
@@ -0,0 +1,387 @@
+#include <cstdint>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "ParaviewWriter.h"
+#include "Global.h"
+#include "Element.h"
+#include "ElementTraits.h"
+#include "Node.h"
+#include "Parallel.h"
+#include "TextWriter.h"
+
+// ---------------------------------------------------------
+//   DataArray
+// ---------------------------------------------------------
+
+// an array of the appended data of the VTU file: the raw bytes of the
+// array, or the zlib compressed form (header and blocks of VTK)
+
+struct DataArray
+{
+  const char*    type;
+  const char*    name;
+  int            components;
+
+  const void*    data;
+  size_t         size;       // bytes of the array
+  vector<char>   packed;     // compressed array, empty if raw
+
+  size_t         appendedSize () const
+  {
+    return packed.empty () ? sizeof(uint64_t) + size : packed.size ();
+  }
+};
+
+// ---------------------------------------------------------
+//   compressArray
+// ---------------------------------------------------------
+
+/*
+ * The array is cut in blocks of BLOCK_SIZE bytes that are compressed
+ * on their own (on --threads threads). The header is the number of
+ * blocks, the size of a block, the size of the last block and the
+ * compressed size of every block, all UInt64.
+ */
+
+#ifdef HAVE_ZLIB
+
+static void  compressArray
+
+  ( DataArray&  array,
+    int         threadCount )
+
+{
+  const size_t          BLOCK_SIZE = 1 << 20;
+
+  const int             blockCount = ( array.size + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+  const Bytef*          data       = static_cast<const Bytef*> ( array.data );
+
+  vector< vector<char> > blocks    ( blockCount );
+  vector<uint64_t>       header    ( 3 + blockCount );
+
+  parallelFor ( blockCount, threadCount, [&] ( int ib )
+  {
+    const size_t  first = ib * BLOCK_SIZE;
+    const size_t  size  = std::min ( BLOCK_SIZE, array.size - first );
+    uLongf        count = compressBound ( size );
+
+    blocks[ib].resize ( count );
+
+    if ( compress2 ( reinterpret_cast<Bytef*> ( blocks[ib].data () ), &count,
+                     data + first, size, Z_BEST_SPEED ) != Z_OK )
+    {
+      cout << "Unable to compress the ParaView file!!!\n\n";
+      exit(1);
+    }
+
+    blocks[ib].resize ( count );
+  } );
+
+  header[0] = blockCount;
+  header[1] = BLOCK_SIZE;
+  header[2] = blockCount ? array.size - ( blockCount - 1 ) * BLOCK_SIZE : 0;
+
+  size_t total = header.size () * sizeof(uint64_t);
+
+  for ( int ib = 0; ib < blockCount; ib++ )
+  {
+    header[3+ib] = blocks[ib].size ();
+    total       += blocks[ib].size ();
+  }
+
+  array.packed.reserve ( total );
+
+  const char* h = reinterpret_cast<const char*> ( header.data () );
+
+  array.packed.insert ( array.packed.end (), h, h + header.size () * sizeof(uint64_t) );
+
+  for ( int ib = 0; ib < blockCount; ib++ )
+  {
+    array.packed.insert ( array.packed.end (), blocks[ib].begin (), blocks[ib].end () );
+  }
+}
+
+#endif
+
+// ---------------------------------------------------------
+//   writeParaview
+// ---------------------------------------------------------
+
+/*
+ * Write the modified mesh to a VTK XML unstructured grid (VTU) with
+ * the data arrays appended as raw binary (zlib compressed with
+ * --paraview-zlib if the program is built with ZLIB=1). Cells are the
+ * bulk elements followed by the interface elements; an interface
+ * element is drawn as the zero-thickness quad (2D), wedge or hexahedron
+ * (3D) between the corner nodes of its two faces, and as a line for
+ * discrete interface elements.
+ *
+ * Cell data: domain (domain of bulk elements, material of interface
+ * elements), interface (1 for interface elements), elementId (as in
+ * the jem/jive files). Point data: nodeId.
+ */
+
+void  writeParaview
+
+(       Global&  globdat,
+  const char*    fileName )
+
+{
+  const NodeSet& nodes     = globdat.newNodeSet;
+  const int      nodeCount = nodes.size ();
+  const int      elemCount = globdat.elemSet.size ();
+  const int      ieCount   = globdat.isConverter ? 0 : globdat.interfaceSet.size ();
+  const int      cellCount = elemCount + ieCount;
+
+  bool           compressed = globdat.isParaviewZlib;
+
+#ifndef HAVE_ZLIB
+  if ( compressed )
+  {
+    cout << "zlib not available, writing uncompressed ParaView file\n";
+    compressed = false;
+  }
+#endif
+
+  cout << "Writing ParaView file...\n";
+
+  // points, node id => point
+
+  vector<double>   points   ( 3 * nodeCount );
+  vector<int32_t>  nodeIds  ( nodeCount );
+
+  IdMap            id2Point;
+
+  for ( int in = 0; in < nodeCount; in++ )
+  {
+    points[3*in  ]          = nodes.getX ( in );
+    points[3*in+1]          = nodes.getY ( in );
+    points[3*in+2]          = globdat.is3D ? nodes.getZ ( in ) : 0.;
+    nodeIds[in]             = nodes.getIndex ( in );
+
+    id2Point[nodeIds[in]]   = in;
+  }
+
+  // cells: bulk elements, then interface elements
+
+  vector<int64_t>  connec;
+  vector<int64_t>  offsets     ( cellCount );
+  vector<uint8_t>  types       ( cellCount );
+  vector<int32_t>  domains     ( cellCount );
+  vector<uint8_t>  isInterface ( cellCount, 0 );
+  vector<int32_t>  elemIds     ( cellCount );
+
+  ElemPointer      ep;
+  IntSpan          inodes;
+
+  connec.reserve ( (size_t) elemCount * globdat.nodeElemCount +
+                   (size_t) ieCount   * globdat.nodeICount );
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    ep     = globdat.elemSet[ie];
+    inodes = ep->getConnectivity ();
+
+    const int   type  = getParaElemType ( ep->getElemType () );
+    const int*  order = getVtkOrder     ( ep->getElemType () );
+
+    if ( type < 0 )
+    {
+      cout << "Element type " << ep->getElemType ()
+           << " not supported, ParaView file not written\n\n";
+      return;
+    }
+
+    for ( int in = 0; in < inodes.size (); in++ )
+    {
+      connec.push_back ( id2Point.get ( inodes[order ? order[in] : in] ) );
+    }
+
+    offsets[ie] = connec.size ();
+    types  [ie] = type;
+    domains[ie] = globdat.elem2Domain.get ( ep->getIndex () );
+    elemIds[ie] = ep->getIndex ();
+  }
+
+  for ( int ie = 0; ie < ieCount; ie++ )
+  {
+    ep     = globdat.interfaceSet[ie];
+    inodes = ep->getConnectivity ();
+
+    // the first half of the nodes is on one face, the second half
+    // (in the same order) on the other one
+
+    const int   half    = inodes.size () / 2;
+    const int   ic      = elemCount + ie;
+
+    if      ( half == 1 )                 // discrete interface
+    {
+      connec.push_back ( id2Point.get ( inodes[0] ) );
+      connec.push_back ( id2Point.get ( inodes[1] ) );
+      types[ic] = 3;
+    }
+    else if ( !globdat.is3D )             // quad n1 n2 p2 p1
+    {
+      connec.push_back ( id2Point.get ( inodes[0]        ) );
+      connec.push_back ( id2Point.get ( inodes[half-1]   ) );
+      connec.push_back ( id2Point.get ( inodes[2*half-1] ) );
+      connec.push_back ( id2Point.get ( inodes[half]     ) );
+      types[ic] = 9;
+    }
+    else                                  // corners of the two faces
+    {
+      // the corners of a face are the nodes of the face that are corners
+      // of the element on the first side: the faces of doFor3DMatInterface
+      // alternate corner and midside nodes, the other ones do not
+
+      int       corner[4];
+      int       corners = 0;
+
+      if ( half <= 4 )
+      {
+        for ( ; corners < half; corners++ ) corner[corners] = corners;
+      }
+      else
+      {
+        ElemPointer  bp     = globdat.elemSet[globdat.elemId2Position.get ( ep->getBulk1 () )];
+        IntSpan      bnodes = bp->getConnectivity ();
+
+        IntSpan::const_iterator  bend = bnodes.begin () + getCornerCount ( bp->getElemType () );
+
+        for ( int in = 0; in < half && corners < 4; in++ )
+        {
+          if ( find ( bnodes.begin (), bend, inodes[in] ) != bend ) corner[corners++] = in;
+        }
+      }
+
+      if ( corners < 3 )
+      {
+        cout << "Interface element " << ie
+             << " not supported, ParaView file not written\n\n";
+        return;
+      }
+
+      for ( int in = 0; in < corners; in++ )
+      {
+        connec.push_back ( id2Point.get ( inodes[corner[in]] ) );
+      }
+      for ( int in = 0; in < corners; in++ )
+      {
+        connec.push_back ( id2Point.get ( inodes[half+corner[in]] ) );
+      }
+      types[ic] = corners == 3 ? 13 : 12;
+    }
+
+    offsets    [ic] = connec.size ();
+    domains    [ic] = globdat.interfaceMats[ie];
+    isInterface[ic] = 1;
+    elemIds    [ic] = ep->getIndex ();
+  }
+
+  // data arrays, in the order of the appended data
+
+  DataArray        arrays[] =
+  {
+    { "Int32",   "nodeId",       1, nodeIds    .data (), nodeIds    .size () * sizeof(int32_t) },
+    { "Int32",   "domain",       1, domains    .data (), domains    .size () * sizeof(int32_t) },
+    { "UInt8",   "interface",    1, isInterface.data (), isInterface.size () * sizeof(uint8_t) },
+    { "Int32",   "elementId",    1, elemIds    .data (), elemIds    .size () * sizeof(int32_t) },
+    { "Float64", "Points",       3, points     .data (), points     .size () * sizeof(double)  },
+    { "Int64",   "connectivity", 1, connec     .data (), connec     .size () * sizeof(int64_t) },
+    { "Int64",   "offsets",      1, offsets    .data (), offsets    .size () * sizeof(int64_t) },
+    { "UInt8",   "types",        1, types      .data (), types      .size () * sizeof(uint8_t) }
+  };
+
+  const int        arrayCount = sizeof(arrays) / sizeof(arrays[0]);
+
+#ifdef HAVE_ZLIB
+  if ( compressed )
+  {
+    for ( int ia = 0; ia < arrayCount; ia++ )
+    {
+      compressArray ( arrays[ia], globdat.threadCount );
+    }
+  }
+#endif
+
+  // XML part, offsets of the arrays in the appended data
+
+  TextWriter       file;
+
+  if ( !file.open ( fileName ) )
+  {
+    cout << "Unable to open ParaView file!!!\n\n";
+    exit(1);
+  }
+
+  const uint16_t   one       = 1;
+  const bool       isLittle  = *reinterpret_cast<const char*> ( &one ) == 1;
+
+  size_t           offset    = 0;
+  int              ia        = 0;
+
+  auto writeArray = [&] ()
+  {
+    const DataArray& array = arrays[ia++];
+
+    file << "<DataArray type=\"" << array.type << "\" Name=\"" << array.name << "\"";
+
+    if ( array.components > 1 )
+    {
+      file << " NumberOfComponents=\"" << array.components << "\"";
+    }
+
+    file << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+
+    offset += array.appendedSize ();
+  };
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << ( isLittle ? "LittleEndian" : "BigEndian" )
+       << "\" header_type=\"UInt64\"";
+
+  if ( compressed ) file << " compressor=\"vtkZLibDataCompressor\"";
+
+  file << ">\n<UnstructuredGrid>\n"
+       << "<Piece NumberOfPoints=\"" << nodeCount
+       << "\" NumberOfCells=\""      << cellCount << "\">\n";
+
+  file << "<PointData>\n";                       writeArray ();
+  file << "</PointData>\n";
+  file << "<CellData Scalars=\"domain\">\n";     writeArray (); writeArray (); writeArray ();
+  file << "</CellData>\n";
+  file << "<Points>\n";                          writeArray ();
+  file << "</Points>\n";
+  file << "<Cells>\n";                           writeArray (); writeArray (); writeArray ();
+  file << "</Cells>\n";
+
+  file << "</Piece>\n</UnstructuredGrid>\n"
+       << "<AppendedData encoding=\"raw\">\n_";
+
+  for ( ia = 0; ia < arrayCount; ia++ )
+  {
+    const DataArray& array = arrays[ia];
+
+    if ( array.packed.empty () )
+    {
+      const uint64_t size = array.size;
+
+      file.writeBytes ( &size,      sizeof(size) );
+      file.writeBytes ( array.data, array.size   );
+    }
+    else
+    {
+      file.writeBytes ( array.packed.data (), array.packed.size () );
+    }
+  }
+
+  file << "\n</AppendedData>\n</VTKFile>\n";
+
+  file.close ();
+
+  cout << "Writing ParaView file...done!\n\n";
+}
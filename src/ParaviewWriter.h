@@ -0,0 +1,12 @@
+#ifndef PARAVIEW_WRITER_H
+#define PARAVIEW_WRITER_H
+
+struct Global;
+
+void  writeParaview
+
+(       Global&  globdat,
+  const char*    fileName );
+
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * numberSharedFaces gives one number to the local faces (3D) or edges
+ * (2D) of the elements that have the same corner nodes. It is used by
+ * FaceTable and EdgeTable.
+ *
+ * Every local face is a slot; the slots of the element at position ie
+ * are [slotOffset[ie], slotOffset[ie+1]) and slot s has the N sorted
+ * nodes keys[N*s ...] (the smallest first, padding last). The elements
+ * sharing a face all hold its smallest node, so they are found in the
+ * nodal support of that node, without a global search. Every element
+ * is handled on its own, which makes the threads independent. Faces
+ * are numbered in the order of their first slot, as a serial loop over
+ * the elements and their local faces would number them.
+ */
+
+#ifndef SHARED_FACES_H
+#define SHARED_FACES_H
+
+#include "typedefs.h"
+#include "CSRGraph.h"
+#include "IdMap.h"
+#include "Parallel.h"
+
+// --------------------------------------------------------------------
+//   numberSharedFaces
+// --------------------------------------------------------------------
+
+// faceIds    : face number of every slot
+// ownerCount : number of slots of every face
+// elems      : two per face, elements holding the first two slots, -1 if none
+// locals     : two per face, local index of these slots, -1 if none
+//
+// support gives the ids of the elements around a node (in the order of
+// the elements) and elemPositions their positions.
+
+template <int N>
+int                numberSharedFaces
+
+  ( IntVector&        faceIds,
+    IntVector&        ownerCount,
+    IntVector&        elems,
+    IntVector&        locals,
+    const IntVector&  slotOffset,
+    const IntVector&  keys,
+    const CSRGraph&   support,
+    const IdMap&      elemPositions,
+    int               threadCount )
+
+{
+  const int  elemCount = slotOffset.size () - 1;
+  const int  slotCount = slotOffset[elemCount];
+
+  IntVector  first  ( slotCount );
+  IntVector  second ( slotCount );
+  IntVector  count  ( slotCount );
+
+  int        faceCount = 0;
+
+  // the first two slots with the same nodes as every slot
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    for ( int s = slotOffset[ie]; s < slotOffset[ie+1]; s++ )
+    {
+      const int*  key    = &keys[N*s];
+      IntSpan     around = support[key[0]];
+
+      int         prev   = -1;
+      int         found  = 0;
+
+      first [s] = s;
+      second[s] = -1;
+
+      for ( int j = 0; j < around.size (); j++ )
+      {
+        const int je = elemPositions.get ( around[j] );
+
+        if ( je == prev ) continue;
+
+        prev = je;
+
+        for ( int t = slotOffset[je]; t < slotOffset[je+1]; t++ )
+        {
+          if ( !std::equal ( key, key + N, &keys[N*t] ) ) continue;
+
+          if      ( found == 0 ) first [s] = t;
+          else if ( found == 1 ) second[s] = t;
+
+          found++;
+        }
+      }
+
+      count[s] = found;
+    }
+  } );
+
+  faceIds.resize ( slotCount );
+
+  for ( int s = 0; s < slotCount; s++ )
+  {
+    if ( first[s] == s ) faceIds[s] = faceCount++;
+  }
+
+  ownerCount.resize ( faceCount );
+  elems     .assign ( 2 * faceCount, -1 );
+  locals    .assign ( 2 * faceCount, -1 );
+
+  parallelFor ( elemCount, threadCount, [&] ( int ie )
+  {
+    for ( int s = slotOffset[ie]; s < slotOffset[ie+1]; s++ )
+    {
+      if ( first[s] != s )
+      {
+        faceIds[s] = faceIds[first[s]];
+        continue;
+      }
+
+      const int id = faceIds[s];
+
+      ownerCount[id] = count[s];
+      elems     [2*id] = ie;
+      locals    [2*id] = s - slotOffset[ie];
+
+      if ( second[s] >= 0 )
+      {
+        const int t  = second[s];
+        const int je = std::upper_bound ( slotOffset.begin (), slotOffset.end (), t )
+                       - slotOffset.begin () - 1;
+
+        elems [2*id+1] = je;
+        locals[2*id+1] = t - slotOffset[je];
+      }
+    }
+  } );
+
+  return faceCount;
+}
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * A forward-only scanner over a block of text in memory (typically a
+ * MappedFile). Numbers are converted in place with std::from_chars, so
+ * no strings are allocated while reading nodes and elements. Binary
+ * blocks embedded in the text (binary Gmsh files) are copied out with
+ * readBytes.
+ */
+
+#ifndef TEXT_SCANNER_H
+#define TEXT_SCANNER_H
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#include "typedefs.h"
+
+// =====================================================================
+//     class TextScanner
+// =====================================================================
+
+class TextScanner
+{
+  public:
+
+                     TextScanner ( const char* first, const char* last )
+                       : pos_(first), end_(last) {}
+
+    const char*      position    () const { return pos_; }
+    const char*      end         () const { return end_; }
+    bool             atEnd       () const { return pos_ >= end_; }
+
+    void             setPosition ( const char* pos ) { pos_ = pos; }
+
+    // skip spaces, tabs and carriage returns but stay on the line
+
+    inline void      skipBlanks  ();
+
+    // skip blanks and line breaks
+
+    inline void      skipSpaces  ();
+
+    // move to the first character of the next line
+
+    inline void      skipLine    ();
+
+    // true if only blanks are left on the current line
+
+    inline bool      atEndOfLine ();
+
+    inline bool      readInt     ( int&    value );
+    inline bool      readSize    ( size_t& value );
+    inline bool      readDouble  ( double& value );
+
+    // copy size raw bytes (binary mesh files)
+
+    inline bool      readBytes   ( void*   dest,
+                                   size_t  size );
+
+    // rest of the current line without surrounding blanks
+
+    inline void      readLine    ( string& line );
+
+    // advance to the next line "$Name" (but not "$EndName") and
+    // return Name. The scanner is left at the start of the next line.
+
+    inline bool      nextSection ( string& name );
+
+    // first line at or after the current position that starts
+    // with text, or end() if there is none. Does not move.
+
+    inline const char* findLine  ( const char* text ) const;
+
+  private:
+
+    template <class T>
+    inline bool      readNumber_ ( T& value );
+
+    static bool      isBlank_    ( char c )
+    {
+      return c == ' ' || c == '\t' || c == '\r';
+    }
+
+  private:
+
+    const char*      pos_;
+    const char*      end_;
+};
+
+// ==========================================================
+//   implementation of inline functions
+// ==========================================================
+
+inline void TextScanner::skipBlanks ()
+{
+  while ( pos_ < end_ && isBlank_ ( *pos_ ) ) pos_++;
+}
+
+inline void TextScanner::skipSpaces ()
+{
+  while ( pos_ < end_ && ( isBlank_ ( *pos_ ) || *pos_ == '\n' ) ) pos_++;
+}
+
+inline void TextScanner::skipLine ()
+{
+  if ( pos_ >= end_ ) return;
+
+  const char* nl = static_cast<const char*>
+
+    ( memchr ( pos_, '\n', end_ - pos_ ) );
+
+  pos_ = nl ? nl + 1 : end_;
+}
+
+inline bool TextScanner::atEndOfLine ()
+{
+  skipBlanks ();
+
+  return pos_ >= end_ || *pos_ == '\n';
+}
+
+template <class T>
+inline bool TextScanner::readNumber_ ( T& value )
+{
+  skipSpaces ();
+
+  std::from_chars_result res = std::from_chars ( pos_, end_, value );
+
+  if ( res.ec != std::errc () ) return false;
+
+  pos_ = res.ptr;
+
+  return true;
+}
+
+inline bool TextScanner::readInt ( int& value )
+{
+  return readNumber_ ( value );
+}
+
+inline bool TextScanner::readSize ( size_t& value )
+{
+  return readNumber_ ( value );
+}
+
+inline bool TextScanner::readDouble ( double& value )
+{
+  return readNumber_ ( value );
+}
+
+inline bool TextScanner::readBytes ( void* dest, size_t size )
+{
+  if ( size > (size_t) ( end_ - pos_ ) ) return false;
+
+  memcpy ( dest, pos_, size );
+
+  pos_ += size;
+
+  return true;
+}
+
+inline void TextScanner::readLine ( string& line )
+{
+  skipBlanks ();
+
+  const char* first = pos_;
+
+  skipLine ();
+
+  const char* last  = pos_;
+
+  while ( last > first && ( isBlank_ ( last[-1] ) || last[-1] == '\n' ) ) last--;
+
+  line.assign ( first, last );
+}
+
+inline bool TextScanner::nextSection ( string& name )
+{
+  while ( pos_ < end_ )
+  {
+    if ( *pos_ == '$' && ( end_ - pos_ < 4 || strncmp ( pos_, "$End", 4 ) != 0 ) )
+    {
+      pos_++;
+      readLine ( name );
+      return true;
+    }
+
+    skipLine ();
+  }
+
+  return false;
+}
+
+inline const char* TextScanner::findLine ( const char* text ) const
+{
+  std::string_view  data ( pos_, end_ - pos_ );
+  size_t            at = 0;
+
+  while ( ( at = data.find ( text, at ) ) != std::string_view::npos )
+  {
+    if ( at == 0 || data[at-1] == '\n' ) return pos_ + at;
+
+    at++;
+  }
+
+  return end_;
+}
+
+#endif
@@ -0,0 +1,210 @@
+#include "TextWriter.h"
+
+#include <cstdio>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// ------------------------------------------------------------
+//    constructor/destructor
+// ------------------------------------------------------------
+
+TextWriter::TextWriter ( size_t bufferSize )
+
+  : buffer_(bufferSize), size_(0), fd_(-1), stream_(0)
+{
+}
+
+TextWriter::~TextWriter ()
+{
+  close ();
+}
+
+// ------------------------------------------------------------
+//    open
+// ------------------------------------------------------------
+
+bool TextWriter::open ( const char* fileName )
+{
+  close ();
+
+#if !defined(_WIN32)
+
+  fd_ = ::open ( fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+  return fd_ >= 0;
+
+#else
+
+  stream_ = fopen ( fileName, "wb" );
+
+  return stream_ != 0;
+
+#endif
+}
+
+// ------------------------------------------------------------
+//    openTemporary
+// ------------------------------------------------------------
+
+bool TextWriter::openTemporary ()
+{
+  close ();
+
+  stream_ = tmpfile ();
+
+#if !defined(_WIN32)
+  if ( stream_ ) fd_ = fileno ( stream_ );
+#endif
+
+  return stream_ != 0;
+}
+
+// ------------------------------------------------------------
+//    close
+// ------------------------------------------------------------
+
+void TextWriter::close ()
+{
+  flush ();
+
+  // the descriptor of a temporary file belongs to its stream
+
+  if ( stream_ )
+  {
+    fclose ( stream_ );
+  }
+#if !defined(_WIN32)
+  else if ( fd_ >= 0 )
+  {
+    ::close ( fd_ );
+  }
+#endif
+
+  fd_     = -1;
+  stream_ = 0;
+}
+
+// ------------------------------------------------------------
+//    flush
+// ------------------------------------------------------------
+
+void TextWriter::flush ()
+{
+  if ( size_ == 0 || !isOpen () ) return;
+
+  write_ ( buffer_.data (), size_ );
+
+  size_ = 0;
+}
+
+// ------------------------------------------------------------
+//    readBack
+// ------------------------------------------------------------
+
+size_t TextWriter::readBack
+
+  ( size_t  offset,
+    char*   data,
+    size_t  size )
+
+{
+  flush ();
+
+#if !defined(_WIN32)
+
+  ssize_t count;
+
+  do
+  {
+    count = ::pread ( fd_, data, size, offset );
+  }
+  while ( count < 0 && errno == EINTR );
+
+#else
+
+  fflush ( stream_ );
+  fseek  ( stream_, offset, SEEK_SET );
+
+  long   count = fread ( data, 1, size, stream_ );
+
+  fseek  ( stream_, 0, SEEK_END );
+
+#endif
+
+  if ( count < 0 )
+  {
+    cout << "Unable to read temporary file!!!\n\n";
+    exit(1);
+  }
+
+  return count;
+}
+
+// ------------------------------------------------------------
+//    isOpen
+// ------------------------------------------------------------
+
+bool TextWriter::isOpen () const
+{
+  return fd_ >= 0 || stream_ != 0;
+}
+
+// ------------------------------------------------------------
+//    makeRoom_
+// ------------------------------------------------------------
+
+void TextWriter::makeRoom_ ( size_t count )
+{
+  if ( isOpen () )
+  {
+    flush ();
+  }
+
+  if ( size_ + count > buffer_.size () )
+  {
+    buffer_.resize ( std::max ( 2 * buffer_.size (), size_ + count ) );
+  }
+}
+
+// ------------------------------------------------------------
+//    write_
+// ------------------------------------------------------------
+
+void TextWriter::write_
+
+  ( const char* data,
+    size_t      size )
+
+{
+#if !defined(_WIN32)
+
+  while ( size > 0 )
+  {
+    ssize_t count = ::write ( fd_, data, size );
+
+    if ( count < 0 && errno == EINTR ) continue;
+
+    if ( count <= 0 )
+    {
+      cout << "Unable to write output file!!!\n\n";
+      exit(1);
+    }
+
+    data += count;
+    size -= count;
+  }
+
+#else
+
+  if ( fwrite ( data, 1, size, stream_ ) != size )
+  {
+    cout << "Unable to write output file!!!\n\n";
+    exit(1);
+  }
+
+#endif
+}
@@ -0,0 +1,295 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * The output counterpart of TextScanner: text is formatted into a large
+ * buffer in memory with std::to_chars (shortest round-trip doubles,
+ * plain integers) and handed to the operating system with a single
+ * write call every time the buffer is full. The << operators replace
+ * those of ofstream in the mesh writers.
+ *
+ * A writer that is not open collects its text in memory; a temporary
+ * writer spills it to an anonymous file that can be read back. writeParallel
+ * uses such writers to format blocks of nodes or elements on several
+ * threads and appends the blocks to the file in order, so the file does
+ * not depend on the number of threads.
+ */
+
+#ifndef TEXT_WRITER_H
+#define TEXT_WRITER_H
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#include "typedefs.h"
+#include "Parallel.h"
+
+// =====================================================================
+//     class TextWriter
+// =====================================================================
+
+class TextWriter
+{
+  public:
+
+    explicit         TextWriter  ( size_t bufferSize = 1 << 20 );
+                    ~TextWriter  ();
+
+    // create (truncate) the file, return false if it cannot be opened
+
+    bool             open        ( const char* fileName );
+
+    // anonymous temporary file, removed when it is closed (spill
+    // files of InterfaceStream)
+
+    bool             openTemporary ();
+
+    // flush the buffer and close the file
+
+    void             close       ();
+
+    // copy at most size bytes from the given offset of what has been
+    // written so far, return the number of bytes copied. Writing goes
+    // on at the end of the file afterwards.
+
+    size_t           readBack    ( size_t  offset,
+                                   char*   data,
+                                   size_t  size );
+
+    // hand the buffer to the operating system (open writers only)
+
+    void             flush       ();
+
+    bool             isOpen      () const;
+
+    // text collected by a writer that is not open
+
+    const char*      data        () const { return buffer_.data (); }
+    size_t           size        () const { return size_; }
+    void             clear       ()       { size_ = 0; }
+
+    inline TextWriter&  operator << ( char               c );
+    inline TextWriter&  operator << ( const char*        s );
+    inline TextWriter&  operator << ( const string&      s );
+    inline TextWriter&  operator << ( int                i );
+    inline TextWriter&  operator << ( long               i );
+    inline TextWriter&  operator << ( size_t             i );
+    inline TextWriter&  operator << ( double             d );
+
+    // size raw bytes (binary blocks of the ParaView file)
+
+    inline void      writeBytes  ( const void*  data,
+                                   size_t       size );
+
+    // every value of [first,last) followed by sep (as ostream_iterator)
+
+    template <class Iter>
+    inline void      writeList   ( Iter         first,
+                                   Iter         last,
+                                   const char*  sep );
+
+    // format ( writer, i ) for i = 0 ... count-1, on threadCount threads
+
+    template <class Format>
+    void             writeParallel ( int            count,
+                                     int            threadCount,
+                                     const Format&  format );
+
+  private:
+
+                     TextWriter  ( const TextWriter& );
+    TextWriter&      operator =  ( const TextWriter& );
+
+    // room for count more characters in the buffer
+
+    inline char*     reserve_    ( size_t count );
+
+    // flush the buffer to the file, or grow it when not open
+
+    void             makeRoom_   ( size_t count );
+
+    inline void      append_     ( const char* data,
+                                   size_t      size );
+
+    template <class T>
+    inline void      format_     ( T value );
+
+    void             write_      ( const char* data,
+                                   size_t      size );
+
+  private:
+
+    // enough for any int, long or shortest double
+
+    static const size_t  NUMBER_SIZE = 32;
+
+    // items formatted by one thread before the blocks are appended
+
+    static const int     BLOCK_SIZE  = 1 << 15;
+
+    vector<char>     buffer_;
+    size_t           size_;
+    int              fd_;        // -1 if not open
+    FILE*            stream_;    // used when POSIX I/O is not available
+};
+
+// #####################################################################
+//   Implementation
+// #####################################################################
+
+inline char* TextWriter::reserve_ ( size_t count )
+{
+  if ( size_ + count > buffer_.size () ) makeRoom_ ( count );
+
+  return buffer_.data () + size_;
+}
+
+inline void TextWriter::append_
+
+  ( const char* data,
+    size_t      size )
+
+{
+  if ( size > buffer_.size () && isOpen () )
+  {
+    flush  ();
+    write_ ( data, size );
+    return;
+  }
+
+  memcpy ( reserve_ ( size ), data, size );
+
+  size_ += size;
+}
+
+template <class T>
+inline void TextWriter::format_ ( T value )
+{
+  char* first = reserve_ ( NUMBER_SIZE );
+
+  size_ = std::to_chars ( first, first + NUMBER_SIZE, value ).ptr
+        - buffer_.data ();
+}
+
+inline TextWriter& TextWriter::operator << ( char c )
+{
+  *reserve_ ( 1 ) = c; size_++;
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( const char* s )
+{
+  append_ ( s, strlen ( s ) );
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( const string& s )
+{
+  append_ ( s.data (), s.size () );
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( int i )
+{
+  format_ ( i );
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( long i )
+{
+  format_ ( i );
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( size_t i )
+{
+  format_ ( i );
+
+  return *this;
+}
+
+inline TextWriter& TextWriter::operator << ( double d )
+{
+  format_ ( d );
+
+  return *this;
+}
+
+inline void TextWriter::writeBytes
+
+  ( const void*  data,
+    size_t       size )
+
+{
+  append_ ( static_cast<const char*> ( data ), size );
+}
+
+template <class Iter>
+inline void TextWriter::writeList
+
+  ( Iter         first,
+    Iter         last,
+    const char*  sep )
+
+{
+  const size_t sepSize = strlen ( sep );
+
+  for ( ; first != last; ++first )
+  {
+    *this << *first;
+    append_ ( sep, sepSize );
+  }
+}
+
+// ---------------------------------------------------------------------
+//   writeParallel
+// ---------------------------------------------------------------------
+
+// every thread formats a block of BLOCK_SIZE items into its own writer,
+// the blocks are then appended in order; one round after the other so
+// that only threadCount blocks are held in memory
+
+template <class Format>
+void TextWriter::writeParallel
+
+  ( int            count,
+    int            threadCount,
+    const Format&  format )
+
+{
+  if ( threadCount <= 1 || count <= BLOCK_SIZE )
+  {
+    for ( int i = 0; i < count; i++ ) format ( *this, i );
+    return;
+  }
+
+  vector<TextWriter>  blocks ( threadCount );
+
+  const int           round = threadCount * BLOCK_SIZE;
+
+  for ( int first = 0; first < count; first += round )
+  {
+    parallelFor ( threadCount, threadCount, [&] ( int ib )
+    {
+      TextWriter&  out  = blocks[ib];
+      const int    from = std::min ( first + ib * BLOCK_SIZE, count );
+      const int    to   = std::min ( from + BLOCK_SIZE,       count );
+
+      out.clear ();
+
+      for ( int i = from; i < to; i++ ) format ( out, i );
+    } );
+
+    for ( int ib = 0; ib < threadCount; ib++ )
+    {
+      append_ ( blocks[ib].data (), blocks[ib].size () );
+    }
+  }
+}
+
+#endif
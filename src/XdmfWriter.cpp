@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "XdmfWriter.h"
+#include "Global.h"
+#include "Element.h"
+#include "ElementTraits.h"
+#include "Node.h"
+#include "Parallel.h"
+#include "TextWriter.h"
+
+// ---------------------------------------------------------
+//   getXdmfTopology
+// ---------------------------------------------------------
+
+// XDMF topology of a Gmsh element type, 0 if not supported
+
+static const char* getXdmfTopology ( int elemType )
+{
+  switch ( elemType )
+  {
+    case  2: return "Triangle";
+    case  3: return "Quadrilateral";
+    case  9: return "Triangle_6";
+    case 16: return "Quadrilateral_8";
+    case 10: return "Quadrilateral_9";
+    case  4: return "Tetrahedron";
+    case 11: return "Tetrahedron_10";
+    case  5: return "Hexahedron";
+    case 17: return "Hexahedron_20";
+  }
+
+  return 0;
+}
+
+// ---------------------------------------------------------
+//   writeLittle
+// ---------------------------------------------------------
+
+// count values in little-endian byte order; on a big-endian host the
+// bytes are swapped block by block
+
+template <class T>
+static void  writeLittle
+
+  ( TextWriter&  file,
+    const T*     data,
+    size_t       count )
+
+{
+  const uint16_t  one = 1;
+
+  if ( *reinterpret_cast<const char*> ( &one ) == 1 )
+  {
+    file.writeBytes ( data, count * sizeof(T) );
+    return;
+  }
+
+  char            block[1 << 16];
+
+  const size_t    blockCount = sizeof(block) / sizeof(T);
+  const char*     bytes      = reinterpret_cast<const char*> ( data );
+
+  for ( size_t first = 0; first < count; first += blockCount )
+  {
+    const size_t  size = std::min ( blockCount, count - first ) * sizeof(T);
+    const char*   from = bytes + first * sizeof(T);
+
+    for ( size_t i = 0; i < size; i += sizeof(T) )
+    {
+      std::reverse_copy ( from + i, from + i + sizeof(T), block + i );
+    }
+
+    file.writeBytes ( block, size );
+  }
+}
+
+// ---------------------------------------------------------
+//   openDataFile
+// ---------------------------------------------------------
+
+static void  openDataFile
+
+  ( TextWriter&    file,
+    const string&  fileName )
+
+{
+  if ( !file.open ( fileName.c_str () ) )
+  {
+    cout << "Unable to open XDMF data file " << fileName << "!!!\n\n";
+    exit(1);
+  }
+}
+
+// ---------------------------------------------------------
+//   writeDataItem
+// ---------------------------------------------------------
+
+// XML of an array of a binary data file, starting at byte seek
+
+static void  writeDataItem
+
+  ( TextWriter&    xml,
+    const string&  dimensions,
+    const char*    numberType,
+    int            precision,
+    const string&  fileName,
+    size_t         seek = 0 )
+
+{
+  xml << "<DataItem Dimensions=\"" << dimensions
+      << "\" NumberType=\""        << numberType
+      << "\" Precision=\""         << precision
+      << "\" Format=\"Binary\" Endian=\"Little\"";
+
+  if ( seek ) xml << " Seek=\"" << seek << "\"";
+
+  xml << ">" << fileName << "</DataItem>\n";
+}
+
+// ---------------------------------------------------------
+//   writeXdmf
+// ---------------------------------------------------------
+
+/*
+ * Write the modified mesh as an XDMF file: a small XML file describing
+ * flat little-endian binary files (same name, extension replaced) that
+ * hold the arrays of the mesh:
+ *
+ *   .coords.bin         Float64, the x, y (and z) arrays of the nodes
+ *                       one after the other (as stored in the NodeSet)
+ *   .nodeIds.bin        Int32, id of every node
+ *   .elements.bin       Int32, connectivity of the bulk elements, as
+ *                       positions of the nodes (VTK node order)
+ *   .elem2Domain.bin    Int32, domain of every bulk element
+ *   .interfaces.bin     Int32, connectivity of the interface elements,
+ *                       as positions of the nodes (order of the jem file)
+ *   .interfaceMats.bin  Int32, material of every interface element
+ *
+ * The arrays can be read without parsing anything, e.g. with np.memmap.
+ * ParaView draws an interface element as its first face, selected from
+ * the interface connectivity with a hyperslab, and a discrete interface
+ * element as a line.
+ */
+
+void  writeXdmf
+
+(       Global&  globdat,
+  const char*    fileName )
+
+{
+  const NodeSet& nodes     = globdat.newNodeSet;
+  const int      nodeCount = nodes.size ();
+  const int      elemCount = globdat.elemSet.size ();
+  const int      ieCount   = globdat.isConverter ? 0 : globdat.interfaceSet.size ();
+  const int      dim       = globdat.is3D ? 3 : 2;
+
+  if ( elemCount == 0 ) return;
+
+  const int      elemType  = globdat.elemSet[0]->getElemType ();
+  const char*    topology  = getXdmfTopology ( elemType );
+  const int*     order     = getVtkOrder     ( elemType );
+
+  if ( topology == 0 )
+  {
+    cout << "Element type " << elemType
+         << " not supported, XDMF file not written\n\n";
+    return;
+  }
+
+  cout << "Writing XDMF file...\n";
+
+  // the data files are referred to relative to the XML file
+
+  string         base      = fileName;
+  size_t         dot       = base.rfind ( '.' );
+  size_t         slash     = base.rfind ( '/' );
+
+  if ( dot != string::npos && ( slash == string::npos || dot > slash ) )
+  {
+    base.erase ( dot );
+  }
+
+  const string   localBase = slash == string::npos ? base : base.substr ( slash + 1 );
+
+  // node id => position
+
+  IdMap          id2Point;
+
+  for ( int in = 0; in < nodeCount; in++ )
+  {
+    id2Point[nodes.getIndex ( in )] = in;
+  }
+
+  // bulk elements
+
+  const int        elemNodes = globdat.elemSet[0]->getConnectivity ().size ();
+
+  vector<int32_t>  elements  ( (size_t) elemCount * elemNodes );
+  vector<int32_t>  domains   ( elemCount );
+
+  parallelFor ( elemCount, globdat.threadCount, [&] ( int ie )
+  {
+    ElemPointer  ep     = globdat.elemSet[ie];
+    IntSpan      inodes = ep->getConnectivity ();
+    int32_t*     connec = elements.data () + (size_t) ie * elemNodes;
+
+    for ( int in = 0; in < elemNodes; in++ )
+    {
+      connec[in] = id2Point.get ( inodes[order ? order[in] : in] );
+    }
+
+    domains[ie] = globdat.elem2Domain.get ( ep->getIndex () );
+  } );
+
+  // interface elements (all with the same number of nodes)
+
+  const int        ieNodes   = ieCount ? globdat.interfaceSet[0]->getConnectivity ().size () : 0;
+
+  vector<int32_t>  interfaces ( (size_t) ieCount * ieNodes );
+
+  std::atomic<bool> isUniform ( true );
+
+  parallelFor ( ieCount, globdat.threadCount, [&] ( int ie )
+  {
+    IntSpan      inodes = globdat.interfaceSet[ie]->getConnectivity ();
+    int32_t*     connec = interfaces.data () + (size_t) ie * ieNodes;
+
+    if ( inodes.size () != ieNodes )
+    {
+      isUniform = false;
+      return;
+    }
+
+    for ( int in = 0; in < ieNodes; in++ )
+    {
+      connec[in] = id2Point.get ( inodes[in] );
+    }
+  } );
+
+  if ( !isUniform )
+  {
+    cout << "Interface elements of different sizes, XDMF file not written\n\n";
+    return;
+  }
+
+  // binary data files, streamed from the arrays
+
+  TextWriter     file;
+
+  openDataFile ( file, base + ".coords.bin" );
+  writeLittle  ( file, nodes.getXData (), nodeCount );
+  writeLittle  ( file, nodes.getYData (), nodeCount );
+  if ( dim == 3 ) writeLittle ( file, nodes.getZData (), nodeCount );
+  file.close   ();
+
+  openDataFile ( file, base + ".nodeIds.bin" );
+  writeLittle  ( file, nodes.getIndexData (), nodeCount );
+  file.close   ();
+
+  openDataFile ( file, base + ".elements.bin" );
+  writeLittle  ( file, elements.data (), elements.size () );
+  file.close   ();
+
+  openDataFile ( file, base + ".elem2Domain.bin" );
+  writeLittle  ( file, domains.data (), domains.size () );
+  file.close   ();
+
+  const bool     hasMats   = ieCount > 0 && (int) globdat.interfaceMats.size () == ieCount;
+
+  if ( ieCount )
+  {
+    openDataFile ( file, base + ".interfaces.bin" );
+    writeLittle  ( file, interfaces.data (), interfaces.size () );
+    file.close   ();
+  }
+
+  if ( hasMats )
+  {
+    openDataFile ( file, base + ".interfaceMats.bin" );
+    writeLittle  ( file, globdat.interfaceMats.data (), ieCount );
+    file.close   ();
+  }
+
+  // XML file
+
+  TextWriter     xml;
+
+  if ( !xml.open ( fileName ) )
+  {
+    cout << "Unable to open XDMF file!!!\n\n";
+    exit(1);
+  }
+
+  const string   nodeDims = std::to_string ( nodeCount );
+
+  auto writeGeometry = [&] ()
+  {
+    xml << "<Geometry GeometryType=\"" << ( dim == 3 ? "X_Y_Z" : "X_Y" ) << "\">\n";
+
+    for ( int i = 0; i < dim; i++ )
+    {
+      writeDataItem ( xml, nodeDims, "Float", 8, localBase + ".coords.bin",
+                      (size_t) i * nodeCount * sizeof(double) );
+    }
+
+    xml << "</Geometry>\n";
+  };
+
+  xml << "<?xml version=\"1.0\"?>\n"
+      << "<Xdmf Version=\"3.0\">\n<Domain>\n"
+      << "<Grid Name=\"mesh\" GridType=\"Collection\" CollectionType=\"Spatial\">\n";
+
+  // bulk elements
+
+  xml << "<Grid Name=\"elements\" GridType=\"Uniform\">\n"
+      << "<Topology TopologyType=\"" << topology
+      << "\" NumberOfElements=\""    << elemCount << "\">\n";
+
+  writeDataItem ( xml, std::to_string ( elemCount ) + " " + std::to_string ( elemNodes ),
+                  "Int", 4, localBase + ".elements.bin" );
+
+  xml << "</Topology>\n";
+
+  writeGeometry ();
+
+  xml << "<Attribute Name=\"domain\" AttributeType=\"Scalar\" Center=\"Cell\">\n";
+  writeDataItem ( xml, std::to_string ( elemCount ), "Int", 4, localBase + ".elem2Domain.bin" );
+  xml << "</Attribute>\n";
+
+  xml << "<Attribute Name=\"nodeId\" AttributeType=\"Scalar\" Center=\"Node\">\n";
+  writeDataItem ( xml, nodeDims, "Int", 4, localBase + ".nodeIds.bin" );
+  xml << "</Attribute>\n";
+
+  xml << "</Grid>\n";
+
+  // interface elements: the first face (first half of the nodes), or
+  // a line for discrete interface elements
+
+  if ( ieCount )
+  {
+    const int    half    = ieNodes / 2;
+    const int    shown   = half == 1 ? ieNodes : half;
+    const string ieDims   = std::to_string ( ieCount ) + " " + std::to_string ( ieNodes );
+    const string showDims = std::to_string ( ieCount ) + " " + std::to_string ( shown );
+
+    const char*  ieTopology;
+
+    if      ( half == 1 || dim == 2 ) ieTopology = "Polyline";
+    else if ( half == 3 )             ieTopology = "Triangle";
+    else if ( half == 4 )             ieTopology = "Quadrilateral";
+    else if ( half == 6 )             ieTopology = "Triangle_6";
+    else                              ieTopology = "Quadrilateral_8";
+
+    xml << "<Grid Name=\"interfaces\" GridType=\"Uniform\">\n"
+        << "<Topology TopologyType=\"" << ieTopology
+        << "\" NumberOfElements=\""    << ieCount << "\"";
+
+    if ( dim == 2 || half == 1 ) xml << " NodesPerElement=\"" << shown << "\"";
+
+    xml << ">\n";
+
+    if ( shown == ieNodes )
+    {
+      writeDataItem ( xml, ieDims, "Int", 4, localBase + ".interfaces.bin" );
+    }
+    else
+    {
+      xml << "<DataItem ItemType=\"HyperSlab\" Dimensions=\"" << showDims
+          << "\" Type=\"HyperSlab\">\n"
+          << "<DataItem Dimensions=\"3 2\" Format=\"XML\">0 0 1 1 "
+          << showDims << "</DataItem>\n";
+
+      writeDataItem ( xml, ieDims, "Int", 4, localBase + ".interfaces.bin" );
+
+      xml << "</DataItem>\n";
+    }
+
+    xml << "</Topology>\n";
+
+    writeGeometry ();
+
+    if ( hasMats )
+    {
+      xml << "<Attribute Name=\"material\" AttributeType=\"Scalar\" Center=\"Cell\">\n";
+      writeDataItem ( xml, std::to_string ( ieCount ), "Int", 4, localBase + ".interfaceMats.bin" );
+      xml << "</Attribute>\n";
+    }
+
+    xml << "</Grid>\n";
+  }
+
+  xml << "</Grid>\n</Domain>\n</Xdmf>\n";
+
+  xml.close ();
+
+  cout << "Writing XDMF file...done!\n\n";
+}
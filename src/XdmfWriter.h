@@ -0,0 +1,12 @@
+#ifndef XDMF_WRITER_H
+#define XDMF_WRITER_H
+
+struct Global;
+
+void  writeXdmf
+
+(       Global&  globdat,
+  const char*    fileName );
+
+
+#endif
@@ -0,0 +1,425 @@
+#include "libcigen.h"
+#include "Global.h"
+#include "Node.h"
+#include "Element.h"
+#include "GmshMeshBuilder.h"
+#include "MeshModifier.h"
+#include "InterfaceBuilder.h"
+
+#include <sstream>
+
+// ---------------------------------------------------------------------
+//   isBulkType
+// ---------------------------------------------------------------------
+
+// the element types the interface builders handle (ElementTraits), in
+// a 2D and in a 3D mesh; the other entities are boundary entities
+
+static bool              isBulkType
+
+  ( int                  elemType,
+    bool                 is3D )
+
+{
+  switch ( elemType )
+  {
+    case  2: case  3: case  9: case 16: case 10: return !is3D;
+    case  4: case 11: case  5: case 17:          return  is3D;
+  }
+
+  return false;
+}
+
+// ---------------------------------------------------------------------
+//   checkInput
+// ---------------------------------------------------------------------
+
+// what readMesh and main check while reading, before anything is built
+
+static bool              checkInput
+
+  ( const CigenMesh&     mesh,
+    const CigenOptions&  options,
+    string&              error )
+
+{
+  std::ostringstream  msg;
+
+  const size_t        nodeCount = mesh.nodeIds.size   ();
+  const size_t        elemCount = mesh.elemTypes.size ();
+
+  if ( nodeCount == 0 || mesh.coords.size () != 3 * nodeCount )
+  {
+    msg << "expected 3 coordinates for each of the " << nodeCount << " nodes";
+  }
+  else if ( mesh.elemDomains.size () != elemCount ||
+            mesh.elemOffsets.size () != elemCount + 1 ||
+            mesh.elemOffsets[0]      != 0 ||
+            mesh.elemOffsets.back () != (int) mesh.elemNodes.size () )
+  {
+    msg << "expected a domain and offsets for each of the "
+        << elemCount << " elements";
+  }
+  else if ( options.mode == CigenOptions::DOMAIN &&
+            ( options.rigidDomains.size () < 1 || options.rigidDomains.size () > 2 ) )
+  {
+    msg << "expected one or two rigid domains";
+  }
+  else if ( options.notches.size () % 4 != 0 ||
+            ( options.noInterface.size () != 0 && options.noInterface.size () != 4 ) )
+  {
+    msg << "expected x1 y1 x2 y2 for every notch and noInterface segment";
+  }
+
+  if ( !msg.str ().empty () )
+  {
+    error = msg.str ();
+    return false;
+  }
+
+  // GmshMeshBuilder takes the dimension from the z coordinates and the
+  // builders the element type from the first bulk element
+
+  bool  is3D = false;
+
+  for ( size_t in = 0; in < nodeCount && !is3D; in++ )
+  {
+    is3D = mesh.coords[3*in+2] != 0.;
+  }
+
+  int   bulkType = -1;
+
+  for ( size_t ie = 0; ie < elemCount && msg.str ().empty (); ie++ )
+  {
+    const int  type = mesh.elemTypes[ie];
+
+    if ( type == 1 || type == 8 || type == 15 ) continue;
+
+    if ( is3D && ( type == 2 || type == 9 || type == 3 || type == 16 ) ) continue;
+
+    if ( !isBulkType ( type, is3D ) )
+    {
+      msg << "element " << ie << ": Gmsh element type " << type
+          << " not supported in a " << ( is3D ? 3 : 2 ) << "D mesh";
+    }
+    else if ( bulkType >= 0 && type != bulkType )
+    {
+      msg << "element " << ie << ": all bulk elements must have the same type";
+    }
+
+    bulkType = type;
+  }
+
+  if ( msg.str ().empty () && bulkType < 0 )
+  {
+    msg << "no bulk elements";
+  }
+
+  if ( !msg.str ().empty () )
+  {
+    error = msg.str ();
+    return false;
+  }
+
+  IntVector  ids ( mesh.nodeIds );
+
+  std::sort ( ids.begin (), ids.end () );
+
+  if ( std::adjacent_find ( ids.begin (), ids.end () ) != ids.end () )
+  {
+    msg << "node " << *std::adjacent_find ( ids.begin (), ids.end () ) << " given twice";
+  }
+
+  for ( size_t ie = 0; ie < elemCount && msg.str ().empty (); ie++ )
+  {
+    const int  first = mesh.elemOffsets[ie];
+    const int  last  = mesh.elemOffsets[ie+1];
+
+    if ( last - first != GmshMeshBuilder::getNodeCount ( mesh.elemTypes[ie] ) ||
+         last - first == 0 )
+    {
+      msg << "element " << ie << ": " << last - first
+          << " nodes for Gmsh element type " << mesh.elemTypes[ie];
+    }
+
+    for ( int i = first; i < last && msg.str ().empty (); i++ )
+    {
+      if ( !std::binary_search ( ids.begin (), ids.end (), mesh.elemNodes[i] ) )
+      {
+        msg << "element " << ie << ": unknown node " << mesh.elemNodes[i];
+      }
+    }
+  }
+
+  if ( options.mode == CigenOptions::DOMAIN && msg.str ().empty () &&
+       std::find ( mesh.elemDomains.begin (), mesh.elemDomains.end (),
+                   options.rigidDomains[0] ) == mesh.elemDomains.end () )
+  {
+    msg << "invalid number of rigid domain " << options.rigidDomains[0];
+  }
+
+  error = msg.str ();
+
+  return error.empty ();
+}
+
+// ---------------------------------------------------------------------
+//   setOptions
+// ---------------------------------------------------------------------
+
+// as main does for the command line options
+
+static void              setOptions
+
+  ( Global&              globdat,
+    const CigenOptions&  options )
+
+{
+  globdat.isEveryWhere = options.mode == CigenOptions::EVERYWHERE;
+  globdat.isInterface  = options.mode == CigenOptions::INTERFACE;
+  globdat.isDomain     = options.mode == CigenOptions::DOMAIN;
+  globdat.isPolycrystal= options.mode == CigenOptions::POLYCRYSTAL;
+
+  for ( size_t i = 0; globdat.isDomain && i < options.rigidDomains.size (); i++ )
+  {
+    globdat.rigidDomain[i] = options.rigidDomains[i];
+  }
+
+  for ( size_t i = 0; i < options.notches.size (); i += 4 )
+  {
+    const double* p = &options.notches[i];
+
+    globdat.segment.push_back ( Segment ( Point(p[0],p[1]), Point(p[2],p[3]) ) );
+    globdat.isNotch = true;
+  }
+
+  if ( !options.noInterface.empty () )
+  {
+    const double* p = &options.noInterface[0];
+
+    globdat.ignoredSegment = Segment ( Point(p[0],p[1]), Point(p[2],p[3]) );
+    globdat.isIgSegment    = true;
+  }
+
+  globdat.internalEdges[0] = options.internalEdges;
+  globdat.isContinuum      = options.isContinuum;
+  globdat.isHydraulic      = options.isHydraulic;
+  globdat.isNeper          = options.isNeper;
+  globdat.threadCount      = std::max ( options.threadCount, 1 );
+}
+
+// ---------------------------------------------------------------------
+//   addElements
+// ---------------------------------------------------------------------
+
+// append the connectivities of the elements of a set
+
+static void              addElements
+
+  ( IntVector&           offsets,
+    IntVector&           nodes,
+    const ElemSet&       elems )
+
+{
+  const int  elemCount = elems.size ();
+
+  offsets.assign ( 1, 0 );
+  offsets.reserve ( elemCount + 1 );
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    IntSpan  connec = elems[ie]->getConnectivity ();
+
+    nodes  .insert    ( nodes.end (), connec.begin (), connec.end () );
+    offsets.push_back ( nodes.size () );
+  }
+}
+
+// ---------------------------------------------------------------------
+//   getResult
+// ---------------------------------------------------------------------
+
+static void              getResult
+
+  ( CigenResult&         result,
+    Global&              globdat )
+
+{
+  result.dimension         = globdat.is3D ? 3 : 2;
+  result.nodesPerInterface = globdat.nodeICount;
+
+  // modified mesh
+
+  const NodeSet&  nodes     = globdat.newNodeSet;
+  const int       nodeCount = nodes.size ();
+
+  result.nodeIds.resize ( nodeCount );
+  result.coords .resize ( 3 * (size_t) nodeCount );
+
+  for ( int in = 0; in < nodeCount; in++ )
+  {
+    result.nodeIds[in]    = nodes.getIndex ( in );
+    result.coords[3*in]   = nodes.getX     ( in );
+    result.coords[3*in+1] = nodes.getY     ( in );
+    result.coords[3*in+2] = nodes.getZ     ( in );
+  }
+
+  const int  elemCount = globdat.elemSet.size ();
+
+  for ( int ie = 0; ie < elemCount; ie++ )
+  {
+    ElemPointer ep = globdat.elemSet[ie];
+
+    result.elemIds    .push_back ( ep->getIndex    () );
+    result.elemTypes  .push_back ( ep->getElemType () );
+    result.elemDomains.push_back ( globdat.elem2Domain.get ( ep->getIndex () ) );
+  }
+
+  addElements ( result.elemOffsets, result.elemNodes, globdat.elemSet );
+
+  result.bndElemDomains.assign ( globdat.bndElementSet.size (), 0 );
+
+  Int2IntVectMap::const_iterator it;
+
+  for ( it = globdat.dom2BndElems.begin (); it != globdat.dom2BndElems.end (); ++it )
+  {
+    for ( size_t i = 0; i < it->second.size (); i++ )
+    {
+      result.bndElemDomains[it->second[i]] = it->first;
+    }
+  }
+
+  addElements ( result.bndElemOffsets, result.bndElemNodes, globdat.bndElementSet );
+
+  // interface elements
+
+  const int  ieCount = globdat.interfaceSet.size ();
+
+  result.interfaceMats = globdat.interfaceMats;
+
+  for ( int ie = 0; ie < ieCount; ie++ )
+  {
+    ElemPointer ep = globdat.interfaceSet[ie];
+
+    result.interfaceBulks.push_back ( ep->getBulk1 () );
+    result.interfaceBulks.push_back ( ep->getBulk2 () );
+  }
+
+  addElements ( result.interfaceOffsets, result.interfaceNodes, globdat.interfaceSet );
+
+  if ( globdat.is3D ) result.oppositeVertices = globdat.oppositeVertices;
+
+  IntVector  flowOffsets;
+
+  addElements ( flowOffsets, result.flowElemNodes, globdat.flowElemSet );
+
+  // nodes of the input mesh
+
+  const int  inCount = globdat.nodeSet.size ();
+
+  result.duplicateOffsets.assign ( 1, 0 );
+
+  for ( int in = 0; in < inCount; in++ )
+  {
+    const int  index = globdat.nodeSet.getIndex ( in );
+
+    result.nodeKinds.push_back ( globdat.nodeSet.getIsInterface ( in ) ? 2 : 1 );
+
+    it = globdat.duplicatedNodes.find ( index );
+
+    if ( it != globdat.duplicatedNodes.end () )
+    {
+      result.duplicateNodes.insert ( result.duplicateNodes.end (),
+                                     it->second.begin (), it->second.end () );
+    }
+    else
+    {
+      result.duplicateNodes.push_back ( index );
+    }
+
+    result.duplicateOffsets.push_back ( result.duplicateNodes.size () );
+
+    if ( globdat.isHydraulic )
+    {
+      result.flowNodes.push_back ( globdat.flowNodes[globdat.nodeId2Position.get ( index )] );
+    }
+  }
+}
+
+// =====================================================================
+//     cigenGenerate
+// =====================================================================
+
+/*
+ * The pipeline of main: the mesh goes through GmshMeshBuilder as the
+ * lines of a Gmsh file do (the domain id is also the geometrical id),
+ * then MeshModifier::doIt and InterfaceBuilder::doIt, and the result is
+ * taken from globdat instead of being written. Where main exits, the
+ * builders return false with globdat.error.
+ */
+
+bool                     cigenGenerate
+
+  ( const CigenMesh&     mesh,
+    const CigenOptions&  options,
+    CigenResult&         result )
+
+{
+  result = CigenResult ();
+
+  if ( !checkInput ( mesh, options, result.error ) ) return false;
+
+  std::streambuf*  coutBuf = options.verbose ? 0 : cout.rdbuf ( 0 );
+  std::streambuf*  cerrBuf = options.verbose ? 0 : cerr.rdbuf ( 0 );
+
+  Global           globdat;
+
+  bool             ok;
+
+  setOptions ( globdat, options );
+
+  {
+    GmshMeshBuilder  builder ( globdat );
+
+    const int        nodeCount = mesh.nodeIds.size   ();
+    const int        elemCount = mesh.elemTypes.size ();
+
+    builder.reserveNodes ( nodeCount );
+
+    for ( int in = 0; in < nodeCount; in++ )
+    {
+      builder.addNode ( mesh.nodeIds[in], mesh.coords[3*in],
+                        mesh.coords[3*in+1], mesh.coords[3*in+2] );
+    }
+
+    builder.endNodes ();
+
+    builder.reserveElements ( elemCount );
+
+    for ( int ie = 0; ie < elemCount; ie++ )
+    {
+      const int  first = mesh.elemOffsets[ie];
+
+      builder.addElement ( ie, mesh.elemTypes[ie], mesh.elemDomains[ie],
+                           mesh.elemDomains[ie], &mesh.elemNodes[first],
+                           mesh.elemOffsets[ie+1] - first );
+    }
+
+    ok = builder.endElements ();
+  }
+
+  if ( ok )
+  {
+    MeshModifier::doIt ( globdat );
+
+    ok = InterfaceBuilder::doIt ( globdat );
+  }
+
+  if ( ok ) getResult ( result, globdat );
+  else      result.error = globdat.error;
+
+  if ( coutBuf ) cout.rdbuf ( coutBuf );
+  if ( cerrBuf ) cerr.rdbuf ( cerrBuf );
+
+  return ok;
+}
@@ -0,0 +1,160 @@
+/**
+ * This file is a part of the interface element generator program.
+ *
+ * In-process interface to the generator (libcigen.a, "make lib"). An FE
+ * code that links the library hands its mesh over in memory and gets
+ * the modified mesh and the interface elements back in memory, without
+ * writing a Gmsh file and parsing the output files of interface-elem.
+ *
+ * The mesh is given as a Gmsh file would give it: node ids and
+ * coordinates, and element lines with a Gmsh element type, a domain
+ * (physical) id and node ids. Lines (type 1, 8), points (15) and, in 3D,
+ * triangles and quadrangles are boundary entities; the other elements
+ * are bulk elements. The id of an element is its position in the input,
+ * as the position of its line in a Gmsh file.
+ *
+ * This header does not depend on the rest of the program. Connectivities
+ * are stored as flat arrays with offsets: the nodes of element ie are
+ * elemNodes[elemOffsets[ie]] ... elemNodes[elemOffsets[ie+1]-1].
+ *
+ * Usage:
+ *
+ *   CigenMesh     mesh;     // nodeIds, coords, elemTypes ...
+ *   CigenOptions  options;  // options.mode = CigenOptions::DOMAIN ...
+ *   CigenResult   result;
+ *
+ *   if ( !cigenGenerate ( mesh, options, result ) ) ... result.error
+ *
+ * The input is checked before the run. Errors detected later on, where
+ * interface-elem stops (a mesh without interface elements, for instance),
+ * also make cigenGenerate return false with result.error; the process
+ * is never ended. The program messages go to std::cout and std::cerr
+ * only with options.verbose: otherwise both are muted during the call,
+ * so do not run several calls at the same time.
+ */
+
+#ifndef LIBCIGEN_H
+#define LIBCIGEN_H
+
+#include <string>
+#include <vector>
+
+// =====================================================================
+//     struct CigenMesh
+// =====================================================================
+
+struct CigenMesh
+{
+  std::vector<int>     nodeIds;
+  std::vector<double>  coords;       // x y z per node, z = 0 in 2D
+
+  std::vector<int>     elemTypes;    // Gmsh element types
+  std::vector<int>     elemDomains;  // physical ids
+  std::vector<int>     elemOffsets;  // element count + 1 offsets
+  std::vector<int>     elemNodes;    // node ids, in Gmsh order
+};
+
+// =====================================================================
+//     struct CigenOptions
+// =====================================================================
+
+// the command line options of interface-elem that apply in memory
+
+struct CigenOptions
+{
+  enum Mode
+  {
+    EVERYWHERE,                      // --everywhere
+    INTERFACE,                       // --interface
+    DOMAIN,                          // --domain, --domains
+    POLYCRYSTAL                      // --polycrystal
+  };
+
+  Mode                 mode;
+  std::vector<int>     rigidDomains; // DOMAIN: one or two domain ids
+  std::vector<double>  notches;      // x1 y1 x2 y2 per notch (--notch)
+  std::vector<double>  noInterface;  // x1 y1 x2 y2 or empty (--noInterface)
+  int                  internalEdges;// --internalEdges, 0: none
+  bool                 isContinuum;  // --isContinuum
+  bool                 isHydraulic;  // --flow
+  bool                 isNeper;      // --Neper
+  int                  threadCount;  // --threads
+  bool                 verbose;      // program messages on std::cout
+
+  CigenOptions ()
+
+    : mode          ( EVERYWHERE ),
+      internalEdges ( 0 ),
+      isContinuum   ( true ),
+      isHydraulic   ( false ),
+      isNeper       ( false ),
+      threadCount   ( 1 ),
+      verbose       ( false )
+  {}
+};
+
+// =====================================================================
+//     struct CigenResult
+// =====================================================================
+
+/*
+ * The modified mesh holds the data of the jem mesh file, the interface
+ * part the data of the interface file (see InterfaceFile.h), with the
+ * connectivities in Gmsh order.
+ */
+
+struct CigenResult
+{
+  int                  dimension;
+  int                  nodesPerInterface;
+
+  // modified mesh: all nodes (the duplicated ones included), bulk
+  // elements with their new nodes and boundary elements
+
+  std::vector<int>     nodeIds;
+  std::vector<double>  coords;          // x y z per node
+
+  std::vector<int>     elemIds;
+  std::vector<int>     elemTypes;
+  std::vector<int>     elemDomains;
+  std::vector<int>     elemOffsets;
+  std::vector<int>     elemNodes;
+
+  std::vector<int>     bndElemDomains;  // ids follow the last bulk element id
+  std::vector<int>     bndElemOffsets;
+  std::vector<int>     bndElemNodes;
+
+  // interface elements (ids from 0) and, if isHydraulic, their flow nodes
+
+  std::vector<int>     interfaceMats;
+  std::vector<int>     interfaceBulks;  // two bulk element ids per element
+  std::vector<int>     interfaceOffsets;
+  std::vector<int>     interfaceNodes;
+  std::vector<int>     oppositeVertices;// 3D
+  std::vector<int>     flowElemNodes;   // nodesPerInterface/2 per element
+
+  // nodes of the input mesh, in input order: 2 on an interface, else 1,
+  // the duplicates of the node (the node first) and its flow node
+
+  std::vector<int>     nodeKinds;
+  std::vector<int>     duplicateOffsets;
+  std::vector<int>     duplicateNodes;
+  std::vector<int>     flowNodes;       // isHydraulic
+
+  std::string          error;
+};
+
+// =====================================================================
+//     cigenGenerate
+// =====================================================================
+
+// false (and result.error) if the input is not valid or no interface
+// element could be generated
+
+bool                   cigenGenerate
+
+  ( const CigenMesh&     mesh,
+    const CigenOptions&  options,
+    CigenResult&         result );
+
+#endif
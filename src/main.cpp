@@ -41,7 +41,7 @@
  *       do not add interface elements along this notches (traction-free cracks).
  *   (8) Both linear (4 node) and quadratic (6 node) interface elements  are supported.
  *   (9) Mesh converter: read Gmsh and convert it to jem/jive mesh.
- *   (10)Write to Abaqus (inp) files.
+ *   (10)Write to Abaqus (inp) files and ParaView (vtu, xdmf) files.
  *   (11)Time spent on each task using C++11, std::chrono class.
  *
  *  Algorithm used:
@@ -66,6 +66,21 @@
  * 5/02/2015: rigid domain can be one or two domains.
  * 14 October 2016: add --internalEdges option so that interface elements still generated
  *    along internal edges (set in gmsh to store node groups for outputs).
+ * 18 October 2026: add --threads option, the Gmsh nodes and elements are
+ *    parsed in parallel (same result as with one thread).
+ * 18 October 2026: add --mesh-cache option, a Gmsh mesh is stored in a binary
+ *    sidecar file that is loaded instead of the mesh in later runs.
+ * 18 October 2026: --threads also builds the nodal support, the face/edge
+ *    tables, the element neighbors and the interfacial nodes in parallel.
+ * 18 October 2026: --paraview-file writes the mesh with the interface elements
+ *    to a binary VTU file (zlib compressed with --paraview-zlib).
+ * 18 October 2026: --xdmf-file writes the mesh to an XDMF file with the
+ *    arrays in raw little-endian binary files (for very large meshes).
+ * 18 October 2026: --interface-binary writes the interface file in a versioned
+ *    binary format, read by the header-only InterfaceFileReader (InterfaceFile.h).
+ * 18 October 2026: add --stream option, the interface elements of --everywhere
+ *    and --domain go to the output files through temporary files instead of
+ *    being kept in memory (see InterfaceStream.h).
  *
  */
 
@@ -79,6 +94,9 @@
 #include "MeshWriter.h"
 #include "MeshReader.h"
 #include "InterfaceWriter.h"
+#include "InterfaceStream.h"
+#include "ParaviewWriter.h"
+#include "XdmfWriter.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
@@ -103,11 +121,14 @@ int main ( int argc, char* argv[] )
   string   newMeshFile   ("");
   string   interfaceFile ("");
   string   paraviewFile  ("");
+  string   xdmfFile      ("");
 
   bool     gotMeshFile  = false;
   bool     gotnMeshFile = false;
   bool     gotiMeshFile = false;
   bool     gotParaFile  = false;
+  bool     gotXdmfFile  = false;
+  bool     isStream     = false;
 
   for ( size_t i = 1; i < argc; i++ )
   {
@@ -132,11 +153,28 @@ int main ( int argc, char* argv[] )
       interfaceFile = argv[++i];
       gotiMeshFile  = true;
     }
+    else if  ( string(argv[i]) == string("--interface-binary") )
+    {
+      globdat.isInterfaceBinary = true;
+    }
     else if  ( string(argv[i]) == string("--paraview-file") )
     {
       paraviewFile = argv[++i];
       gotParaFile  = true;
     }
+    else if  ( string(argv[i]) == string("--xdmf-file") )
+    {
+      xdmfFile     = argv[++i];
+      gotXdmfFile  = true;
+    }
+    else if  ( string(argv[i]) == string("--stream") )
+    {
+      isStream     = true;
+    }
+    else if  ( string(argv[i]) == string("--paraview-zlib") )
+    {
+      globdat.isParaviewZlib = true;
+    }
     else if  ( string(argv[i]) == string("--interface") )
     {
       globdat.isInterface   = true;
@@ -242,6 +280,16 @@ int main ( int argc, char* argv[] )
     {
       globdat.isMatlab = true;
     }
+    else if  ( string(argv[i]) == string("--threads") )
+    {
+      globdat.threadCount = boost::lexical_cast<int> ( argv[++i] );
+
+      if ( globdat.threadCount < 1 ) globdat.threadCount = 1;
+    }
+    else if  ( string(argv[i]) == string("--mesh-cache") )
+    {
+      globdat.useMeshCache = true;
+    }
     else if  ( string(argv[i]) == string("--help") )
     {
       cout << "USAGE:\n";
@@ -249,7 +297,11 @@ int main ( int argc, char* argv[] )
       cout << "  * --out-file       FILE         set the file containing the modified mesh\n";
       cout << "  * --isContinuum    1 or 0       continuum interface elements or discrete elements\n";
       cout << "  * --interface-file FILE         set the file containing the interface mesh\n";
-      cout << "  * --paraview-file  FILE         set the file of ParaView format\n";
+      cout << "  * --interface-binary            write the interface file in binary (see InterfaceFile.h)\n";
+      cout << "  * --paraview-file  FILE         also write the mesh to FILE (ParaView VTU format)\n";
+      cout << "  * --paraview-zlib               compress the ParaView file (build with ZLIB=1)\n";
+      cout << "  * --xdmf-file      FILE         also write the mesh to FILE (XDMF, raw binary data files)\n";
+      cout << "  * --stream                      do not keep the interface elements in memory (--everywhere, --domain)\n";
       cout << "  * --interface                   generate interface elements along material interface\n";
       cout << "  * --everywhere                  generate interface elements at all interelement boundaries\n";
       cout << "  * --domain         domNum       not generate interface elements in domain number domNum\n";
@@ -263,6 +315,8 @@ int main ( int argc, char* argv[] )
       cout << "  * --Neper                       mesh created by Neper (a polycrystal generator)\n";
       cout << "  * --Matlab                      write mesh to Matlab (do postprocessing there)\n";
       cout << "  * --internalEdges n1            ids of internal edges (from gmsh geo files)\n";
+      cout << "  * --threads        N            number of threads used to read and modify the mesh\n";
+      cout << "  * --mesh-cache                  keep a binary copy (FILE.cache) of a Gmsh mesh for the next runs\n";
       cout << "  * --help                        print this help and exit\n";
       cout << endl; 
       return 0 ;
@@ -297,14 +351,6 @@ int main ( int argc, char* argv[] )
     interfaceFile = spMeshFile[0] + "-interface.mesh";
   }
 
-  if ( ! gotParaFile )
-  {
-    cout << "using default name for the ParaView file.\n\n" << flush;
-    StrVector spMeshFile;
-    boost::split ( spMeshFile, meshFile, boost::is_any_of(".") );
-    paraviewFile = spMeshFile[0] + ".vtu";
-  }
-
   // doing stuff 
 
   high_resolution_clock::time_point t1;
@@ -313,22 +359,46 @@ int main ( int argc, char* argv[] )
   readMesh               ( globdat, meshFile.c_str()   );
   t2 = high_resolution_clock::now();
 
-  auto duration = duration_cast<seconds>( t2 - t1 ).count();
+  double elapsed = duration<double>( t2 - t1 ).count();
 
-  cout << "Reading mesh done in " << duration << " seconds\n";
+  cout << "Reading mesh done in " << elapsed << " seconds\n";
   
   t1 = high_resolution_clock::now();
   MeshModifier::    doIt ( globdat                     );
   t2 = high_resolution_clock::now();
-  cout << "Modifying mesh done in " << duration_cast<seconds>( t2 - t1 ).count() << " seconds\n";
+  cout << "Modifying mesh done in " << duration<double>( t2 - t1 ).count() << " seconds\n";
+
+  // the other builders and output files need all interface elements
+
+  if ( isStream )
+  {
+    if ( ( globdat.isDomain || globdat.isEveryWhere ) && !globdat.isInterface &&
+         !globdat.isPolycrystal && !globdat.isConverter && !globdat.outAbaqus &&
+         !globdat.isMatlab && !gotParaFile && !gotXdmfFile )
+    {
+      globdat.interfaceStream = new InterfaceStream ( globdat );
+    }
+    else
+    {
+      cout << "--stream is only used with --everywhere or --domain and the jem "
+           << "mesh and interface files, interface elements kept in memory.\n";
+    }
+  }
   
   t1 = high_resolution_clock::now();
-  InterfaceBuilder::doIt ( globdat                     );
+  if ( !InterfaceBuilder::doIt ( globdat ) ) exit(1);
   t2 = high_resolution_clock::now();
-  cout << "Building interface elements  done in " << duration_cast<seconds>( t2 - t1 ).count() << " seconds\n";
+  cout << "Building interface elements  done in " << duration<double>( t2 - t1 ).count() << " seconds\n";
 
   writeMesh              ( globdat, newMeshFile.c_str());
   writeInterface         ( globdat, interfaceFile.c_str() );
 
+  // the ParaView and XDMF files are only written on request (large meshes)
+
+  if ( gotParaFile ) writeParaview ( globdat, paraviewFile.c_str() );
+  if ( gotXdmfFile ) writeXdmf     ( globdat, xdmfFile.c_str() );
+
+  delete globdat.interfaceStream;
+
   return 0;
 }
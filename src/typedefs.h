@@ -11,12 +11,13 @@
 #include <iterator>
 #include <limits>
 #include <math.h>
-#include <boost/shared_ptr.hpp>
 
 using namespace std;
 
-class Node;
+class NodeSet;
 class Element;
+class ElemPointer;
+class ElemSet;
 
 typedef vector<string>             StrVector;
 typedef vector<int>                IntVector;
@@ -25,9 +26,5 @@ typedef map<int, IntVector>        Int2IntVectMap;
 typedef map<int,int>               Int2IntMap;
 typedef map<int,IntSet>            Int2IntSetMap;
 typedef map<int, string>           Int2StringMap;
-typedef boost::shared_ptr<Node>    NodePointer;
-typedef boost::shared_ptr<Element> ElemPointer;
-typedef vector<NodePointer>        NodeSet;
-typedef vector<ElemPointer>        ElemSet;
 
 #endif
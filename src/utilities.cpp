@@ -18,13 +18,29 @@ ostream&  operator <<
   return os;
 }
 
+// VTK cell type of a Gmsh element type, -1 if there is none
+
 int          getParaElemType ( int gmshElemType )
 {
   switch ( gmshElemType )
   {
-    case 2: return 5;  // 3-node triangle
-    case 3: return 9;  // 4-node quad	    
+    case 1:  return 3;   // 2-node line
+    case 2:  return 5;   // 3-node triangle
+    case 3:  return 9;   // 4-node quad	    
+    case 4:  return 10;  // 4-node tetrahedron
+    case 5:  return 12;  // 8-node hexahedron
+    case 6:  return 13;  // 6-node prism
+    case 7:  return 14;  // 5-node pyramid
+    case 8:  return 21;  // 3-node line
+    case 9:  return 22;  // 6-node triangle
+    case 10: return 28;  // 9-node quad
+    case 11: return 24;  // 10-node tetrahedron
+    case 15: return 1;   // 1-node point
+    case 16: return 23;  // 8-node quad
+    case 17: return 25;  // 20-node hexahedron
   }
+
+  return -1;
 }
 
 
@@ -71,7 +87,6 @@ bool Segment::isOn ( double x, double y )
   }
   else if ( fabs ( direction.x ) > fabs ( direction.y ) )
   {
-      cout << x << " " << y << endl;
     double t  = ( x - p1.x ) / direction.x;
     return ( t > 1e-15 ) && 
            ( t < 1.  + 2. * numeric_limits<double>::epsilon() );
@@ -0,0 +1,111 @@
+/**
+ * Regression tests: write a binary interface file (--interface-binary)
+ * in the text format of the interface file, so that run.sh can compare
+ * it with the text file of the same run. Only InterfaceFile.h is used,
+ * as in a solver that reads the binary file.
+ *
+ * usage: interface-text file.bin > file.txt
+ */
+
+#include <cstdio>
+
+#include "InterfaceFile.h"
+
+int main ( int argc, char* argv[] )
+{
+  if ( argc != 2 )
+  {
+    fprintf ( stderr, "usage: %s interface-file\n", argv[0] );
+    return 1;
+  }
+
+  InterfaceFileReader  file;
+
+  if ( !file.open ( argv[1] ) )
+  {
+    fprintf ( stderr, "%s: %s\n", argv[1], file.getError ().c_str () );
+    return 1;
+  }
+
+  InterfaceArray<int32_t>  ids      = file.getElementIds       ();
+  InterfaceArray<int32_t>  mats     = file.getElementMaterials ();
+  InterfaceArray<int32_t>  bulks    = file.getElementBulks     ();
+  InterfaceArray<int32_t>  nodes    = file.getElementNodes     ();
+  InterfaceArray<int32_t>  nodeIds  = file.getNodeIds          ();
+  InterfaceArray<int32_t>  kinds    = file.getNodeKinds        ();
+  InterfaceArray<int64_t>  dupOffs  = file.getDuplicateOffsets ();
+  InterfaceArray<int32_t>  dupNodes = file.getDuplicateNodes   ();
+  InterfaceArray<int32_t>  flow     = file.getFlowNodes        ();
+  InterfaceArray<int32_t>  opposite = file.getOppositeVertices ();
+
+  const size_t  ieCount = file.getElementCount ();
+  const size_t  inCount = file.getNodeCount    ();
+
+  if ( ids.rows   != ieCount || mats.rows != ieCount || bulks.rows != ieCount ||
+       nodes.rows != ieCount || nodes.stride != file.getNodesPerElement () ||
+       nodeIds.rows != inCount || kinds.rows != inCount ||
+       dupOffs.rows != inCount + 1 || ( flow.data && flow.rows != inCount ) ||
+       ( file.getDimension () == 3 && opposite.rows != ieCount ) )
+  {
+    fprintf ( stderr, "%s: sections do not match the header\n", argv[1] );
+    return 1;
+  }
+
+  printf ( "Element\n%zu\n%zu\n", ieCount, nodes.stride );
+
+  for ( size_t ie = 0; ie < ieCount; ie++ )
+  {
+    printf ( "%d %d %d %d ", ids[ie][0], mats[ie][0], bulks[ie][0], bulks[ie][1] );
+
+    for ( size_t in = 0; in < nodes.stride; in++ )
+    {
+      printf ( "%d ", nodes[ie][in] );
+    }
+
+    printf ( "\n" );
+  }
+
+  // as writeInterface: the node and its duplicates, the flow node and
+  // the kind, each one followed by a space, or the node and the kind
+
+  printf ( "Node\n%zu\n", inCount );
+
+  for ( size_t in = 0; in < inCount; in++ )
+  {
+    const int64_t  first = dupOffs[in][0];
+    const int64_t  last  = dupOffs[in+1][0];
+
+    if ( first < 0 || last < first || (size_t) last > dupNodes.rows )
+    {
+      fprintf ( stderr, "%s: invalid duplicate offsets\n", argv[1] );
+      return 1;
+    }
+
+    if ( first == last && !flow.data )
+    {
+      printf ( "%d %d\n", nodeIds[in][0], kinds[in][0] );
+      continue;
+    }
+
+    for ( int64_t i = first; i < last; i++ )
+    {
+      printf ( "%d ", dupNodes[i][0] );
+    }
+
+    if ( flow.data ) printf ( "%d ", flow[in][0] );
+
+    printf ( "%d \n", kinds[in][0] );
+  }
+
+  if ( file.getDimension () == 3 )
+  {
+    printf ( "OppositeVertices\n" );
+
+    for ( size_t ie = 0; ie < ieCount; ie++ )
+    {
+      printf ( "%d\n", opposite[ie][0] );
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * Regression tests of the library interface (libcigen.h), built by
+ * make test against libcigen.a. Small meshes given in memory: a valid
+ * run, a mesh without any interface element and invalid input must
+ * all come back to the caller.
+ *
+ * usage: libcigen-test
+ */
+
+#include <cstdio>
+#include <iostream>
+
+#include "libcigen.h"
+
+static int  passed = 0;
+static int  failed = 0;
+
+// ---------------------------------------------------------------------
+//   check
+// ---------------------------------------------------------------------
+
+static void  check
+
+  ( bool         ok,
+    const char*  what )
+
+{
+  if ( ok )
+  {
+    passed++;
+  }
+  else
+  {
+    printf ( "FAILED: %s\n", what );
+    failed++;
+  }
+}
+
+// ---------------------------------------------------------------------
+//   addElement
+// ---------------------------------------------------------------------
+
+static void  addElement
+
+  ( CigenMesh&   mesh,
+    int          type,
+    int          domain,
+    int          n1,
+    int          n2,
+    int          n3 )
+
+{
+  if ( mesh.elemOffsets.empty () ) mesh.elemOffsets.push_back ( 0 );
+
+  mesh.elemTypes  .push_back ( type );
+  mesh.elemDomains.push_back ( domain );
+  mesh.elemNodes  .push_back ( n1 );
+  mesh.elemNodes  .push_back ( n2 );
+  mesh.elemNodes  .push_back ( n3 );
+  mesh.elemOffsets.push_back ( mesh.elemNodes.size () );
+}
+
+// ---------------------------------------------------------------------
+//   makeSquare
+// ---------------------------------------------------------------------
+
+// unit square: nodes 1 ... 4, triangles 1 2 4 and 2 3 4 (elementCount
+// 1 or 2)
+
+static CigenMesh  makeSquare
+
+  ( int  elementCount )
+
+{
+  static const double  xy[4][2] = { { 0., 0. }, { 1., 0. }, { 1., 1. }, { 0., 1. } };
+
+  CigenMesh  mesh;
+
+  for ( int in = 0; in < 4; in++ )
+  {
+    mesh.nodeIds.push_back ( in + 1 );
+    mesh.coords .push_back ( xy[in][0] );
+    mesh.coords .push_back ( xy[in][1] );
+    mesh.coords .push_back ( 0. );
+  }
+
+  addElement ( mesh, 2, 1, 1, 2, 4 );
+
+  if ( elementCount > 1 ) addElement ( mesh, 2, 1, 2, 3, 4 );
+
+  return mesh;
+}
+
+// =====================================================================
+//     main
+// =====================================================================
+
+int main ()
+{
+  std::streambuf*  coutBuf = std::cout.rdbuf ();
+
+  CigenOptions     options;
+  CigenResult      result;
+
+  // two triangles: one interface element along the diagonal, whose
+  // two sides have their own nodes
+
+  bool  ok = cigenGenerate ( makeSquare ( 2 ), options, result );
+
+  check ( ok && result.error.empty (),                      "two triangles: run" );
+  check ( result.dimension == 2 && result.nodesPerInterface == 4,
+                                                            "two triangles: interface type" );
+  check ( result.interfaceOffsets.size () == 2 &&
+          result.interfaceNodes.size   () == 4,             "two triangles: one interface element" );
+  check ( result.elemOffsets.size () == 3,                  "two triangles: bulk elements" );
+  check ( result.nodeIds.size () == 6,                      "two triangles: duplicated nodes" );
+
+  if ( result.interfaceNodes.size () == 4 )
+  {
+    const std::vector<int>&  n = result.interfaceNodes;
+
+    check ( n[0] != n[3] && n[1] != n[2] && n[0] != n[2] && n[1] != n[3],
+                                                            "two triangles: both sides" );
+  }
+
+  // one triangle: nothing to do, interface-elem stops there
+
+  ok = cigenGenerate ( makeSquare ( 1 ), options, result );
+
+  check ( !ok && !result.error.empty (),                    "one triangle: error returned" );
+  check ( std::cout.rdbuf () == coutBuf,                    "one triangle: std::cout restored" );
+
+  // input the builders cannot handle
+
+  CigenMesh  mesh = makeSquare ( 2 );
+
+  mesh.elemTypes[1] = 4;
+  mesh.elemNodes.insert ( mesh.elemNodes.begin () + 6, 1 );
+  mesh.elemOffsets[2]++;
+
+  ok = cigenGenerate ( mesh, options, result );
+
+  check ( !ok && !result.error.empty (),                    "tetrahedron in a 2D mesh" );
+
+  mesh = makeSquare ( 2 );
+  mesh.coords.pop_back ();
+
+  ok = cigenGenerate ( mesh, options, result );
+
+  check ( !ok && !result.error.empty (),                    "missing coordinate" );
+
+  options.mode = CigenOptions::DOMAIN;
+  options.rigidDomains.push_back ( 7 );
+
+  ok = cigenGenerate ( makeSquare ( 2 ), options, result );
+
+  check ( !ok && !result.error.empty (),                    "unknown rigid domain" );
+
+  printf ( "%d passed, %d failed\n", passed, failed );
+
+  return failed == 0 ? 0 : 1;
+}
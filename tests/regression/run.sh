@@ -0,0 +1,133 @@
+#!/bin/sh
+#
+# Regression tests of the interface element generator (make test in src).
+#
+# The meshes of this directory are generated with several options that
+# must not change the output: --threads, --stream, --mesh-cache. Every
+# run is compared byte for byte with the serial run of the same mesh
+# and mode, for the jem mesh file and the (text or binary) interface
+# file. The binary interface file is also read back with InterfaceFile.h
+# (interface-text, built by make test) and compared with the text one.
+#
+# usage: run.sh path/to/interface-elem [path/to/interface-text]
+
+PROGRAM=${1:-../../src/interface-elem}
+TEXT=${2:-}
+
+case $PROGRAM in
+  /*) ;;
+  *)  PROGRAM=`pwd`/$PROGRAM ;;
+esac
+
+HERE=`cd \`dirname $0\` && pwd`
+# readMesh takes the format after the first dot of the path
+
+WORK=`mktemp -d /tmp/cigenXXXXXX`
+
+trap 'rm -rf $WORK' EXIT
+
+FAILED=0
+PASSED=0
+
+# generate NAME MESH OPTIONS...: output files in $WORK/NAME (sh has no
+# local variables, hence the names)
+
+generate ()
+{
+  genName=$1; genMesh=$2; shift 2
+
+  mkdir -p $WORK/$genName
+
+  ( cd $WORK/$genName &&
+    $PROGRAM --mesh-file $genMesh --out-file solid.mesh \
+             --interface-file interface.mesh "$@" > stdout 2>&1 )
+}
+
+# check CASE NAME REF: NAME gave the same files as REF
+
+check ()
+{
+  if cmp -s $WORK/$2/solid.mesh     $WORK/$3/solid.mesh &&
+     cmp -s $WORK/$2/interface.mesh $WORK/$3/interface.mesh
+  then
+    PASSED=`expr $PASSED + 1`
+  else
+    echo "FAILED: $1"
+    FAILED=`expr $FAILED + 1`
+  fi
+}
+
+# testMesh MESH MODE...: all variants of one mesh and mode
+
+testMesh ()
+{
+  mesh=$1; shift
+  id=`basename $mesh .msh``echo "$@" | tr -d ' -'`
+
+  generate $id-serial $HERE/$mesh "$@"
+
+  if [ ! -s $WORK/$id-serial/interface.mesh ]
+  then
+    echo "FAILED: $mesh $@ (no output)"
+    FAILED=`expr $FAILED + 1`
+    return
+  fi
+
+  generate $id-threads      $HERE/$mesh "$@" --threads 4
+  generate $id-stream       $HERE/$mesh "$@" --stream
+  generate $id-streamthr    $HERE/$mesh "$@" --stream --threads 4
+
+  check "$mesh $* --threads 4"          $id-threads   $id-serial
+  check "$mesh $* --stream"             $id-stream    $id-serial
+  check "$mesh $* --stream --threads 4" $id-streamthr $id-serial
+
+  generate $id-binary       $HERE/$mesh "$@" --interface-binary
+  generate $id-binarythr    $HERE/$mesh "$@" --interface-binary --threads 4
+  generate $id-binarystr    $HERE/$mesh "$@" --interface-binary --stream
+
+  check "$mesh $* --interface-binary --threads 4" $id-binarythr $id-binary
+  check "$mesh $* --interface-binary --stream"    $id-binarystr $id-binary
+
+  if [ -n "$TEXT" ]
+  then
+    if $TEXT $WORK/$id-binary/interface.mesh > $WORK/$id-binary/interface.txt &&
+       cmp -s $WORK/$id-binary/interface.txt $WORK/$id-serial/interface.mesh
+    then
+      PASSED=`expr $PASSED + 1`
+    else
+      echo "FAILED: $mesh $* --interface-binary (read back)"
+      FAILED=`expr $FAILED + 1`
+    fi
+  fi
+
+  # the first run writes the sidecar, the second one reads it
+
+  mkdir -p $WORK/$id-cache
+  cp $HERE/$mesh $WORK/$id-cache/mesh.msh
+
+  generate $id-cachemiss $WORK/$id-cache/mesh.msh "$@" --mesh-cache
+  generate $id-cachehit  $WORK/$id-cache/mesh.msh "$@" --mesh-cache
+
+  check "$mesh $* --mesh-cache (miss)" $id-cachemiss $id-serial
+  check "$mesh $* --mesh-cache (hit)"  $id-cachehit  $id-serial
+
+  if ! grep -q "Mesh cache.* hit" $WORK/$id-cachehit/stdout
+  then
+    echo "FAILED: $mesh $* --mesh-cache (not read back)"
+    FAILED=`expr $FAILED + 1`
+  fi
+}
+
+testMesh one-fiber.msh       --everywhere
+testMesh one-fiber.msh       --interface
+testMesh one-fiber.msh       --domain 1
+testMesh cook3D-T4.msh       --everywhere
+testMesh test_3D_8nodes.msh  --everywhere
+testMesh test_3D_8nodes.msh  --interface
+testMesh test_3D_8nodes.msh  --domain 58
+testMesh test_3D_20nodes.msh --interface
+testMesh test_3D_20nodes.msh --polycrystal
+
+echo "$PASSED passed, $FAILED failed"
+
+[ $FAILED -eq 0 ]